@@ -2,6 +2,7 @@
     (fetchTarball "https://github.com/oar-team/nur-kapack/archive/master.tar.gz")
   {}
 , doUnitTests ? true
+, doBenchmarks ? false
 , doCoverage ? true
 , coverageCobertura ? false
 , coverageCoveralls ? false
@@ -13,6 +14,7 @@
 , debug ? true
 , useClang ? false
 , simgrid ? kapack.simgrid-light.override { inherit debug; }
+, gbenchmark ? kapack.pkgs.gbenchmark
 , batsched ? kapack.batsched.overrideAttrs (old: {
     src = kapack.pkgs.fetchFromGitLab {
       domain = "framagit.org";
@@ -52,12 +54,16 @@ let
     # Batsim executable binary file.
     batsim = (kapack.batsim.override { inherit debug simgrid; stdenv = custom-stdenv; }).overrideAttrs (attr: rec {
       buildInputs = attr.buildInputs
-        ++ pkgs.lib.optional doUnitTests [pkgs.gtest.dev];
+        ++ [pkgs.zlib pkgs.zstd]
+        ++ pkgs.lib.optional doUnitTests [pkgs.gtest.dev]
+        ++ pkgs.lib.optional doBenchmarks [gbenchmark];
       src = pkgs.lib.sourceByRegex ./. [
         "^src"
         "^src/.*\.?pp"
         "^src/unittest"
         "^src/unittest/.*\.?pp"
+        "^src/benchmark"
+        "^src/benchmark/.*\.?pp"
         "^meson\.build"
         "^meson_options\.txt"
       ];
@@ -66,6 +72,7 @@ let
       mesonFlags = [ "--warnlevel=3" ]
         ++ pkgs.lib.optional werror [ "--werror" ]
         ++ pkgs.lib.optional doUnitTests [ "-Ddo_unit_tests=true" ]
+        ++ pkgs.lib.optional doBenchmarks [ "-Ddo_benchmarks=true" ]
         ++ pkgs.lib.optional doCoverage [ "-Db_coverage=true" ];
       ninjaFlags = [ "-v" ];
 
@@ -75,8 +82,13 @@ let
         meson test --print-errorlogs
       '';
 
+      # The micro-benchmarks are not installed by meson, they are run with `batbench` (see docs/howto-test.rst).
+      postInstall = pkgs.lib.optionalString doBenchmarks ''
+        mkdir -p $out/bin
+        cp batbench $out/bin/
+      ''
       # Keep files generated by GCOV, so depending jobs can use them.
-      postInstall = pkgs.lib.optionalString doCoverage ''
+      + pkgs.lib.optionalString doCoverage ''
         mkdir -p $out/gcno
         cp batsim.p/*.gcno $out/gcno/
         cp libbatlib.a.p/*.gcno $out/gcno/
@@ -43,8 +43,8 @@
 #include <boost/algorithm/string/join.hpp>
 
 #include "batsim.hpp"
+#include "builtin_scheduler.hpp"
 #include "context.hpp"
-#include "event_submitter.hpp"
 #include "events.hpp"
 #include "export.hpp"
 #include "ipp.hpp"
@@ -56,6 +56,7 @@
 #include "profiles.hpp"
 #include "protocol.hpp"
 #include "server.hpp"
+#include "timeline_submitter.hpp"
 #include "workload.hpp"
 #include "workflow.hpp"
 
@@ -207,12 +208,65 @@ Execution context options:
                                      [default: 6379]
   --redis-prefix <prefix>            The Redis prefix. Ignored if --enable-redis is not set.
                                      [default: default]
+  --redis-check-writes               Reads back every value written into Redis to check
+                                     its consistency. Ignored if --enable-redis is not set.
+  --storage-backend <backend>        The data storage in which the jobs and profiles are put.
+                                     Available values: redis, in-process, unix-socket.
+                                     Ignored if --enable-redis is not set. [default: redis]
+  --storage-socket <path>            The Unix socket on which the data storage is served.
+                                     Ignored if --storage-backend is not unix-socket.
+                                     [default: batsim_storage.sock]
+  --builtin-sched <policy>           Takes the decisions with a built-in decision process
+                                     instead of connecting to an external one.
+                                     Available values: fcfs, easy (EASY backfilling).
+                                     Incompatible with --enable-redis.
 
 Output options:
   -e, --export <prefix>              The export filename prefix used to generate
                                      simulation output [default: out].
   --disable-schedule-tracing         Disables the Pajé schedule outputting.
+  --schedule-trace-format <format>   The format of the schedule trace.
+                                     Available values: paje (<prefix>_schedule.trace),
+                                     binary (<prefix>_schedule.bst, one record per
+                                     job event instead of one line per machine)
+                                     [default: paje].
   --disable-machine-state-tracing    Disables the machine state outputting.
+  --machine-state-coalesce           Writes at most one machine state row per
+                                     simulated date (the state after all the
+                                     updates done at this date).
+  --machine-state-period <period>    If strictly positive, the machine states
+                                     are sampled every <period> simulated
+                                     seconds instead of being written on
+                                     every update [default: 0].
+  --energy-trace-coalesce            Writes at most one consumed energy row
+                                     per simulated date, and at most one power
+                                     state change row per simulated date and
+                                     power state.
+  --async-outputs                    Writes the output files from a background
+                                     thread instead of the simulation thread.
+  --export-compression <algo>        Compresses the output trace files on the fly.
+                                     Available values: none, gzip, zstd.
+                                     Compressed files get a .gz or .zst suffix
+                                     and are written from a background thread
+                                     [default: none].
+  --export-jobs-columnar             Also exports the jobs into a binary
+                                     columnar file (<prefix>_jobs.bcol).
+  --export-chunk-size <bytes>        If strictly positive, the CSV output files
+                                     (jobs, machine states, energy, pstates) are
+                                     split into numbered chunks of about <bytes>
+                                     bytes (before compression), listed in an
+                                     index file [default: 0].
+  --export-chunk-period <period>     If strictly positive, the CSV output files
+                                     are split into numbered chunks that cover
+                                     <period> simulated seconds each, listed in
+                                     an index file [default: 0].
+  --profile-server                   Measures the wall-clock time (and the memory
+                                     allocations if built with the
+                                     profile_allocations Meson option) of the
+                                     server message handlers and of the
+                                     communications with the scheduler, then
+                                     exports them into
+                                     <prefix>_server_profile.json.
 
 Platform size limit options:
   --mmax <nb>                        Limits the number of machines to <nb>.
@@ -270,6 +324,9 @@ Other options:
   --forward-unknown-events           Enables the forwarding to the scheduler of external events that
                                      are unknown to Batsim. Ignored if there were no event inputs with --events.
                                      [default: false]
+  --events-look-ahead <nb>           The number of events read in advance in each events file.
+                                     Events files are streamed: an event can be placed less than <nb>
+                                     events after events that occur later in its file. [default: 4096]
   -h, --help                         Shows this help.
 )";
 
@@ -474,12 +531,119 @@ Other options:
         error = true;
     }
     main_args.redis_prefix = args["--redis-prefix"].asString();
+    main_args.redis_check_writes = args["--redis-check-writes"].asBool();
+    main_args.storage_backend = args["--storage-backend"].asString();
+    if (main_args.storage_backend != "redis" &&
+        main_args.storage_backend != "in-process" &&
+        main_args.storage_backend != "unix-socket")
+    {
+        XBT_ERROR("Invalid storage <backend> '%s'.", main_args.storage_backend.c_str());
+        error = true;
+    }
+    main_args.storage_socket = args["--storage-socket"].asString();
+    if (args["--builtin-sched"].isString())
+    {
+        main_args.builtin_scheduler = args["--builtin-sched"].asString();
+        try
+        {
+            builtin_scheduling_policy_from_string(main_args.builtin_scheduler);
+        }
+        catch (const std::exception &)
+        {
+            XBT_ERROR("Invalid built-in scheduler <policy> '%s'.", main_args.builtin_scheduler.c_str());
+            error = true;
+        }
+
+        if (main_args.redis_enabled)
+        {
+            XBT_ERROR("The built-in scheduler cannot be used with --enable-redis: it reads the jobs from the protocol messages.");
+            error = true;
+        }
+    }
 
     // Output options
     // **************
     main_args.export_prefix = args["--export"].asString();
     main_args.enable_schedule_tracing = !args["--disable-schedule-tracing"].asBool();
+    string schedule_trace_format = args["--schedule-trace-format"].asString();
+    if (schedule_trace_format == "binary")
+    {
+        main_args.enable_binary_schedule_trace = true;
+    }
+    else if (schedule_trace_format != "paje")
+    {
+        XBT_ERROR("Invalid schedule trace <format> '%s'.", schedule_trace_format.c_str());
+        error = true;
+    }
     main_args.enable_machine_state_tracing = !args["--disable-machine-state-tracing"].asBool();
+    main_args.machine_state_coalesce = args["--machine-state-coalesce"].asBool();
+    string machine_state_period = args["--machine-state-period"].asString();
+    try
+    {
+        main_args.machine_state_period = std::stod(machine_state_period);
+        if (main_args.machine_state_period < 0)
+        {
+            XBT_ERROR("The machine state <period> %g ('%s') must be positive.", main_args.machine_state_period,
+                      machine_state_period.c_str());
+            error = true;
+        }
+    }
+    catch (const std::exception &)
+    {
+        XBT_ERROR("Cannot read the machine state <period> '%s' as a number.", machine_state_period.c_str());
+        error = true;
+    }
+    main_args.energy_trace_coalesce = args["--energy-trace-coalesce"].asBool();
+    main_args.enable_async_outputs = args["--async-outputs"].asBool();
+    main_args.export_compression = args["--export-compression"].asString();
+    main_args.enable_columnar_jobs_export = args["--export-jobs-columnar"].asBool();
+    string export_chunk_size = args["--export-chunk-size"].asString();
+    try
+    {
+        size_t nb_parsed_chars = 0;
+        main_args.export_chunk_size = std::stoull(export_chunk_size, &nb_parsed_chars);
+        if (nb_parsed_chars != export_chunk_size.size() || export_chunk_size[0] == '-')
+        {
+            throw std::invalid_argument("not an unsigned integer");
+        }
+    }
+    catch (const std::exception &)
+    {
+        XBT_ERROR("Cannot read the chunk <bytes> '%s' as an unsigned integer.", export_chunk_size.c_str());
+        error = true;
+    }
+    string export_chunk_period = args["--export-chunk-period"].asString();
+    try
+    {
+        main_args.export_chunk_period = std::stod(export_chunk_period);
+        if (main_args.export_chunk_period < 0)
+        {
+            XBT_ERROR("The chunk <period> %g ('%s') must be positive.", main_args.export_chunk_period,
+                      export_chunk_period.c_str());
+            error = true;
+        }
+    }
+    catch (const std::exception &)
+    {
+        XBT_ERROR("Cannot read the chunk <period> '%s' as a number.", export_chunk_period.c_str());
+        error = true;
+    }
+    try
+    {
+        OutputCompression compression = output_compression_from_string(main_args.export_compression);
+        if (!output_compression_is_supported(compression))
+        {
+            XBT_ERROR("Invalid <algo> '%s': Batsim has been built without its support.",
+                      main_args.export_compression.c_str());
+            error = true;
+        }
+    }
+    catch (const std::exception &)
+    {
+        XBT_ERROR("Invalid <algo> '%s'.", main_args.export_compression.c_str());
+        error = true;
+    }
+    main_args.enable_server_profiling = args["--profile-server"].asBool();
 
     // Job-related options
     // *******************
@@ -554,6 +718,21 @@ Other options:
     if (!main_args.eventList_descriptions.empty())
     {
         main_args.forward_unknown_events = args["--forward-unknown-events"].asBool();
+        try
+        {
+            main_args.events_look_ahead = static_cast<int>(args["--events-look-ahead"].asLong());
+            if (main_args.events_look_ahead < 1)
+            {
+                XBT_ERROR("Invalid events look-ahead %d: it must be strictly positive.", main_args.events_look_ahead);
+                error = true;
+            }
+        }
+        catch(const std::exception &)
+        {
+            XBT_ERROR("Cannot read the events look-ahead '%s' as a long integer.",
+                      args["--events-look-ahead"].asString().c_str());
+            error = true;
+        }
     }
     if (args["--no-sched"].asBool())
     {
@@ -583,7 +762,7 @@ void configure_batsim_logging_output(const MainArguments & main_args)
 {
     vector<string> log_categories_to_set = {"workload", "job_submitter", "redis", "jobs", "machines", "pstate",
                                             "workflow", "jobs_execution", "server", "export", "profiles", "machine_range",
-                                            "events", "event_submitter", "protocol",
+                                            "events", "timeline_submitter", "protocol",
                                             "network", "ipp", "task_execution"};
     string log_threshold_to_set = "critical";
 
@@ -678,11 +857,17 @@ void load_workloads_and_workflows(const MainArguments & main_args, BatsimContext
 
 void load_eventLists(const MainArguments & main_args, BatsimContext * context)
 {
+    if (main_args.eventList_descriptions.empty())
+    {
+        return;
+    }
+
+    // The events files are streamed during the simulation, merged into a single stream
+    context->event_stream = new EventStream;
     for (const MainArguments::EventListDescription & desc : main_args.eventList_descriptions)
     {
-        auto events = new EventList(desc.name, true);
-        events->load_from_json(desc.filename, main_args.forward_unknown_events);
-        context->event_lists[desc.name] = events;
+        context->event_stream->add_file(desc.filename, main_args.forward_unknown_events,
+                                        static_cast<size_t>(main_args.events_look_ahead));
     }
 }
 
@@ -692,22 +877,37 @@ void start_initial_simulation_processes(const MainArguments & main_args,
 {
     const Machine * master_machine = context->machines.master_machine();
 
-    // Let's run a static_job_submitter process for each workload
-    for (const MainArguments::WorkloadDescription & desc : main_args.workload_descriptions)
+    if (is_batexec)
     {
-        string submitter_instance_name = "workload_submitter_" + desc.name;
-
-        XBT_DEBUG("Creating a workload_submitter process...");
-        auto actor_function = static_job_submitter_process;
-        if (is_batexec)
+        // Let's run a batexec_job_launcher process for each workload
+        for (const MainArguments::WorkloadDescription & desc : main_args.workload_descriptions)
         {
-            actor_function = batexec_job_launcher_process;
+            string submitter_instance_name = "workload_submitter_" + desc.name;
+
+            XBT_DEBUG("Creating a workload_submitter process...");
+            simgrid::s4u::Actor::create(submitter_instance_name.c_str(),
+                                        master_machine->host,
+                                        batexec_job_launcher_process,
+                                        context, desc.name);
+            XBT_INFO("The process '%s' has been created.", submitter_instance_name.c_str());
         }
+    }
+    else if (!main_args.workload_descriptions.empty() || context->event_stream != nullptr)
+    {
+        // Let's run a single timeline_submitter process for all the workloads and all the lists of events
+        vector<string> workload_names;
+        for (const MainArguments::WorkloadDescription & desc : main_args.workload_descriptions)
+        {
+            workload_names.push_back(desc.name);
+        }
+
+        string submitter_instance_name = "timeline_submitter";
 
+        XBT_DEBUG("Creating a timeline_submitter process...");
         simgrid::s4u::Actor::create(submitter_instance_name.c_str(),
                                     master_machine->host,
-                                    actor_function,
-                                    context, desc.name);
+                                    timeline_submitter_process,
+                                    context, workload_names);
         XBT_INFO("The process '%s' has been created.", submitter_instance_name.c_str());
     }
 
@@ -723,20 +923,6 @@ void start_initial_simulation_processes(const MainArguments & main_args,
         XBT_INFO("The process '%s' has been created.", submitter_instance_name.c_str());
     }
 
-    // Let's run a static_event_submitter process for each list of event
-    for (const MainArguments::EventListDescription & desc : main_args.eventList_descriptions)
-    {
-        string submitter_instance_name = "event_submitter_" + desc.name;
-
-        XBT_DEBUG("Creating an event_submitter process...");
-        auto actor_function = static_event_submitter_process;
-        simgrid::s4u::Actor::create(submitter_instance_name.c_str(),
-                                    master_machine->host,
-                                    actor_function,
-                                    context, desc.name);
-        XBT_INFO("The process '%s' has been created.", submitter_instance_name.c_str());
-    }
-
     if (!is_batexec)
     {
         XBT_DEBUG("Creating the 'server' process...");
@@ -774,10 +960,14 @@ int main(int argc, char * argv[])
         object.AddMember("redis_hostname", Value().SetString(main_args.redis_hostname.c_str(), alloc), alloc);
         object.AddMember("redis_port", Value().SetInt(main_args.redis_port), alloc);
         object.AddMember("redis_prefix", Value().SetString(main_args.redis_prefix.c_str(), alloc), alloc);
+        object.AddMember("storage_backend", Value().SetString(main_args.storage_backend.c_str(), alloc), alloc);
+        object.AddMember("storage_socket", Value().SetString(main_args.storage_socket.c_str(), alloc), alloc);
+        object.AddMember("builtin_scheduler", Value().SetString(main_args.builtin_scheduler.c_str(), alloc), alloc);
 
         object.AddMember("export_prefix", Value().SetString(main_args.export_prefix.c_str(), alloc), alloc);
 
-        object.AddMember("external_scheduler", Value().SetBool(main_args.program_type == ProgramType::BATSIM), alloc);
+        object.AddMember("external_scheduler", Value().SetBool(main_args.program_type == ProgramType::BATSIM &&
+                                                               main_args.builtin_scheduler.empty()), alloc);
 
         // Dump the object to a string
         StringBuffer buffer;
@@ -861,21 +1051,42 @@ int main(int argc, char * argv[])
     {
         if (context.redis_enabled)
         {
-            // Let's prepare Redis' connection
-            context.storage.set_instance_key_prefix(main_args.redis_prefix);
-            context.storage.connect_to_server(main_args.redis_hostname, main_args.redis_port);
+            // Let's prepare the data storage
+            if (main_args.storage_backend == "redis")
+            {
+                auto redis_storage = new RedisStorage;
+                redis_storage->set_write_check(main_args.redis_check_writes);
+                redis_storage->connect_to_server(main_args.redis_hostname, main_args.redis_port);
+                context.storage.reset(redis_storage);
+            }
+            else if (main_args.storage_backend == "in-process")
+            {
+                context.storage.reset(new InProcessStorage);
+            }
+            else
+            {
+                context.storage.reset(new UnixSocketStorage(main_args.storage_socket));
+            }
+            context.storage->set_instance_key_prefix(main_args.redis_prefix);
 
             // Let's store some metadata about the current instance in the data storage
-            context.storage.set("nb_res", std::to_string(context.machines.nb_machines()));
+            context.storage->set("nb_res", std::to_string(context.machines.nb_machines()));
         }
 
-        // Let's create the socket
-        context.zmq_context = zmq_ctx_new();
-        xbt_assert(context.zmq_context != nullptr, "Cannot create ZMQ context");
-        context.zmq_socket = zmq_socket(context.zmq_context, ZMQ_REQ);
-        xbt_assert(context.zmq_socket != nullptr, "Cannot create ZMQ REQ socket (errno=%s)", strerror(errno));
-        int err = zmq_connect(context.zmq_socket, main_args.socket_endpoint.c_str());
-        xbt_assert(err == 0, "Cannot connect ZMQ socket to '%s' (errno=%s)", main_args.socket_endpoint.c_str(), strerror(errno));
+        if (context.builtin_scheduler != nullptr)
+        {
+            XBT_INFO("Decisions are taken by the built-in '%s' scheduler.", main_args.builtin_scheduler.c_str());
+        }
+        else
+        {
+            // Let's create the socket
+            context.zmq_context = zmq_ctx_new();
+            xbt_assert(context.zmq_context != nullptr, "Cannot create ZMQ context");
+            context.zmq_socket = zmq_socket(context.zmq_context, ZMQ_REQ);
+            xbt_assert(context.zmq_socket != nullptr, "Cannot create ZMQ REQ socket (errno=%s)", strerror(errno));
+            int err = zmq_connect(context.zmq_socket, main_args.socket_endpoint.c_str());
+            xbt_assert(err == 0, "Cannot connect ZMQ socket to '%s' (errno=%s)", main_args.socket_endpoint.c_str(), strerror(errno));
+        }
 
         // Let's create the protocol reader and writer
         context.proto_reader = new JsonProtocolReader(&context);
@@ -905,6 +1116,8 @@ int main(int argc, char * argv[])
     delete context.proto_writer;
     context.proto_writer = nullptr;
 
+    BatTask::release_free_list();
+
     // If SMPI had been used, it should be finalized
     if (context.smpi_used)
     {
@@ -948,7 +1161,25 @@ void set_configuration(BatsimContext *context,
     context->allow_compute_sharing = main_args.allow_compute_sharing;
     context->allow_storage_sharing = main_args.allow_storage_sharing;
     context->trace_schedule = main_args.enable_schedule_tracing;
+    context->binary_schedule_trace = main_args.enable_binary_schedule_trace;
     context->trace_machine_states = main_args.enable_machine_state_tracing;
+    context->machine_state_coalesce = main_args.machine_state_coalesce;
+    context->machine_state_period = main_args.machine_state_period;
+    context->energy_trace_coalesce = main_args.energy_trace_coalesce;
+    context->async_outputs = main_args.enable_async_outputs;
+    context->export_compression = output_compression_from_string(main_args.export_compression);
+    context->export_columnar_jobs = main_args.enable_columnar_jobs_export;
+    context->export_chunk_size = main_args.export_chunk_size;
+    context->export_chunk_period = main_args.export_chunk_period;
+    if (main_args.enable_server_profiling)
+    {
+        context->server_profiler = std::make_unique<ServerProfiler>();
+    }
+    if (!main_args.builtin_scheduler.empty())
+    {
+        context->builtin_scheduler = std::make_unique<BuiltinScheduler>(
+            builtin_scheduling_policy_from_string(main_args.builtin_scheduler));
+    }
     context->simulation_start_time = chrono::high_resolution_clock::now();
     context->terminate_with_last_workflow = main_args.terminate_with_last_workflow;
 
@@ -963,6 +1194,8 @@ void set_configuration(BatsimContext *context,
     context->config_json.AddMember("redis-hostname", Value().SetString(main_args.redis_hostname.c_str(), alloc), alloc);
     context->config_json.AddMember("redis-port", Value().SetInt(main_args.redis_port), alloc);
     context->config_json.AddMember("redis-prefix", Value().SetString(main_args.redis_prefix.c_str(), alloc), alloc);
+    context->config_json.AddMember("storage-backend", Value().SetString(main_args.storage_backend.c_str(), alloc), alloc);
+    context->config_json.AddMember("storage-socket", Value().SetString(main_args.storage_socket.c_str(), alloc), alloc);
 
     // job_submission
     context->config_json.AddMember("profiles-forwarded-on-submission", Value().SetBool(main_args.forward_profiles_on_submission), alloc);
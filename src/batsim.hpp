@@ -77,6 +77,10 @@ struct MainArguments
     std::string redis_hostname;                             //!< The Redis (data storage) server host name
     int redis_port = 0;                                     //!< The Redis (data storage) server port
     std::string redis_prefix;                               //!< The Redis (data storage) instance prefix
+    bool redis_check_writes = false;                        //!< Whether the values written into Redis are read back to check consistency
+    std::string storage_backend = "redis";                  //!< The data storage implementation (redis, in-process or unix-socket)
+    std::string storage_socket;                             //!< The Unix socket on which the data storage is served (unix-socket backend)
+    std::string builtin_scheduler;                          //!< The policy of the built-in decision process (fcfs or easy). Empty if the decision process is external
 
     // Job related
     bool forward_profiles_on_submission = false;            //!< Stores whether the profile information of submitted jobs should be sent to the scheduler
@@ -87,7 +91,17 @@ struct MainArguments
     // Output
     std::string export_prefix;                              //!< The filename prefix used to export simulation information
     bool enable_schedule_tracing = false;                   //!< If set to true, the schedule is exported to a Pajé trace file
+    bool enable_binary_schedule_trace = false;              //!< If set to true, the schedule is exported to a binary trace file instead of a Pajé one
     bool enable_machine_state_tracing = false;              //!< If set to true, this option enables the tracing of the machine states into a CSV time series.
+    bool machine_state_coalesce = false;                    //!< If set to true, at most one machine state row is written per simulated date.
+    double machine_state_period = 0;                        //!< If strictly positive, the machine states are sampled with this period (in simulated seconds).
+    bool energy_trace_coalesce = false;                     //!< If set to true, at most one energy row (and one power state change row per power state) is written per simulated date.
+    bool enable_async_outputs = false;                      //!< If set to true, the output files are written by background threads.
+    std::string export_compression = "none";                //!< The compression algorithm of the output trace files ("none", "gzip" or "zstd")
+    bool enable_columnar_jobs_export = false;               //!< If set to true, the jobs are also exported into a binary columnar file
+    uint64_t export_chunk_size = 0;                         //!< If strictly positive, the CSV output files are split into chunks of about this size (in bytes)
+    double export_chunk_period = 0;                         //!< If strictly positive, the CSV output files are split into chunks that cover this duration (in simulated seconds)
+    bool enable_server_profiling = false;                   //!< If set to true, the server loop is profiled and its report is exported
 
     // Platform size limit
     int limit_machines_count = 0;                           //!< The number of machines to use to compute jobs. 0 : no limit. > 0 : the number of computation machines
@@ -109,6 +123,7 @@ struct MainArguments
     bool allow_compute_sharing = false;                     //!< Allows/forbids sharing on compute machines. Two jobs can run concurrently on the same machine if and only if sharing is allowed.
     bool allow_storage_sharing = false;                     //!< Allows/forbids sharing on storage machines. Two jobs can run concurrently on the same machine if and only if sharing is allowed.
     bool forward_unknown_events = false;                    //!< Whether the unknown external events should be forwarded to the scheduler.
+    int events_look_ahead = 4096;                           //!< The number of events read in advance in each events file.
     ProgramType program_type = ProgramType::BATSIM;         //!< The program type (Batsim or Batexec at the moment)
     std::string pfs_host_name;                              //!< The name of the SimGrid host which serves as parallel file system (a.k.a. large-capacity storage tier)
     std::string hpst_host_name;                             //!< The name of the SimGrid host which serves as the high-performance storage tier
@@ -141,7 +156,7 @@ void configure_batsim_logging_output(const MainArguments & main_args);
 void load_workloads_and_workflows(const MainArguments & main_args, BatsimContext * context, int & max_nb_machines_to_use);
 
 /**
- * @brief Loads the eventLists defined in Batsim arguments
+ * @brief Opens the events files defined in Batsim arguments, as a single merged EventStream
  * @param[in] main_args Batsim arguments
  * @param[in,out] context The BatsimContext
  */
@@ -0,0 +1,28 @@
+/**
+ * @file bench_context.hpp
+ * @brief The simulation context shared by Batsim's micro-benchmarks
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../context.hpp"
+
+const int bench_nb_jobs = 4096; //!< The number of jobs of the benchmark workload
+
+/**
+ * @brief Returns the BatsimContext shared by the benchmarks
+ * @details Its "w0" workload has bench_nb_jobs jobs (w0!0 to w0!<bench_nb_jobs-1>) that use the "delay" profile.
+ *          Benchmarks that inject messages into the simulation run within a SimGrid actor,
+ *          and a daemon actor receives (and drops) the messages sent to the server mailbox.
+ * @return The BatsimContext shared by the benchmarks
+ */
+BatsimContext * bench_context();
+
+/**
+ * @brief Returns the identifiers of the jobs of the benchmark workload, as strings
+ * @return The identifiers of the jobs of the benchmark workload
+ */
+const std::vector<std::string> & bench_job_ids();
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <intervalset.hpp>
+
+#include "bench_context.hpp"
+
+#include "../jobs.hpp"
+#include "../profiles.hpp"
+#include "../workload.hpp"
+
+static void job_from_json(benchmark::State & state)
+{
+    Workload * workload = bench_context()->workloads.at("w0");
+    const std::string job_description = R"({"id": "bench_job", "subtime": 10, "walltime": 100, "res": 4, "profile": "delay"})";
+
+    for (auto _ : state)
+    {
+        JobPtr job = Job::from_json(job_description, workload);
+        benchmark::DoNotOptimize(job.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(job_from_json);
+
+static void job_create(benchmark::State & state)
+{
+    Workload * workload = bench_context()->workloads.at("w0");
+    ProfilePtr profile = workload->profiles->at("delay");
+    const JobIdentifier job_id("w0", "bench_job");
+
+    for (auto _ : state)
+    {
+        JobPtr job = Job::create(job_id, workload, profile, 10, 4, 100);
+        benchmark::DoNotOptimize(job.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(job_create);
+
+// Parses an allocation of state.range(0) intervals, as in EXECUTE_JOB events
+static void alloc_parsing(benchmark::State & state)
+{
+    std::string alloc;
+    for (int i = 0; i < state.range(0); ++i)
+    {
+        alloc += (i > 0 ? " " : "") + std::to_string(8 * i) + "-" + std::to_string(8 * i + 3);
+    }
+
+    for (auto _ : state)
+    {
+        IntervalSet machine_ids = IntervalSet::from_string_hyphen(alloc, " ", "-");
+        benchmark::DoNotOptimize(machine_ids.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(alloc_parsing)->Arg(1)->Arg(16)->Arg(256);
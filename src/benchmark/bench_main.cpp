@@ -0,0 +1,106 @@
+/**
+ * @file bench_main.cpp
+ * @brief Entry point of Batsim's micro-benchmarks
+ * @details The benchmarks run within a SimGrid actor, so that the code that sends inter-process messages
+ *          can be benchmarked. Google benchmark options are supported, e.g. --benchmark_filter=<regex>
+ *          or --benchmark_out=<file> --benchmark_out_format=json (machine-readable results).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <simgrid/s4u.hpp>
+
+#include "bench_context.hpp"
+
+#include "../ipp.hpp"
+#include "../jobs.hpp"
+#include "../profiles.hpp"
+#include "../workload.hpp"
+
+BatsimContext * bench_context()
+{
+    static BatsimContext * context = nullptr;
+    if (context == nullptr)
+    {
+        context = new BatsimContext;
+        context->redis_enabled = false;
+        context->submission_forward_profiles = false;
+
+        Workload * workload = Workload::new_static_workload("w0", "benchmark");
+        auto profile = Profile::new_delay_profile("delay", 10);
+        workload->profiles->add_profile("delay", profile);
+        for (int i = 0; i < bench_nb_jobs; ++i)
+        {
+            workload->jobs->add_job(Job::create(JobIdentifier("w0", std::to_string(i)), workload, profile, 0, 4, 100));
+        }
+        context->workloads.insert_workload("w0", workload);
+    }
+    return context;
+}
+
+const std::vector<std::string> & bench_job_ids()
+{
+    static std::vector<std::string> job_ids;
+    if (job_ids.empty())
+    {
+        for (int i = 0; i < bench_nb_jobs; ++i)
+        {
+            job_ids.push_back("w0!" + std::to_string(i));
+        }
+    }
+    return job_ids;
+}
+
+/**
+ * @brief Receives and drops the messages sent to the server mailbox
+ */
+static void server_sink_process()
+{
+    while (true)
+    {
+        IPMessage * message = receive_message("server");
+        if (message->type == IPMessageType::SCHED_EXECUTE_JOB)
+        {
+            // The allocation is usually given to the job executor
+            delete static_cast<ExecuteJobMessage *>(message->data)->allocation;
+        }
+        delete message;
+    }
+}
+
+/**
+ * @brief Runs the benchmarks
+ */
+static void benchmark_process()
+{
+    benchmark::RunSpecifiedBenchmarks();
+}
+
+/**
+ * @brief The main function of the micro-benchmarks
+ * @param[in] argc The number of arguments
+ * @param[in] argv The arguments' values
+ * @return 0 on success, something else otherwise
+ */
+int main(int argc, char * argv[])
+{
+    // SimGrid options (--cfg, --log) are consumed first
+    simgrid::s4u::Engine engine(&argc, argv);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    xbt_log_control_set("root.thresh:critical"); // Jobs are created and deleted in loops
+
+    auto * zone = simgrid::s4u::create_full_zone("benchmark_zone");
+    simgrid::s4u::Host * host = zone->create_host("benchmark_host", 1e9)->seal();
+    zone->seal();
+
+    simgrid::s4u::Actor::create("server", host, server_sink_process)->daemonize();
+    simgrid::s4u::Actor::create("benchmark", host, benchmark_process);
+    engine.run();
+
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../export.hpp"
+#include "../task_execution.hpp"
+
+// Writes jobs-like CSV rows into /dev/null, without writer thread
+static void write_buffer_rows(benchmark::State & state)
+{
+    WriteBuffer buffer("/dev/null", 64*1024, false);
+    long long job_number = 0;
+
+    for (auto _ : state)
+    {
+        buffer.append_int(job_number++);
+        buffer.append_char(',');
+        buffer.append_fixed(static_cast<long double>(job_number) * 1.5l);
+        buffer.append_char(',');
+        buffer.append_general(static_cast<long double>(job_number) / 3.0l);
+        buffer.append_text(",COMPLETED_SUCCESSFULLY,0-3\n");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(write_buffer_rows);
+
+static void homogeneous_communication_matrix(benchmark::State & state)
+{
+    const unsigned int nb_res = static_cast<unsigned int>(state.range(0));
+    std::vector<double> matrix;
+
+    for (auto _ : state)
+    {
+        fill_homogeneous_communication_matrix(matrix, nb_res, 1e6);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+BENCHMARK(homogeneous_communication_matrix)->RangeMultiplier(4)->Range(16, 1024);
+
+// Element by element generation, as the matrices were generated before the fill kernels (baseline of the above)
+static void homogeneous_communication_matrix_element_by_element(benchmark::State & state)
+{
+    const unsigned int nb_res = static_cast<unsigned int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::vector<double> matrix;
+        matrix.reserve(nb_res * nb_res);
+        for (unsigned int y = 0; y < nb_res; ++y)
+        {
+            for (unsigned int x = 0; x < nb_res; ++x)
+            {
+                matrix.push_back(x == y ? 0 : 1e6);
+            }
+        }
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+BENCHMARK(homogeneous_communication_matrix_element_by_element)->RangeMultiplier(4)->Range(16, 1024);
+
+static void pfs_communication_matrix(benchmark::State & state)
+{
+    const unsigned int nb_res = static_cast<unsigned int>(state.range(0));
+    std::vector<double> matrix;
+
+    for (auto _ : state)
+    {
+        fill_pfs_communication_matrix(matrix, nb_res, 1e3, 2e3);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+BENCHMARK(pfs_communication_matrix)->RangeMultiplier(4)->Range(16, 1024);
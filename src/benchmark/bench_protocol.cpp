@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <intervalset.hpp>
+
+#include <rapidjson/document.h>
+
+#include "bench_context.hpp"
+
+#include "../protocol.hpp"
+
+// Appends state.range(0) events per message, then generates the message
+template <typename AppendFunction>
+static void run_writer_benchmark(benchmark::State & state, AppendFunction append)
+{
+    JsonProtocolWriter writer(bench_context());
+    const auto & job_ids = bench_job_ids();
+    const int nb_events = static_cast<int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < nb_events; ++i)
+        {
+            append(writer, job_ids[static_cast<size_t>(i % bench_nb_jobs)]);
+        }
+        std::string message = writer.generate_current_message(0);
+        benchmark::DoNotOptimize(message.data());
+        writer.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * nb_events);
+}
+
+static void writer_job_submitted(benchmark::State & state)
+{
+    const std::string job_description = bench_context()->workloads.job_at(JobIdentifier("w0!0"))->get_json_description();
+    run_writer_benchmark(state, [&job_description](JsonProtocolWriter & writer, const std::string & job_id)
+    {
+        writer.append_job_submitted(job_id, job_description, "", 0);
+    });
+}
+BENCHMARK(writer_job_submitted)->Arg(1)->Arg(64)->Arg(1024);
+
+static void writer_job_completed(benchmark::State & state)
+{
+    run_writer_benchmark(state, [](JsonProtocolWriter & writer, const std::string & job_id)
+    {
+        writer.append_job_completed(job_id, "COMPLETED_SUCCESSFULLY", "0-3", 0, 0);
+    });
+}
+BENCHMARK(writer_job_completed)->Arg(1)->Arg(64)->Arg(1024);
+
+static void writer_job_killed(benchmark::State & state)
+{
+    run_writer_benchmark(state, [](JsonProtocolWriter & writer, const std::string & job_id)
+    {
+        writer.append_job_killed({job_id}, {{job_id, nullptr}}, 0);
+    });
+}
+BENCHMARK(writer_job_killed)->Arg(1)->Arg(64)->Arg(1024);
+
+static void writer_from_job_message(benchmark::State & state)
+{
+    rapidjson::Document message;
+    message.Parse(R"({"progress": 0.5})");
+    run_writer_benchmark(state, [&message](JsonProtocolWriter & writer, const std::string & job_id)
+    {
+        writer.append_from_job_message(job_id, message, 0);
+    });
+}
+BENCHMARK(writer_from_job_message)->Arg(1)->Arg(64)->Arg(1024);
+
+static void writer_resource_state_changed(benchmark::State & state)
+{
+    const IntervalSet resources = IntervalSet::from_string_hyphen("0-15 32-63", " ", "-");
+    run_writer_benchmark(state, [&resources](JsonProtocolWriter & writer, const std::string &)
+    {
+        writer.append_resource_state_changed(resources, "1", 0);
+    });
+}
+BENCHMARK(writer_resource_state_changed)->Arg(1)->Arg(64)->Arg(1024);
+
+static void writer_query_estimate_waiting_time(benchmark::State & state)
+{
+    const std::string job_description = bench_context()->workloads.job_at(JobIdentifier("w0!0"))->get_json_description();
+    run_writer_benchmark(state, [&job_description](JsonProtocolWriter & writer, const std::string & job_id)
+    {
+        writer.append_query_estimate_waiting_time(job_id, job_description, 0);
+    });
+}
+BENCHMARK(writer_query_estimate_waiting_time)->Arg(1)->Arg(64)->Arg(1024);
+
+static void writer_answer_energy(benchmark::State & state)
+{
+    run_writer_benchmark(state, [](JsonProtocolWriter & writer, const std::string &)
+    {
+        writer.append_answer_energy(1e6, 0);
+    });
+}
+BENCHMARK(writer_answer_energy)->Arg(1)->Arg(64);
+
+static void writer_notify(benchmark::State & state)
+{
+    run_writer_benchmark(state, [](JsonProtocolWriter & writer, const std::string &)
+    {
+        writer.append_notify("no_more_static_job_to_submit", 0);
+    });
+}
+BENCHMARK(writer_notify)->Arg(1)->Arg(64);
+
+static void writer_notify_resource_event(benchmark::State & state)
+{
+    const IntervalSet resources = IntervalSet::from_string_hyphen("0-15 32-63", " ", "-");
+    run_writer_benchmark(state, [&resources](JsonProtocolWriter & writer, const std::string &)
+    {
+        writer.append_notify_resource_event("event_machine_unavailable", resources, 0);
+    });
+}
+BENCHMARK(writer_notify_resource_event)->Arg(1)->Arg(64);
+
+static void writer_notify_generic_event(benchmark::State & state)
+{
+    const std::string event_description = R"({"type": "generic", "timestamp": 0, "data": {"key": "value"}})";
+    run_writer_benchmark(state, [&event_description](JsonProtocolWriter & writer, const std::string &)
+    {
+        writer.append_notify_generic_event(event_description, 0);
+    });
+}
+BENCHMARK(writer_notify_generic_event)->Arg(1)->Arg(64);
+
+static void writer_requested_call(benchmark::State & state)
+{
+    run_writer_benchmark(state, [](JsonProtocolWriter & writer, const std::string &)
+    {
+        writer.append_requested_call(0);
+    });
+}
+BENCHMARK(writer_requested_call)->Arg(1)->Arg(64);
+
+// Parses a message with state.range(0) EXECUTE_JOB events. The inter-process messages are sent to the server sink
+static void reader_execute_job_burst(benchmark::State & state)
+{
+    JsonProtocolReader reader(bench_context());
+    const auto & job_ids = bench_job_ids();
+    const int nb_events = static_cast<int>(state.range(0));
+
+    std::string message = R"({"now": 0, "events": [)";
+    for (int i = 0; i < nb_events; ++i)
+    {
+        message += std::string(i > 0 ? "," : "") +
+                   R"({"timestamp": 0, "type": "EXECUTE_JOB", "data": {"job_id": ")" +
+                   job_ids[static_cast<size_t>(i % bench_nb_jobs)] + R"(", "alloc": "0-3"}})";
+    }
+    message += "]}";
+
+    for (auto _ : state)
+    {
+        reader.parse_and_apply_message(message);
+    }
+    state.SetItemsProcessed(state.iterations() * nb_events);
+}
+BENCHMARK(reader_execute_job_burst)->Arg(1)->Arg(64)->Arg(1024);
@@ -0,0 +1,247 @@
+/**
+ * @file builtin_scheduler.cpp
+ * @brief Contains the built-in (in-process) decision processes
+ */
+
+#include "builtin_scheduler.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <xbt.h>
+
+using namespace std;
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(builtin_scheduler, "builtin_scheduler"); //!< Logging
+
+BuiltinSchedulingPolicy builtin_scheduling_policy_from_string(const std::string & str)
+{
+    if (str == "fcfs")
+    {
+        return BuiltinSchedulingPolicy::FCFS;
+    }
+    else if (str == "easy")
+    {
+        return BuiltinSchedulingPolicy::EASY_BACKFILLING;
+    }
+
+    throw std::runtime_error("Invalid built-in scheduling policy string");
+}
+
+BuiltinScheduler::BuiltinScheduler(BuiltinSchedulingPolicy policy) :
+    _policy(policy)
+{
+}
+
+std::string BuiltinScheduler::take_decisions(const std::string & message)
+{
+    rapidjson::Document doc;
+    doc.Parse(message.c_str(), message.size());
+    xbt_assert(!doc.HasParseError(), "Built-in scheduler: cannot parse the message sent by Batsim");
+    const double now = doc["now"].GetDouble();
+
+    _reply_buffer.Clear();
+    _reply_writer.Reset(_reply_buffer);
+    _reply_writer.StartObject();
+    _reply_writer.Key("now");
+    _reply_writer.Double(now);
+    _reply_writer.Key("events");
+    _reply_writer.StartArray();
+
+    bool simulation_ends = false;
+    for (const auto & event : doc["events"].GetArray())
+    {
+        const char * type = event["type"].GetString();
+        const rapidjson::Value & data = event["data"];
+
+        if (strcmp(type, "JOB_SUBMITTED") == 0)
+        {
+            on_job_submitted(data, now);
+        }
+        else if (strcmp(type, "JOB_COMPLETED") == 0)
+        {
+            on_job_completed(data);
+        }
+        else if (strcmp(type, "SIMULATION_BEGINS") == 0)
+        {
+            on_simulation_begins(data);
+        }
+        else if (strcmp(type, "SIMULATION_ENDS") == 0)
+        {
+            simulation_ends = true;
+        }
+        // Other events do not change the decisions of the built-in scheduler
+    }
+
+    if (!simulation_ends)
+    {
+        schedule(now);
+    }
+
+    _reply_writer.EndArray();
+    _reply_writer.EndObject();
+    return string(_reply_buffer.GetString(), _reply_buffer.GetSize());
+}
+
+size_t BuiltinScheduler::nb_pending_jobs() const
+{
+    return _pending_jobs.size();
+}
+
+size_t BuiltinScheduler::nb_running_jobs() const
+{
+    return _running_jobs.size();
+}
+
+size_t BuiltinScheduler::nb_free_resources() const
+{
+    return _free_resources.size();
+}
+
+void BuiltinScheduler::on_simulation_begins(const rapidjson::Value & data)
+{
+    _free_resources = IntervalSet();
+    for (const auto & resource : data["compute_resources"].GetArray())
+    {
+        _free_resources.insert(resource["id"].GetInt());
+    }
+    _nb_compute_resources = static_cast<int>(_free_resources.size());
+
+    XBT_INFO("Built-in scheduler: %d compute resources (%s)",
+             _nb_compute_resources, _free_resources.to_string_hyphen().c_str());
+}
+
+void BuiltinScheduler::on_job_submitted(const rapidjson::Value & data, double date)
+{
+    xbt_assert(data.HasMember("job"), "Built-in scheduler: JOB_SUBMITTED events should contain the job description "
+               "(the built-in scheduler cannot be used with the data storage)");
+    const rapidjson::Value & job = data["job"];
+
+    PendingJob pending_job;
+    pending_job.id = string(data["job_id"].GetString(), data["job_id"].GetStringLength());
+    pending_job.nb_res = job["res"].GetInt();
+    pending_job.walltime = job.HasMember("walltime") ? job["walltime"].GetDouble() : -1;
+
+    if (pending_job.nb_res <= 0 || pending_job.nb_res > _nb_compute_resources)
+    {
+        XBT_INFO("Built-in scheduler: rejecting job '%s' (it requests %d resources, there are %d compute resources)",
+                 pending_job.id.c_str(), pending_job.nb_res, _nb_compute_resources);
+        append_decision("REJECT_JOB", pending_job.id, nullptr, date);
+    }
+    else
+    {
+        _pending_jobs.push_back(std::move(pending_job));
+    }
+}
+
+void BuiltinScheduler::on_job_completed(const rapidjson::Value & data)
+{
+    auto running_job_it = _running_jobs.find(string(data["job_id"].GetString(), data["job_id"].GetStringLength()));
+    xbt_assert(running_job_it != _running_jobs.end(), "Built-in scheduler: job '%s' has completed but it is not running",
+               data["job_id"].GetString());
+
+    _free_resources += running_job_it->second.allocation;
+    _expected_ends.erase(running_job_it->second.end_it);
+    _running_jobs.erase(running_job_it);
+}
+
+void BuiltinScheduler::schedule(double date)
+{
+    // FCFS: the first pending jobs are started while they fit
+    auto job_it = _pending_jobs.begin();
+    while (job_it != _pending_jobs.end() && job_it->nb_res <= static_cast<int>(_free_resources.size()))
+    {
+        job_it = start_job(job_it, date);
+    }
+
+    if (_policy == BuiltinSchedulingPolicy::FCFS || job_it == _pending_jobs.end() || _free_resources.size() == 0)
+    {
+        return;
+    }
+
+    // EASY: the first pending job is reserved the earliest date at which enough resources are expected to be free
+    const double infinity = std::numeric_limits<double>::infinity();
+    const int priority_job_nb_res = job_it->nb_res;
+    int nb_available_resources = static_cast<int>(_free_resources.size());
+    double shadow_date = infinity;
+    int nb_extra_resources = 0;
+    for (const auto & [expected_end, nb_res] : _expected_ends)
+    {
+        nb_available_resources += nb_res;
+        if (nb_available_resources >= priority_job_nb_res)
+        {
+            shadow_date = expected_end;
+            nb_extra_resources = nb_available_resources - priority_job_nb_res;
+            break;
+        }
+    }
+
+    if (shadow_date == infinity)
+    {
+        // The reservation depends on jobs without walltime: backfilling could delay the first pending job forever
+        return;
+    }
+
+    // Other pending jobs are started if they end before the reservation or only use the resources it does not need
+    ++job_it;
+    for (int depth = 0; job_it != _pending_jobs.end() && depth < _max_backfilling_depth && _free_resources.size() > 0; ++depth)
+    {
+        if (job_it->nb_res <= static_cast<int>(_free_resources.size()))
+        {
+            const double expected_end = job_it->walltime < 0 ? infinity : date + job_it->walltime;
+            if (expected_end <= shadow_date)
+            {
+                job_it = start_job(job_it, date);
+                continue;
+            }
+            else if (job_it->nb_res <= nb_extra_resources)
+            {
+                nb_extra_resources -= job_it->nb_res;
+                job_it = start_job(job_it, date);
+                continue;
+            }
+        }
+        ++job_it;
+    }
+}
+
+std::list<BuiltinScheduler::PendingJob>::iterator BuiltinScheduler::start_job(std::list<PendingJob>::iterator job_it,
+                                                                              double date)
+{
+    IntervalSet allocation = _free_resources.left(job_it->nb_res);
+    _free_resources -= allocation;
+    append_decision("EXECUTE_JOB", job_it->id, &allocation, date);
+
+    const double expected_end = job_it->walltime < 0 ? std::numeric_limits<double>::infinity() : date + job_it->walltime;
+    RunningJob running_job;
+    running_job.allocation = std::move(allocation);
+    running_job.end_it = _expected_ends.emplace(expected_end, job_it->nb_res);
+    _running_jobs.emplace(std::move(job_it->id), std::move(running_job));
+
+    return _pending_jobs.erase(job_it);
+}
+
+void BuiltinScheduler::append_decision(const char * type,
+                                       const std::string & job_id,
+                                       const IntervalSet * allocation,
+                                       double date)
+{
+    _reply_writer.StartObject();
+    _reply_writer.Key("timestamp");
+    _reply_writer.Double(date);
+    _reply_writer.Key("type");
+    _reply_writer.String(type);
+    _reply_writer.Key("data");
+    _reply_writer.StartObject();
+    _reply_writer.Key("job_id");
+    _reply_writer.String(job_id.c_str(), static_cast<rapidjson::SizeType>(job_id.size()));
+    if (allocation != nullptr)
+    {
+        const string alloc = allocation->to_string_hyphen(" ", "-");
+        _reply_writer.Key("alloc");
+        _reply_writer.String(alloc.c_str(), static_cast<rapidjson::SizeType>(alloc.size()));
+    }
+    _reply_writer.EndObject();
+    _reply_writer.EndObject();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file builtin_scheduler.hpp
+ * @brief Contains the built-in (in-process) decision processes
+ */
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include <intervalset.hpp>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+/**
+ * @brief The scheduling policies of the built-in decision process
+ */
+enum class BuiltinSchedulingPolicy
+{
+    FCFS                //!< First Come First Served: jobs are started in submission order
+    ,EASY_BACKFILLING   //!< FCFS with EASY backfilling: the first pending job gets a reservation, other jobs may start earlier if they do not delay it
+};
+
+/**
+ * @brief Returns the BuiltinSchedulingPolicy corresponding to a string
+ * @param[in] str The policy name (fcfs or easy)
+ * @return The BuiltinSchedulingPolicy corresponding to str
+ * @pre str is fcfs or easy
+ */
+BuiltinSchedulingPolicy builtin_scheduling_policy_from_string(const std::string & str);
+
+/**
+ * @brief A decision process that runs within Batsim
+ * @details It reads the messages Batsim would send to an external decision process and returns the reply it would get,
+ *          so that its decisions are applied by the JsonProtocolReader exactly as the decisions of an external scheduler.
+ *          It only uses the job submissions and completions: jobs are allocated the first free compute resources,
+ *          and jobs that request more resources than there are compute resources are rejected.
+ *          The walltime of the jobs is used as their runtime estimate (jobs without walltime never end for EASY reservations).
+ *          Resource events, power states and dynamic registration are ignored.
+ */
+class BuiltinScheduler
+{
+public:
+    /**
+     * @brief Builds a BuiltinScheduler
+     * @param[in] policy The scheduling policy
+     */
+    explicit BuiltinScheduler(BuiltinSchedulingPolicy policy);
+
+    /**
+     * @brief Reads a message from Batsim and takes decisions
+     * @param[in] message The message sent by Batsim (protocol JSON message)
+     * @return The reply to Batsim (protocol JSON message)
+     * @pre The job descriptions are in the JOB_SUBMITTED events (the data storage is disabled)
+     */
+    std::string take_decisions(const std::string & message);
+
+    /**
+     * @brief Returns the number of pending jobs
+     * @return The number of pending jobs
+     */
+    size_t nb_pending_jobs() const;
+
+    /**
+     * @brief Returns the number of running jobs
+     * @return The number of running jobs
+     */
+    size_t nb_running_jobs() const;
+
+    /**
+     * @brief Returns the number of free compute resources
+     * @return The number of free compute resources
+     */
+    size_t nb_free_resources() const;
+
+private:
+    /**
+     * @brief A job waiting to be started
+     */
+    struct PendingJob
+    {
+        std::string id;     //!< The job identifier
+        int nb_res;         //!< The number of resources requested by the job
+        double walltime;    //!< The job walltime (-1 if there is none)
+    };
+
+    /**
+     * @brief A job that has been started
+     */
+    struct RunningJob
+    {
+        IntervalSet allocation;                         //!< The resources allocated to the job
+        std::multimap<double, int>::iterator end_it;    //!< The job entry in _expected_ends
+    };
+
+    /**
+     * @brief Handles a SIMULATION_BEGINS event
+     * @param[in] data The event data
+     */
+    void on_simulation_begins(const rapidjson::Value & data);
+
+    /**
+     * @brief Handles a JOB_SUBMITTED event
+     * @param[in] data The event data
+     * @param[in] date The current date
+     */
+    void on_job_submitted(const rapidjson::Value & data, double date);
+
+    /**
+     * @brief Handles a JOB_COMPLETED event
+     * @param[in] data The event data
+     */
+    void on_job_completed(const rapidjson::Value & data);
+
+    /**
+     * @brief Starts the pending jobs that can be started now, according to the policy
+     * @param[in] date The current date
+     */
+    void schedule(double date);
+
+    /**
+     * @brief Starts a pending job on the first free compute resources
+     * @param[in] job_it The pending job to start
+     * @param[in] date The current date
+     * @return The pending job that followed the started one
+     */
+    std::list<PendingJob>::iterator start_job(std::list<PendingJob>::iterator job_it, double date);
+
+    /**
+     * @brief Appends a decision event to the reply
+     * @param[in] type The event type
+     * @param[in] job_id The identifier of the job the decision is about
+     * @param[in] allocation The job allocation (nullptr if the decision is not an EXECUTE_JOB)
+     * @param[in] date The event date
+     */
+    void append_decision(const char * type, const std::string & job_id, const IntervalSet * allocation, double date);
+
+private:
+    BuiltinSchedulingPolicy _policy;                        //!< The scheduling policy
+    int _nb_compute_resources = 0;                          //!< The number of compute resources
+    IntervalSet _free_resources;                            //!< The compute resources that are not used by any job
+    std::list<PendingJob> _pending_jobs;                    //!< The pending jobs, in submission order
+    std::unordered_map<std::string, RunningJob> _running_jobs; //!< The running jobs
+    std::multimap<double, int> _expected_ends;              //!< The expected end date of the running jobs, associated with their number of resources
+    rapidjson::StringBuffer _reply_buffer;                  //!< The buffer of the current reply
+    rapidjson::Writer<rapidjson::StringBuffer> _reply_writer{_reply_buffer}; //!< Writes the current reply into _reply_buffer
+    const int _max_backfilling_depth = 4096;                //!< The maximum number of pending jobs considered for backfilling in one scheduling pass
+};
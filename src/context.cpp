@@ -5,8 +5,5 @@
  */
 BatsimContext::~BatsimContext()
 {
-    for (auto it : event_lists)
-    {
-        delete it.second;
-    }
+    delete event_stream;
 }
@@ -6,17 +6,20 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include <vector>
 
 #include <zmq.h>
 
 #include <rapidjson/document.h>
 
+#include "builtin_scheduler.hpp"
 #include "events.hpp"
 #include "export.hpp"
 #include "jobs.hpp"
 #include "machines.hpp"
 #include "network.hpp"
+#include "profiler.hpp"
 #include "profiles.hpp"
 #include "protocol.hpp"
 #include "pstate.hpp"
@@ -42,18 +45,21 @@ struct BatsimContext
     Machines machines;                              //!< The machines
     Workloads workloads;                            //!< The workloads
     Workflows workflows;                            //!< The workflows
-    std::map<std::string, EventList*> event_lists;  //!< The map of EventLists
+    EventStream * event_stream = nullptr;           //!< The merged stream of the input events (nullptr if there is no events file)
     PajeTracer paje_tracer;                         //!< The PajeTracer
+    BinaryScheduleTracer binary_schedule_tracer;    //!< The BinaryScheduleTracer
     PStateChangeTracer pstate_tracer;               //!< The PStateChangeTracer
     EnergyConsumptionTracer energy_tracer;          //!< The EnergyConsumptionTracer
     MachineStateTracer machine_state_tracer;        //!< The MachineStateTracer
     JobsTracer jobs_tracer;                         //!< The JobsTracer
     CurrentSwitches current_switches;               //!< The current switches
 
-    RedisStorage storage;                           //!< The RedisStorage
+    std::unique_ptr<Storage> storage;               //!< The data storage (only set if redis_enabled)
+    std::unique_ptr<ServerProfiler> server_profiler;//!< The profiler of the server loop (only set if the server is profiled)
+    std::unique_ptr<BuiltinScheduler> builtin_scheduler; //!< The built-in decision process (only set if decisions are not taken by an external process)
 
     rapidjson::Document config_json;                //!< The configuration information sent to the scheduler
-    bool redis_enabled;                             //!< Stores whether Redis should be used
+    bool redis_enabled;                             //!< Stores whether the data storage (Redis or another backend) should be used
     bool submission_forward_profiles;               //!< Stores whether the profile information of submitted jobs should be sent to the scheduler
     bool registration_sched_enabled;                //!< Stores whether the scheduler will be able to register jobs and profiles during the simulation
     bool registration_sched_finished = false;       //!< Stores whether the scheduler has finished submitting jobs.
@@ -77,7 +83,16 @@ struct BatsimContext
     bool allow_compute_sharing;                     //!< Stores whether sharing (using the same machine to run different jobs concurrently) should be allowed on compute machines
     bool allow_storage_sharing;                     //!< Stores whether sharing (using the same machine to run different jobs concurrently) should be allowed on storage machines
     bool trace_schedule;                            //!< Stores whether the resulting schedule should be outputted
+    bool binary_schedule_trace = false;             //!< Stores whether the schedule should be outputted as a binary trace instead of a Pajé one
     bool trace_machine_states;                      //!< Stores whether the machines states should be outputted
+    bool machine_state_coalesce = false;            //!< Stores whether at most one machine state row should be written per simulated date
+    double machine_state_period = 0;                //!< The sampling period of the machine states (in simulated seconds). 0 if they are written on every update
+    bool energy_trace_coalesce = false;             //!< Stores whether at most one energy row (and one power state change row per power state) should be written per simulated date
+    bool async_outputs = false;                     //!< Stores whether the output files should be written by background threads
+    OutputCompression export_compression = OutputCompression::NONE; //!< The compression algorithm of the output trace files
+    bool export_columnar_jobs = false;              //!< Stores whether the jobs should also be exported into a binary columnar file
+    uint64_t export_chunk_size = 0;                 //!< The size (in bytes) from which the CSV output chunks are ended. 0 if unlimited
+    double export_chunk_period = 0;                 //!< The duration (in simulated seconds) covered by each CSV output chunk. 0 if unlimited
     std::string platform_filename;                  //!< The name of the platform file
     std::string export_prefix;                      //!< The output export prefix
     int workflow_nb_concurrent_jobs_limit;          //!< Limits the number of concurrent jobs for workflows
@@ -0,0 +1,91 @@
+/**
+ * @file energy_aggregate.cpp
+ * @brief Contains the incremental accounting of the energy of machines whose power is constant
+ */
+
+#include "energy_aggregate.hpp"
+
+#include <xbt.h>
+
+//! The number of updates after which the aggregate is recomputed, to bound the accumulated rounding errors
+static const size_t nb_updates_between_resynchronizations = 1 << 16;
+
+void StableEnergyAggregate::reset(size_t nb_machines, long double date)
+{
+    _energy_at_sync.assign(nb_machines, 0);
+    _power_at_sync.assign(nb_machines, 0);
+    _sync_date.assign(nb_machines, date);
+    _is_stable.assign(nb_machines, false);
+    _energy = 0;
+    _power = 0;
+    _date = date;
+    _nb_updates = 0;
+}
+
+void StableEnergyAggregate::set_stable(size_t machine_id, long double date, long double energy, long double power)
+{
+    set_unstable(machine_id, date);
+
+    _energy_at_sync[machine_id] = energy;
+    _power_at_sync[machine_id] = power;
+    _sync_date[machine_id] = date;
+    _is_stable[machine_id] = true;
+
+    _energy += energy;
+    _power += power;
+}
+
+void StableEnergyAggregate::set_unstable(size_t machine_id, long double date)
+{
+    advance(date);
+
+    if (_is_stable[machine_id])
+    {
+        _energy -= machine_energy(machine_id, date);
+        _power -= _power_at_sync[machine_id];
+        _is_stable[machine_id] = false;
+    }
+
+    if (++_nb_updates >= nb_updates_between_resynchronizations)
+    {
+        resynchronize(date);
+    }
+}
+
+bool StableEnergyAggregate::is_stable(size_t machine_id) const
+{
+    return _is_stable[machine_id];
+}
+
+long double StableEnergyAggregate::machine_energy(size_t machine_id, long double date) const
+{
+    xbt_assert(_is_stable[machine_id], "Internal error: machine %zu is not stable", machine_id);
+    return _energy_at_sync[machine_id] + _power_at_sync[machine_id] * (date - _sync_date[machine_id]);
+}
+
+long double StableEnergyAggregate::total_energy(long double date) const
+{
+    return _energy + _power * (date - _date);
+}
+
+void StableEnergyAggregate::resynchronize(long double date)
+{
+    _energy = 0;
+    _power = 0;
+    _date = date;
+    for (size_t machine_id = 0; machine_id < _is_stable.size(); ++machine_id)
+    {
+        if (_is_stable[machine_id])
+        {
+            _energy += machine_energy(machine_id, date);
+            _power += _power_at_sync[machine_id];
+        }
+    }
+    _nb_updates = 0;
+}
+
+void StableEnergyAggregate::advance(long double date)
+{
+    _energy += _power * (date - _date);
+    _date = date;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file energy_aggregate.hpp
+ * @brief Contains the incremental accounting of the energy of machines whose power is constant
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Aggregates the energy consumed by the machines whose power consumption is constant
+ * @details The energy of a stable machine is extrapolated from its energy and power at its last synchronization,
+ *          so that the total energy of all the stable machines can be computed without iterating over them.
+ *          Unstable machines are not accounted: their energy must be queried by the caller.
+ */
+class StableEnergyAggregate
+{
+public:
+    /**
+     * @brief Resets the aggregate, with all machines being unstable
+     * @param[in] nb_machines The number of machines
+     * @param[in] date The current date
+     */
+    void reset(size_t nb_machines, long double date);
+
+    /**
+     * @brief Marks a machine as stable from a given date
+     * @param[in] machine_id The machine index
+     * @param[in] date The current date
+     * @param[in] energy The energy consumed by the machine since time 0
+     * @param[in] power The (constant) power of the machine from now on
+     */
+    void set_stable(size_t machine_id, long double date, long double energy, long double power);
+
+    /**
+     * @brief Marks a machine as unstable from a given date
+     * @param[in] machine_id The machine index
+     * @param[in] date The current date
+     */
+    void set_unstable(size_t machine_id, long double date);
+
+    /**
+     * @brief Returns whether a machine is stable
+     * @param[in] machine_id The machine index
+     * @return True if and only if the machine is stable
+     */
+    bool is_stable(size_t machine_id) const;
+
+    /**
+     * @brief Returns the energy consumed by a stable machine since time 0
+     * @param[in] machine_id The machine index
+     * @param[in] date The current date
+     * @return The energy consumed by the machine since time 0
+     * @pre The machine is stable
+     */
+    long double machine_energy(size_t machine_id, long double date) const;
+
+    /**
+     * @brief Returns the energy consumed by all the stable machines since time 0
+     * @param[in] date The current date
+     * @return The energy consumed by all the stable machines since time 0
+     */
+    long double total_energy(long double date) const;
+
+    /**
+     * @brief Recomputes the aggregate from the values of each machine, which discards the rounding errors accumulated so far
+     * @param[in] date The current date
+     */
+    void resynchronize(long double date);
+
+private:
+    /**
+     * @brief Brings the aggregated energy to a given date
+     * @param[in] date The current date
+     */
+    void advance(long double date);
+
+private:
+    std::vector<long double> _energy_at_sync;   //!< The energy of each machine at its last synchronization
+    std::vector<long double> _power_at_sync;    //!< The power of each machine at its last synchronization
+    std::vector<long double> _sync_date;        //!< The date of the last synchronization of each machine
+    std::vector<bool> _is_stable;               //!< Whether each machine is accounted in the aggregate
+    long double _energy = 0;                    //!< The energy consumed by stable machines at _date
+    long double _power = 0;                     //!< The power consumed by stable machines
+    long double _date = 0;                      //!< The date at which _energy is valid
+    size_t _nb_updates = 0;                     //!< The number of updates since the last resynchronization
+};
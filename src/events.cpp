@@ -5,6 +5,7 @@
 
 #include "events.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 #include <simgrid/s4u.hpp>
@@ -156,63 +157,171 @@ bool event_comparator_timestamp_number(const Event * a, const Event * b)
 }
 
 
-// Events-related functions
-EventList::EventList(const string &name, const bool is_static) :
-    _name(name),
-    _is_static(is_static)
+// EventReader-related functions
+
+bool EventReader::buffered_event_comparator(const BufferedEvent & a, const BufferedEvent & b)
+{
+    if (event_comparator_timestamp_number(b.event, a.event))
+    {
+        return true;
+    }
+    if (event_comparator_timestamp_number(a.event, b.event))
+    {
+        return false;
+    }
+    return a.rank > b.rank;
+}
+
+EventReader::EventReader(const std::string & json_filename,
+                         bool unknown_as_generic,
+                         size_t look_ahead) :
+    _file(json_filename),
+    _filename(json_filename),
+    _unknown_as_generic(unknown_as_generic),
+    _look_ahead(std::max<size_t>(look_ahead, 1))
 {
+    xbt_assert(_file.is_open(), "Cannot read file '%s'", json_filename.c_str());
+    XBT_INFO("Streaming JSON events from '%s' (look-ahead of %zu events) ...",
+             json_filename.c_str(), _look_ahead);
+
+    _buffer.reserve(_look_ahead);
+    while (_buffer.size() < _look_ahead && read_event());
 }
 
-EventList::~EventList()
+EventReader::~EventReader()
 {
-    for(auto & event: _events)
+    for (auto & buffered_event : _buffer)
     {
-        delete event;
+        delete buffered_event.event;
     }
 }
 
-void EventList::load_from_json(const std::string & json_filename, bool unknown_as_generic)
+bool EventReader::read_event()
 {
-    XBT_INFO("Loading JSON events from '%s' ...", json_filename.c_str());
-    _file = json_filename;
-
-    std::ifstream ifile(json_filename.c_str());
-    xbt_assert(ifile.is_open(), "Cannot read file '%s'", json_filename.c_str());
-    string line;
-    while(getline(ifile, line))
+    while (getline(_file, _line))
     {
-        if(line.size() > 0)
+        if (_line.size() > 0)
         {
             Document doc;
-            doc.Parse(line.c_str());
-            xbt_assert(!doc.HasParseError() and doc.IsObject(), "Invalid JSON event file %s, an event could not be parsed.", json_filename.c_str());
-
-            Event * event = Event::from_json(doc, unknown_as_generic);
-            add_event(event);
+            doc.Parse(_line.c_str());
+            xbt_assert(!doc.HasParseError() and doc.IsObject(),
+                       "Invalid JSON event file %s, an event could not be parsed.", _filename.c_str());
+
+            Event * event = Event::from_json(doc, _unknown_as_generic);
+            _buffer.push_back({event, _nb_read_events});
+            push_heap(_buffer.begin(), _buffer.end(), buffered_event_comparator);
+            ++_nb_read_events;
+            return true;
         }
     }
-    sort(_events.begin(), _events.end(), event_comparator_timestamp_number);
 
-    XBT_INFO("JSON events sucessfully parsed. Read %lu events.", _events.size());
-    ifile.close();
+    XBT_INFO("All the %zu JSON events of '%s' have been read.", _nb_read_events, _filename.c_str());
+    return false;
 }
 
-std::vector<Event*> &EventList::events()
+Event * EventReader::next()
 {
-    return _events;
+    if (_buffer.empty())
+    {
+        return nullptr;
+    }
+
+    pop_heap(_buffer.begin(), _buffer.end(), buffered_event_comparator);
+    Event * event = _buffer.back().event;
+    _buffer.pop_back();
+
+    xbt_assert(event->timestamp >= _last_timestamp,
+               "Invalid JSON event file %s: an event (timestamp=%Lg) is placed at least %zu events after "
+               "an event that occurs later (timestamp=%Lg). Please sort the file by timestamp, "
+               "or increase the look-ahead (--events-look-ahead).",
+               _filename.c_str(), event->timestamp, _look_ahead, _last_timestamp);
+    _last_timestamp = event->timestamp;
+
+    read_event();
+    return event;
 }
 
-const std::vector<Event*> &EventList::events() const
+const std::string & EventReader::filename() const
 {
-    return _events;
+    return _filename;
 }
 
-void EventList::add_event(Event * event)
+size_t EventReader::nb_read_events() const
+{
+    return _nb_read_events;
+}
+
+
+// EventStream-related functions
+EventStream::~EventStream()
 {
-    _events.push_back(event);
+    for (auto & head : _heap)
+    {
+        delete head.event;
+    }
+
+    for (auto & reader : _readers)
+    {
+        delete reader;
+    }
+}
+
+void EventStream::add_file(const std::string & json_filename,
+                           bool unknown_as_generic,
+                           size_t look_ahead)
+{
+    _readers.push_back(new EventReader(json_filename, unknown_as_generic, look_ahead));
+    push_next_event(_readers.size() - 1);
+}
+
+bool EventStream::head_comparator(const HeadEvent & a, const HeadEvent & b)
+{
+    if (event_comparator_timestamp_number(b.event, a.event))
+    {
+        return true;
+    }
+    if (event_comparator_timestamp_number(a.event, b.event))
+    {
+        return false;
+    }
+    return a.reader_index > b.reader_index;
+}
+
+void EventStream::push_next_event(size_t reader_index)
+{
+    Event * event = _readers[reader_index]->next();
+    if (event != nullptr)
+    {
+        _heap.push_back({event, reader_index});
+        push_heap(_heap.begin(), _heap.end(), head_comparator);
+    }
+}
+
+const Event * EventStream::peek() const
+{
+    if (_heap.empty())
+    {
+        return nullptr;
+    }
+    return _heap.front().event;
+}
+
+Event * EventStream::next()
+{
+    if (_heap.empty())
+    {
+        return nullptr;
+    }
+
+    pop_heap(_heap.begin(), _heap.end(), head_comparator);
+    HeadEvent head = _heap.back();
+    _heap.pop_back();
+
+    push_next_event(head.reader_index);
+    return head.event;
 }
 
-bool EventList::is_static() const
+size_t EventStream::nb_files() const
 {
-    return _is_static;
+    return _readers.size();
 }
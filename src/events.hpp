@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <fstream>
 #include <map>
 #include <string>
 #include <vector>
@@ -91,65 +92,175 @@ public:
 };
 
 /**
- * @brief Compares events thanks to their timestamps
+ * @brief Compares events thanks to their timestamps, then to their types
  * @param a The first Event
  * @param b The second Event
- * @return  True if and only if the first event's timestamp is strictly lower than the second event's timestamp
+ * @return  True if and only if the first event's timestamp is strictly lower than the second event's timestamp,
+ *          or if the timestamps are equal and the first event's type is lower than the second event's type
  */
 bool event_comparator_timestamp_number(const Event * a, const Event * b);
 
 /**
- * @brief List of Events to be submitted via an event_submitter
+ * @brief Reads the Events of a JSON file in non-decreasing timestamp order, without loading the whole file
+ * @details The file contains one JSON event per line. Lines are parsed on demand and kept in a bounded
+ *          look-ahead buffer, so that events do not need to be perfectly sorted in the file: an event can
+ *          appear less than look_ahead events after events that occur later.
  */
-class EventList
+class EventReader
 {
 public:
     /**
-     * @brief Creates an empty EventList
-     * @param[in] name The name of the EventList
-     * @param[in] is_static Whether this EventList is static or not
+     * @brief Opens an events file
+     * @param[in] json_filename The name of the JSON file
+     * @param[in] unknown_as_generic Whether an unknown event has to be treated as a generic Event
+     * @param[in] look_ahead The maximum number of events read in advance (at least 1)
+     */
+    explicit EventReader(const std::string & json_filename,
+                         bool unknown_as_generic = false,
+                         size_t look_ahead = 4096);
+
+    /**
+     * @brief EventReader cannot be copied.
+     * @param[in] other Another instance
+     */
+    EventReader(const EventReader & other) = delete;
+
+    /**
+     * @brief Destroys an EventReader, and the events that have been read but not returned
+     */
+    ~EventReader();
+
+    /**
+     * @brief Returns the next Event of the file, in non-decreasing timestamp order
+     * @details An error is raised if the file is too unordered for the look-ahead buffer.
+     * @return The next Event, whose ownership is given to the caller. nullptr if there is no more event
+     */
+    Event * next();
+
+    /**
+     * @brief Returns the name of the events file
+     * @return The name of the events file
+     */
+    const std::string & filename() const;
+
+    /**
+     * @brief Returns the number of events read from the file so far
+     * @return The number of events read from the file so far
+     */
+    size_t nb_read_events() const;
+
+private:
+    /**
+     * @brief Reads the next event of the file into the look-ahead buffer
+     * @return false if the end of the file has been reached, true otherwise
+     */
+    bool read_event();
+
+private:
+    /**
+     * @brief An Event in the look-ahead buffer
+     */
+    struct BufferedEvent
+    {
+        Event * event;  //!< The Event
+        size_t rank;    //!< The rank of the event in the file, to keep the file order between simultaneous events
+    };
+
+    /**
+     * @brief Compares two BufferedEvent, so that the heap top is the earliest event (the first one in the file on ties)
+     * @param[in] a The first BufferedEvent
+     * @param[in] b The second BufferedEvent
+     * @return True if and only if a should be returned after b
+     */
+    static bool buffered_event_comparator(const BufferedEvent & a, const BufferedEvent & b);
+
+    std::ifstream _file;                        //!< The events file
+    std::string _filename;                      //!< The name of the events file
+    std::string _line;                          //!< The last line read
+    bool _unknown_as_generic;                   //!< Whether an unknown event has to be treated as a generic Event
+    size_t _look_ahead;                         //!< The maximum number of events in the look-ahead buffer
+    std::vector<BufferedEvent> _buffer;         //!< The look-ahead buffer, as a heap whose top is the earliest event
+    size_t _nb_read_events = 0;                 //!< The number of events read from the file
+    long double _last_timestamp = 0;            //!< The timestamp of the last returned event
+};
+
+/**
+ * @brief Merges the Events of several files into a single stream in non-decreasing timestamp order
+ * @details Only the next event of each file is kept outside the EventReader look-ahead buffers,
+ *          so the memory does not grow with the length of the files.
+ */
+class EventStream
+{
+public:
+    /**
+     * @brief Creates an empty EventStream
+     */
+    EventStream() = default;
+
+    /**
+     * @brief EventStream cannot be copied.
+     * @param[in] other Another instance
      */
-    explicit EventList(const std::string & name = "unset", const bool is_static = true);
+    EventStream(const EventStream & other) = delete;
 
     /**
-      * @brief Destroys an EventList
-      */
-    ~EventList();
+     * @brief Destroys an EventStream, and the events that have not been returned
+     */
+    ~EventStream();
 
     /**
-     * @brief Loads static Events from a JSON filename
+     * @brief Adds an events file to the stream
      * @param[in] json_filename The name of the JSON file
      * @param[in] unknown_as_generic Whether an unknown event has to be treated as a generic Event
+     * @param[in] look_ahead The maximum number of events read in advance in this file
+     */
+    void add_file(const std::string & json_filename,
+                  bool unknown_as_generic = false,
+                  size_t look_ahead = 4096);
+
+    /**
+     * @brief Returns the next Event of the stream, without removing it from the stream
+     * @return The next Event. nullptr if there is no more event
+     */
+    const Event * peek() const;
+
+    /**
+     * @brief Returns the next Event of the stream, and removes it from the stream
+     * @return The next Event, whose ownership is given to the caller. nullptr if there is no more event
      */
-    void load_from_json(const std::string & json_filename, bool unknown_as_generic = false);
+    Event * next();
 
     /**
-     * @brief Gets the list of Events
-     * @return The internal vector of Event*
+     * @brief Returns the number of files of the stream
+     * @return The number of files of the stream
      */
-    std::vector<Event*> & events();
+    size_t nb_files() const;
 
+private:
     /**
-     * @brief Gets the list of Events (const version)
-     * @return The internal vector of Event* (const version)
+     * @brief The next Event of a file
      */
-    const std::vector<Event*> & events() const;
+    struct HeadEvent
+    {
+        Event * event;          //!< The Event
+        size_t reader_index;    //!< The index of the EventReader the Event comes from
+    };
 
     /**
-     * @brief Adds an event to the EventList
-     * @param[in] event The Event to add to the list
+     * @brief Compares two HeadEvent, so that the heap top is the earliest event
+     * @param[in] a The first HeadEvent
+     * @param[in] b The second HeadEvent
+     * @return True if and only if a should be returned after b
      */
-    void add_event(Event * event);
+    static bool head_comparator(const HeadEvent & a, const HeadEvent & b);
 
     /**
-     * @brief Returns whether the EventList is static (corresponding to a Batsim input EventList) or not
-     * @return  Whether the EventList is static or not
+     * @brief Reads the next event of a file and pushes it into the heap if any
+     * @param[in] reader_index The index of the EventReader
      */
-    bool is_static() const;
+    void push_next_event(size_t reader_index);
 
 private:
-    std::vector<Event*> _events;    //!< The list of events (should be sorted in non-decreasing timestamp)
-    std::string _name;              //!< The name of the event list
-    std::string _file = "";         //!< The filename of the event list, if any
-    bool _is_static;                //!< Whether the EventList is dynamic
+    std::vector<EventReader *> _readers;    //!< The readers of the files
+    std::vector<HeadEvent> _heap;           //!< The next event of each file that has not ended, as a heap
 };
@@ -7,7 +7,10 @@
 #include "export.hpp"
 
 #include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <random>
 
 #include <boost/algorithm/string/join.hpp>
@@ -17,6 +20,13 @@
 #include <math.h>
 #include <float.h>
 
+#ifdef BATSIM_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef BATSIM_WITH_ZSTD
+#include <zstd.h>
+#endif
+
 #include "context.hpp"
 #include "jobs.hpp"
 
@@ -27,9 +37,20 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(export, "export"); //!< Logging
 
 void prepare_batsim_outputs(BatsimContext * context)
 {
-    if (context->trace_schedule)
+    WriteBuffer::set_asynchronous_by_default(context->async_outputs);
+    ChunkedOutput::set_chunk_limits_by_default(context->export_chunk_size, context->export_chunk_period);
+    // Compressed files are recognized by WriteBuffer from their suffix
+    const std::string compression_suffix = output_compression_suffix(context->export_compression);
+
+    if (context->trace_schedule && context->binary_schedule_trace)
+    {
+        context->binary_schedule_tracer.initialize(context, context->export_prefix + "_schedule.bst" + compression_suffix,
+                                                   simgrid::s4u::Engine::get_clock());
+        context->machines.set_binary_schedule_tracer(&context->binary_schedule_tracer);
+    }
+    else if (context->trace_schedule)
     {
-        context->paje_tracer.set_filename(context->export_prefix + "_schedule.trace");
+        context->paje_tracer.set_filename(context->export_prefix + "_schedule.trace" + compression_suffix);
         context->machines.set_tracer(&context->paje_tracer);
         context->paje_tracer.initialize(context, simgrid::s4u::Engine::get_clock());
     }
@@ -37,17 +58,20 @@ void prepare_batsim_outputs(BatsimContext * context)
     if (context->trace_machine_states)
     {
         context->machine_state_tracer.set_context(context);
-        context->machine_state_tracer.set_filename(context->export_prefix + "_machine_states.csv");
+        context->machine_state_tracer.set_aggregation(context->machine_state_coalesce, context->machine_state_period);
+        context->machine_state_tracer.set_filename(context->export_prefix + "_machine_states.csv" + compression_suffix);
     }
 
     if (context->energy_used)
     {
         // Energy consumption tracing
         context->energy_tracer.set_context(context);
-        context->energy_tracer.set_filename(context->export_prefix + "_consumed_energy.csv");
+        context->energy_tracer.set_coalesce(context->energy_trace_coalesce);
+        context->energy_tracer.set_filename(context->export_prefix + "_consumed_energy.csv" + compression_suffix);
 
         // Power state tracing
-        context->pstate_tracer.setFilename(context->export_prefix + "_pstate_changes.csv");
+        context->pstate_tracer.set_coalesce(context->energy_trace_coalesce);
+        context->pstate_tracer.setFilename(context->export_prefix + "_pstate_changes.csv" + compression_suffix);
 
         std::map<int, IntervalSet> pstate_to_machine_set;
         for (const Machine * machine : context->machines.machines())
@@ -76,17 +100,23 @@ void prepare_batsim_outputs(BatsimContext * context)
     }
 
     context->jobs_tracer.initialize(context,
-                                    context->export_prefix + "_jobs.csv",
-                                    context->export_prefix + "_schedule.csv");
+                                    context->export_prefix + "_jobs.csv" + compression_suffix,
+                                    context->export_prefix + "_schedule.csv",
+                                    context->export_columnar_jobs ? context->export_prefix + "_jobs.bcol" + compression_suffix : "");
 }
 
 void finalize_batsim_outputs(BatsimContext * context)
 {
+    // Note: destroying the WriteBuffers of the tracers waits for their writer threads, if any
     // Let's say the simulation is ended now
     context->simulation_end_time = chrono::high_resolution_clock::now();
 
-    // Schedule (Pajé)
-    if (context->trace_schedule)
+    // Schedule (Pajé or binary)
+    if (context->trace_schedule && context->binary_schedule_trace)
+    {
+        context->binary_schedule_tracer.finalize(simgrid::s4u::Engine::get_clock());
+    }
+    else if (context->trace_schedule)
     {
         context->paje_tracer.finalize(context, simgrid::s4u::Engine::get_clock());
     }
@@ -109,17 +139,314 @@ void finalize_batsim_outputs(BatsimContext * context)
 
     // Finalize both jobs and schedule output files
     context->jobs_tracer.finalize();
+
+    if (context->server_profiler != nullptr)
+    {
+        context->server_profiler->write_report(context->export_prefix + "_server_profile.json");
+    }
 }
 
 
-WriteBuffer::WriteBuffer(const std::string & filename, size_t buffer_size)
-    : buffer_size(buffer_size)
+OutputCompression output_compression_from_string(const std::string & str)
+{
+    if (str == "none")
+    {
+        return OutputCompression::NONE;
+    }
+    else if (str == "gzip")
+    {
+        return OutputCompression::GZIP;
+    }
+    else if (str == "zstd")
+    {
+        return OutputCompression::ZSTD;
+    }
+    else
+    {
+        throw std::runtime_error("Invalid output compression string");
+    }
+}
+
+OutputCompression output_compression_from_filename(const std::string & filename)
+{
+    auto ends_with = [&filename](const std::string & suffix)
+    {
+        return filename.size() >= suffix.size() &&
+               filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+
+    if (ends_with(".gz"))
+    {
+        return OutputCompression::GZIP;
+    }
+    else if (ends_with(".zst"))
+    {
+        return OutputCompression::ZSTD;
+    }
+    return OutputCompression::NONE;
+}
+
+std::string output_compression_suffix(OutputCompression compression)
+{
+    switch (compression)
+    {
+    case OutputCompression::GZIP:
+        return ".gz";
+    case OutputCompression::ZSTD:
+        return ".zst";
+    case OutputCompression::NONE:
+        break;
+    }
+    return "";
+}
+
+bool output_compression_is_supported(OutputCompression compression)
+{
+    switch (compression)
+    {
+    case OutputCompression::GZIP:
+#ifdef BATSIM_WITH_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case OutputCompression::ZSTD:
+#ifdef BATSIM_WITH_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    case OutputCompression::NONE:
+        break;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Compresses a stream of data into a file
+ */
+class StreamCompressor
+{
+public:
+    /**
+     * @brief Destructor
+     */
+    virtual ~StreamCompressor() = default;
+
+    /**
+     * @brief Compresses data and writes the compressed data produced so far into a file
+     * @param[in] data The data to compress
+     * @param[in] size The size of the data (in bytes)
+     * @param[in,out] f The file stream into which the compressed data is written
+     */
+    virtual void compress(const char * data, size_t size, std::ofstream & f) = 0;
+
+    /**
+     * @brief Ends the compressed stream and writes the remaining compressed data into a file
+     * @param[in,out] f The file stream into which the compressed data is written
+     */
+    virtual void end(std::ofstream & f) = 0;
+
+protected:
+    std::vector<char> _output = std::vector<char>(64*1024); //!< The buffer into which data is compressed
+};
+
+#ifdef BATSIM_WITH_ZLIB
+/**
+ * @brief Compresses a stream of data in the gzip format (via zlib)
+ */
+class GzipCompressor : public StreamCompressor
+{
+public:
+    GzipCompressor()
+    {
+        memset(&_stream, 0, sizeof(_stream));
+        // 15 + 16: maximum window size, with a gzip header and trailer
+        int ret = deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+        xbt_assert(ret == Z_OK, "Cannot initialize the gzip compression (zlib error %d)", ret);
+    }
+
+    ~GzipCompressor() override
+    {
+        deflateEnd(&_stream);
+    }
+
+    void compress(const char * data, size_t size, std::ofstream & f) override
+    {
+        deflate_into_file(data, size, Z_NO_FLUSH, f);
+    }
+
+    void end(std::ofstream & f) override
+    {
+        deflate_into_file(nullptr, 0, Z_FINISH, f);
+    }
+
+private:
+    void deflate_into_file(const char * data, size_t size, int flush, std::ofstream & f)
+    {
+        // Data is given buffer by buffer, whose size always fits in an uInt
+        _stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        _stream.avail_in = static_cast<uInt>(size);
+
+        do
+        {
+            _stream.next_out = reinterpret_cast<Bytef *>(_output.data());
+            _stream.avail_out = static_cast<uInt>(_output.size());
+            int ret = deflate(&_stream, flush);
+            xbt_assert(ret != Z_STREAM_ERROR, "gzip compression failed");
+            f.write(_output.data(), static_cast<std::streamsize>(_output.size() - _stream.avail_out));
+        } while (_stream.avail_out == 0);
+    }
+
+private:
+    z_stream _stream; //!< The zlib stream
+};
+#endif
+
+#ifdef BATSIM_WITH_ZSTD
+/**
+ * @brief Compresses a stream of data in the zstd format
+ */
+class ZstdCompressor : public StreamCompressor
+{
+public:
+    ZstdCompressor() : _stream(ZSTD_createCCtx())
+    {
+        xbt_assert(_stream != nullptr, "Cannot initialize the zstd compression");
+        _output.resize(ZSTD_CStreamOutSize());
+    }
+
+    ~ZstdCompressor() override
+    {
+        ZSTD_freeCCtx(_stream);
+    }
+
+    void compress(const char * data, size_t size, std::ofstream & f) override
+    {
+        ZSTD_inBuffer input = {data, size, 0};
+        while (input.pos < input.size)
+        {
+            ZSTD_outBuffer output = {_output.data(), _output.size(), 0};
+            size_t ret = ZSTD_compressStream2(_stream, &output, &input, ZSTD_e_continue);
+            xbt_assert(!ZSTD_isError(ret), "zstd compression failed: %s", ZSTD_getErrorName(ret));
+            f.write(_output.data(), static_cast<std::streamsize>(output.pos));
+        }
+    }
+
+    void end(std::ofstream & f) override
+    {
+        ZSTD_inBuffer input = {nullptr, 0, 0};
+        size_t remaining;
+        do
+        {
+            ZSTD_outBuffer output = {_output.data(), _output.size(), 0};
+            remaining = ZSTD_compressStream2(_stream, &output, &input, ZSTD_e_end);
+            xbt_assert(!ZSTD_isError(remaining), "zstd compression failed: %s", ZSTD_getErrorName(remaining));
+            f.write(_output.data(), static_cast<std::streamsize>(output.pos));
+        } while (remaining != 0);
+    }
+
+private:
+    ZSTD_CCtx * _stream; //!< The zstd compression context
+};
+#endif
+
+
+/**
+ * @brief Calls a function on each maximal interval of consecutive elements of an IntervalSet, in increasing order
+ * @param[in] set The IntervalSet
+ * @param[in] function The function to call with the lower and upper bounds of each closed interval
+ */
+template <typename Function>
+static void for_each_interval(const IntervalSet & set, Function function)
+{
+    auto it = set.elements_begin();
+    if (it == set.elements_end())
+    {
+        return;
+    }
+
+    int lower = *it;
+    int upper = lower;
+    for (++it; it != set.elements_end(); ++it)
+    {
+        if (*it != upper + 1)
+        {
+            function(lower, upper);
+            lower = *it;
+        }
+        upper = *it;
+    }
+    function(lower, upper);
+}
+
+/**
+ * @brief Appends an IntervalSet into a WriteBuffer, in the format of IntervalSet::to_string_hyphen(" ")
+ * @param[in,out] wbuf The WriteBuffer
+ * @param[in] set The IntervalSet to append
+ */
+static void append_interval_set_hyphen(WriteBuffer * wbuf, const IntervalSet & set)
+{
+    bool first_interval = true;
+    for_each_interval(set, [wbuf, &first_interval](int lower, int upper)
+    {
+        if (!first_interval)
+        {
+            wbuf->append_char(' ');
+        }
+        first_interval = false;
+
+        wbuf->append_int(lower);
+        if (upper != lower)
+        {
+            wbuf->append_char('-');
+            wbuf->append_int(upper);
+        }
+    });
+}
+
+
+bool WriteBuffer::_asynchronous_by_default = false;
+
+WriteBuffer::WriteBuffer(const std::string & filename, size_t buffer_size, bool asynchronous)
+    : buffer_size(buffer_size),
+      _compression(output_compression_from_filename(filename)),
+      _asynchronous(asynchronous || _compression != OutputCompression::NONE)
 {
     xbt_assert(buffer_size > 0, "Invalid buffer size (%zu)", buffer_size);
+    // Not an assertion: plain text would be silently written into a compressed file in release builds
+    if (!output_compression_is_supported(_compression))
+    {
+        xbt_die("Cannot write file '%s': Batsim has been built without %s support",
+                filename.c_str(), _compression == OutputCompression::GZIP ? "gzip (zlib)" : "zstd");
+    }
     buffer = new char[buffer_size];
+    _nb_allocated_buffers = 1;
+
+    switch (_compression)
+    {
+    case OutputCompression::GZIP:
+#ifdef BATSIM_WITH_ZLIB
+        _compressor = std::make_unique<GzipCompressor>();
+#endif
+        break;
+    case OutputCompression::ZSTD:
+#ifdef BATSIM_WITH_ZSTD
+        _compressor = std::make_unique<ZstdCompressor>();
+#endif
+        break;
+    case OutputCompression::NONE:
+        break;
+    }
 
-    f.open(filename, ios_base::trunc);
+    f.open(filename, _compressor ? ios_base::trunc | ios_base::binary : ios_base::trunc);
     xbt_assert(f.is_open(), "Cannot write file '%s'", filename.c_str());
+
+    if (_asynchronous)
+    {
+        _writer_thread = std::thread(&WriteBuffer::writer_thread_loop, this);
+    }
 }
 
 WriteBuffer::~WriteBuffer()
@@ -129,55 +456,579 @@ WriteBuffer::~WriteBuffer()
         flush_buffer();
     }
 
+    if (_asynchronous)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _writer_should_stop = true;
+        }
+        _full_buffer_available.notify_one();
+        _writer_thread.join();
+
+        for (char * free_buffer : _free_buffers)
+        {
+            delete[] free_buffer;
+        }
+        _free_buffers.clear();
+    }
+
+    if (_compressor)
+    {
+        // The writer thread is over: the end of the compressed stream can be written from here
+        _compressor->end(f);
+        _compressor.reset();
+    }
+
     if (buffer != nullptr)
     {
         delete[] buffer;
         buffer = nullptr;
 
-        f.close();
+        f.close();
+    }
+}
+
+void WriteBuffer::set_asynchronous_by_default(bool asynchronous)
+{
+    _asynchronous_by_default = asynchronous;
+}
+
+bool WriteBuffer::asynchronous_by_default()
+{
+    return _asynchronous_by_default;
+}
+
+OutputCompression WriteBuffer::compression() const
+{
+    return _compression;
+}
+
+uint64_t WriteBuffer::nb_appended_bytes() const
+{
+    return _nb_flushed_bytes + buffer_pos;
+}
+
+void WriteBuffer::append_text(const char * text)
+{
+    append_text(text, strlen(text));
+}
+
+void WriteBuffer::append_text(const char * text, size_t text_length)
+{
+    // Is the buffer big enough?
+    if (buffer_pos + text_length < buffer_size)
+    {
+        // Append the text into the buffer
+        memcpy(buffer + buffer_pos, text, text_length * sizeof(char));
+        buffer_pos += text_length;
+    }
+    else
+    {
+        // Write the current buffer content in the file
+        flush_buffer();
+
+        // Does the text fit in the (now empty) buffer?
+        if (text_length < buffer_size)
+        {
+            // Copy the text into the buffer
+            memcpy(buffer, text, text_length * sizeof(char));
+            buffer_pos = text_length;
+        }
+        else if (_asynchronous)
+        {
+            // The text goes through the writer thread buffer by buffer, so that the file content remains ordered
+            for (size_t offset = 0; offset < text_length; offset += buffer_size)
+            {
+                buffer_pos = std::min(buffer_size, text_length - offset);
+                memcpy(buffer, text + offset, buffer_pos * sizeof(char));
+                flush_buffer();
+            }
+        }
+        else
+        {
+            // Directly write the text into the file
+            write_into_file(text, text_length);
+            _nb_flushed_bytes += text_length;
+        }
+    }
+}
+
+void WriteBuffer::append_char(char c)
+{
+    if (buffer_pos + 1 < buffer_size)
+    {
+        buffer[buffer_pos++] = c;
+    }
+    else
+    {
+        append_text(&c, 1);
+    }
+}
+
+void WriteBuffer::append_int(long long value)
+{
+    char text[24];
+    auto result = std::to_chars(text, text + sizeof(text), value);
+    append_text(text, static_cast<size_t>(result.ptr - text));
+}
+
+void WriteBuffer::append_fixed(long double value, int precision)
+{
+    // Enough for any double, not for the biggest long doubles
+    char text[512];
+#ifdef __cpp_lib_to_chars
+    auto result = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, precision);
+    if (result.ec == std::errc())
+    {
+        append_text(text, static_cast<size_t>(result.ptr - text));
+        return;
+    }
+#else
+    // Floating-point std::to_chars is not available (before GCC 11)
+    int text_length = snprintf(text, sizeof(text), "%.*Lf", precision, value);
+    if (text_length >= 0 && text_length < static_cast<int>(sizeof(text)))
+    {
+        append_text(text, static_cast<size_t>(text_length));
+        return;
+    }
+#endif
+
+    std::vector<char> big_text(static_cast<size_t>(LDBL_MAX_10_EXP + precision + 3));
+    int big_text_length = snprintf(big_text.data(), big_text.size(), "%.*Lf", precision, value);
+    append_text(big_text.data(), static_cast<size_t>(big_text_length));
+}
+
+void WriteBuffer::append_general(long double value, int precision)
+{
+    // Enough for any number in scientific notation, and for numbers with a small exponent in fixed-point notation
+    char text[128];
+#ifdef __cpp_lib_to_chars
+    auto result = std::to_chars(text, text + sizeof(text), value, std::chars_format::general, precision);
+    if (result.ec == std::errc())
+    {
+        append_text(text, static_cast<size_t>(result.ptr - text));
+        return;
+    }
+#endif
+
+    // Floating-point std::to_chars is not available (before GCC 11), or the text does not fit
+    int text_length = snprintf(text, sizeof(text), "%.*Lg", precision, value);
+    append_text(text, static_cast<size_t>(std::min(text_length, static_cast<int>(sizeof(text)) - 1)));
+}
+
+void WriteBuffer::flush_buffer()
+{
+    _nb_flushed_bytes += buffer_pos;
+    if (_asynchronous)
+    {
+        if (buffer_pos > 0)
+        {
+            hand_buffer_over();
+        }
+    }
+    else
+    {
+        write_into_file(buffer, buffer_pos);
+        buffer_pos = 0;
+    }
+}
+
+void WriteBuffer::write_into_file(const char * data, size_t size)
+{
+    if (_compressor)
+    {
+        _compressor->compress(data, size, f);
+    }
+    else
+    {
+        f.write(data, static_cast<std::streamsize>(size));
+    }
+}
+
+void WriteBuffer::hand_buffer_over()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _full_buffers.push_back({buffer, buffer_pos});
+    _full_buffer_available.notify_one();
+
+    // Memory is bounded: the simulation thread waits for the writer if all buffers are full
+    if (_free_buffers.empty() && _nb_allocated_buffers < nb_async_buffers)
+    {
+        _free_buffers.push_back(new char[buffer_size]);
+        ++_nb_allocated_buffers;
+    }
+    _free_buffer_available.wait(lock, [this] { return !_free_buffers.empty(); });
+
+    buffer = _free_buffers.back();
+    _free_buffers.pop_back();
+    buffer_pos = 0;
+}
+
+void WriteBuffer::writer_thread_loop()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _full_buffer_available.wait(lock, [this] { return !_full_buffers.empty() || _writer_should_stop; });
+        if (_full_buffers.empty())
+        {
+            // Stop has been requested and everything has been written
+            break;
+        }
+
+        auto full_buffer = _full_buffers.front();
+        _full_buffers.pop_front();
+
+        // The file is written without holding the lock, so that the simulation thread can fill other buffers meanwhile
+        lock.unlock();
+        write_into_file(full_buffer.first, full_buffer.second);
+        lock.lock();
+
+        _free_buffers.push_back(full_buffer.first);
+        _free_buffer_available.notify_one();
+    }
+}
+
+
+
+
+
+uint64_t ChunkedOutput::_chunk_size_by_default = 0;
+double ChunkedOutput::_chunk_period_by_default = 0;
+
+ChunkedOutput::ChunkedOutput(const std::string & filename, const std::string & header) :
+    _filename(filename),
+    _header(header),
+    _chunk_size(_chunk_size_by_default),
+    _chunk_period(_chunk_period_by_default)
+{
+    if (_chunk_size > 0 || _chunk_period > 0)
+    {
+        _index_wbuf = new WriteBuffer(index_filename(filename), 64*1024, false);
+        _index_wbuf->append_text("chunk,filename,nb_rows,first_time,last_time\n");
+    }
+
+    open_chunk();
+}
+
+ChunkedOutput::~ChunkedOutput()
+{
+    close_chunk();
+
+    if (_index_wbuf != nullptr)
+    {
+        delete _index_wbuf;
+        _index_wbuf = nullptr;
+    }
+}
+
+WriteBuffer * ChunkedOutput::begin_row(double date)
+{
+    if (_index_wbuf != nullptr)
+    {
+        if (_nb_chunk_rows > 0 &&
+            ((_chunk_size > 0 && _wbuf->nb_appended_bytes() >= _chunk_size) ||
+             (_chunk_period > 0 && std::floor(date / _chunk_period) != std::floor(_chunk_first_date / _chunk_period))))
+        {
+            close_chunk();
+            open_chunk();
+        }
+
+        if (_nb_chunk_rows == 0)
+        {
+            _chunk_first_date = date;
+        }
+        _chunk_last_date = date;
+    }
+
+    ++_nb_chunk_rows;
+    return _wbuf;
+}
+
+void ChunkedOutput::flush()
+{
+    _wbuf->flush_buffer();
+}
+
+void ChunkedOutput::set_chunk_limits_by_default(uint64_t chunk_size, double chunk_period)
+{
+    xbt_assert(chunk_period >= 0, "Invalid chunk period (%g)", chunk_period);
+    _chunk_size_by_default = chunk_size;
+    _chunk_period_by_default = chunk_period;
+}
+
+/**
+ * @brief Splits a filename into its stem and its extension (compression suffix included)
+ * @param[in] filename The filename (e.g., out/sim_jobs.csv.gz)
+ * @return The stem (e.g., out/sim_jobs) and the extension (e.g., .csv.gz)
+ */
+static std::pair<std::string, std::string> split_output_filename(const std::string & filename)
+{
+    const size_t compression_suffix_length = output_compression_suffix(output_compression_from_filename(filename)).size();
+    const std::string uncompressed = filename.substr(0, filename.size() - compression_suffix_length);
+
+    size_t dot = uncompressed.rfind('.');
+    size_t slash = uncompressed.rfind('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        dot = uncompressed.size();
+    }
+
+    return {filename.substr(0, dot), filename.substr(dot)};
+}
+
+std::string ChunkedOutput::chunk_filename(const std::string & filename, int chunk)
+{
+    auto stem_and_extension = split_output_filename(filename);
+    char chunk_text[16];
+    snprintf(chunk_text, sizeof(chunk_text), ".%05d", chunk);
+    return stem_and_extension.first + chunk_text + stem_and_extension.second;
+}
+
+std::string ChunkedOutput::index_filename(const std::string & filename)
+{
+    return split_output_filename(filename).first + ".index.csv";
+}
+
+void ChunkedOutput::open_chunk()
+{
+    xbt_assert(_wbuf == nullptr, "wrong call: the current chunk has not been closed");
+    _wbuf = new WriteBuffer(_index_wbuf != nullptr ? chunk_filename(_filename, _nb_chunks) : _filename);
+    _wbuf->append_text(_header.c_str(), _header.size());
+    _nb_chunk_rows = 0;
+    ++_nb_chunks;
+}
+
+void ChunkedOutput::close_chunk()
+{
+    xbt_assert(_wbuf != nullptr, "wrong call: there is no current chunk");
+    delete _wbuf;
+    _wbuf = nullptr;
+
+    if (_index_wbuf != nullptr)
+    {
+        // The index only references the chunk basename, so that the files can be moved together
+        std::string chunk = chunk_filename(_filename, _nb_chunks - 1);
+        chunk = chunk.substr(chunk.rfind('/') + 1);
+
+        _index_wbuf->append_int(_nb_chunks - 1);
+        _index_wbuf->append_char(',');
+        _index_wbuf->append_text(chunk.c_str(), chunk.size());
+        _index_wbuf->append_char(',');
+        _index_wbuf->append_int(static_cast<long long>(_nb_chunk_rows));
+        _index_wbuf->append_char(',');
+        if (_nb_chunk_rows > 0)
+        {
+            _index_wbuf->append_fixed(_chunk_first_date);
+            _index_wbuf->append_char(',');
+            _index_wbuf->append_fixed(_chunk_last_date);
+        }
+        else
+        {
+            _index_wbuf->append_char(',');
+        }
+        _index_wbuf->append_char('\n');
+
+        // The index remains usable if the simulation does not end properly
+        _index_wbuf->flush_buffer();
+    }
+}
+
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Columnar files are written in little-endian byte order");
+
+constexpr char ColumnarWriter::magic[9];
+
+ColumnarWriter::ColumnarWriter(const std::string & filename, uint32_t row_group_size) :
+    _row_group_size(row_group_size)
+{
+    xbt_assert(row_group_size > 0, "Invalid row group size (%u)", row_group_size);
+    _wbuf = new WriteBuffer(filename);
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    flush_row_group();
+    write_header();
+
+    // End of file: an empty row group, then the total number of rows
+    const uint32_t end_marker = 0;
+    write_bytes(&end_marker, sizeof(end_marker));
+    write_bytes(&_nb_rows, sizeof(_nb_rows));
+
+    delete _wbuf;
+    _wbuf = nullptr;
+}
+
+int ColumnarWriter::add_column(const std::string & name, ColumnType type, const std::vector<std::string> & dictionary)
+{
+    xbt_assert(!_header_written && _nb_rows_in_group == 0,
+               "Cannot add column '%s': rows have already been written", name.c_str());
+    xbt_assert(type != ColumnType::DICT8 || dictionary.size() <= 256,
+               "Cannot add column '%s': its dictionary has more than 256 entries", name.c_str());
+
+    Column col;
+    col.name = name;
+    col.type = type;
+    if (type == ColumnType::DICT8)
+    {
+        col.dictionary = dictionary;
+    }
+    if (type == ColumnType::STRING || type == ColumnType::INTERVALS)
+    {
+        col.offsets.push_back(0);
+    }
+    _columns.push_back(col);
+
+    return static_cast<int>(_columns.size()) - 1;
+}
+
+ColumnarWriter::Column & ColumnarWriter::column_to_set(int column, ColumnType type)
+{
+    xbt_assert(column >= 0 && column < static_cast<int>(_columns.size()), "Invalid column index %d", column);
+    Column & col = _columns[static_cast<size_t>(column)];
+    xbt_assert(col.type == type, "Invalid value type for column '%s'", col.name.c_str());
+    xbt_assert(col.nb_values == _nb_rows_in_group, "Column '%s' is set twice in the same row", col.name.c_str());
+    ++col.nb_values;
+    return col;
+}
+
+void ColumnarWriter::append_float64(int column, double value)
+{
+    Column & col = column_to_set(column, ColumnType::FLOAT64);
+    const char * bytes = reinterpret_cast<const char *>(&value);
+    col.data.insert(col.data.end(), bytes, bytes + sizeof(value));
+}
+
+void ColumnarWriter::append_int32(int column, int32_t value)
+{
+    Column & col = column_to_set(column, ColumnType::INT32);
+    const char * bytes = reinterpret_cast<const char *>(&value);
+    col.data.insert(col.data.end(), bytes, bytes + sizeof(value));
+}
+
+void ColumnarWriter::append_string(int column, const std::string & value)
+{
+    Column & col = column_to_set(column, ColumnType::STRING);
+    col.data.insert(col.data.end(), value.begin(), value.end());
+    xbt_assert(col.data.size() <= UINT32_MAX, "Column '%s' is too big for a single row group", col.name.c_str());
+    col.offsets.push_back(static_cast<uint32_t>(col.data.size()));
+}
+
+void ColumnarWriter::append_dict8(int column, uint8_t code)
+{
+    Column & col = column_to_set(column, ColumnType::DICT8);
+    xbt_assert(code < col.dictionary.size(), "Invalid code %u for column '%s'", code, col.name.c_str());
+    col.data.push_back(static_cast<char>(code));
+}
+
+void ColumnarWriter::append_intervals(int column, const IntervalSet & set)
+{
+    Column & col = column_to_set(column, ColumnType::INTERVALS);
+    for_each_interval(set, [&col](int lower, int upper)
+    {
+        const int32_t bounds[2] = {lower, upper};
+        const char * bytes = reinterpret_cast<const char *>(bounds);
+        col.data.insert(col.data.end(), bytes, bytes + sizeof(bounds));
+    });
+    col.offsets.push_back(static_cast<uint32_t>(col.data.size() / (2 * sizeof(int32_t))));
+}
+
+void ColumnarWriter::end_row()
+{
+    for (const Column & col : _columns)
+    {
+        xbt_assert(col.nb_values == _nb_rows_in_group + 1, "Column '%s' is not set in row %lu",
+                   col.name.c_str(), static_cast<unsigned long>(_nb_rows));
+    }
+
+    ++_nb_rows_in_group;
+    ++_nb_rows;
+
+    if (_nb_rows_in_group >= _row_group_size)
+    {
+        flush_row_group();
+    }
+}
+
+void ColumnarWriter::flush_row_group()
+{
+    if (_nb_rows_in_group == 0)
+    {
+        return;
+    }
+
+    write_header();
+    write_bytes(&_nb_rows_in_group, sizeof(_nb_rows_in_group));
+
+    // Each column chunk is prefixed by its size in bytes, so that readers can skip it
+    for (Column & col : _columns)
+    {
+        const uint64_t chunk_size = col.offsets.size() * sizeof(uint32_t) + col.data.size();
+        write_bytes(&chunk_size, sizeof(chunk_size));
+        write_bytes(col.offsets.data(), col.offsets.size() * sizeof(uint32_t));
+        write_bytes(col.data.data(), col.data.size());
+
+        // The memory of the vectors is kept for the next row group
+        col.data.clear();
+        col.nb_values = 0;
+        if (!col.offsets.empty())
+        {
+            col.offsets.resize(1);
+        }
+    }
+
+    _nb_rows_in_group = 0;
+}
+
+uint64_t ColumnarWriter::nb_rows() const
+{
+    return _nb_rows;
+}
+
+void ColumnarWriter::write_bytes(const void * data, size_t size)
+{
+    // The data of empty vectors may be null, which memcpy does not accept
+    if (size > 0)
+    {
+        _wbuf->append_text(static_cast<const char *>(data), size);
     }
 }
 
-void WriteBuffer::append_text(const char * text)
+void ColumnarWriter::write_header()
 {
-    const size_t text_length = strlen(text);
-
-    // Is the buffer big enough?
-    if (buffer_pos + text_length < buffer_size)
+    if (_header_written)
     {
-        // Append the text into the buffer
-        memcpy(buffer + buffer_pos, text, text_length * sizeof(char));
-        buffer_pos += text_length;
+        return;
     }
-    else
+    _header_written = true;
+
+    write_bytes(magic, 8);
+    const uint32_t nb_columns = static_cast<uint32_t>(_columns.size());
+    write_bytes(&nb_columns, sizeof(nb_columns));
+
+    for (const Column & col : _columns)
     {
-        // Write the current buffer content in the file
-        flush_buffer();
+        const uint8_t type = static_cast<uint8_t>(col.type);
+        const uint16_t name_length = static_cast<uint16_t>(col.name.size());
+        write_bytes(&type, sizeof(type));
+        write_bytes(&name_length, sizeof(name_length));
+        write_bytes(col.name.data(), col.name.size());
 
-        // Does the text fit in the (now empty) buffer?
-        if (text_length < buffer_size)
-        {
-            // Copy the text into the buffer
-            memcpy(buffer, text, text_length * sizeof(char));
-            buffer_pos = text_length;
-        }
-        else
+        if (col.type == ColumnType::DICT8)
         {
-            // Directly write the text into the file
-            f.write(text, static_cast<std::streamsize>(text_length));
+            const uint16_t nb_entries = static_cast<uint16_t>(col.dictionary.size());
+            write_bytes(&nb_entries, sizeof(nb_entries));
+            for (const std::string & entry : col.dictionary)
+            {
+                const uint16_t entry_length = static_cast<uint16_t>(entry.size());
+                write_bytes(&entry_length, sizeof(entry_length));
+                write_bytes(entry.data(), entry.size());
+            }
         }
     }
 }
 
-void WriteBuffer::flush_buffer()
-{
-    f.write(buffer, static_cast<std::streamsize>(buffer_pos));
-    buffer_pos = 0;
-}
-
-
-
-
 
 PajeTracer::PajeTracer(bool log_launchings) :
     _log_launchings(log_launchings)
@@ -471,11 +1322,10 @@ void PajeTracer::add_job_launching(const std::vector<int> & used_machine_ids,
 {
     xbt_assert(state == INITIALIZED, "Bad addJobLaunching call: the PajeTracer object is not initialized or had been finalized");
 
-    const int buf_size = 256;
+    const int buf_size = line_buffer_size;
     int nb_printed;
     (void) nb_printed; // Avoids a warning if assertions are ignored
-    char * buf = static_cast<char*>(malloc(sizeof(char) * buf_size));
-    xbt_assert(buf != NULL, "Couldn't allocate memory");
+    char buf[buf_size];
 
     if (_log_launchings)
     {
@@ -491,8 +1341,6 @@ void PajeTracer::add_job_launching(const std::vector<int> & used_machine_ids,
             _wbuf->append_text(buf);
         }
     }
-
-    free(buf);
 }
 
 void PajeTracer::register_new_job(const JobIdentifier & job_id)
@@ -500,11 +1348,10 @@ void PajeTracer::register_new_job(const JobIdentifier & job_id)
     xbt_assert(_jobs.find(job_id) == _jobs.end(),
                "Cannot register new job %s: it already exists", job_id.to_cstring());
 
-    const int buf_size = 256;
+    const int buf_size = line_buffer_size;
     int nb_printed;
     (void) nb_printed; // Avoids a warning if assertions are ignored
-    char * buf = static_cast<char*>(malloc(sizeof(char) * buf_size));
-    xbt_assert(buf != NULL, "Couldn't allocate memory");
+    char buf[buf_size];
 
     // Let's create a state value corresponding to this job
     nb_printed = snprintf(buf, buf_size,
@@ -517,18 +1364,25 @@ void PajeTracer::register_new_job(const JobIdentifier & job_id)
                "have been lost. Please increase Batsim's output temporary buffers' size");
     _wbuf->append_text(buf);
 
-    _jobs[job_id] = jobPrefix + job_id.to_string();
+    _jobs.insert(job_id);
+}
+
+void PajeTracer::unregister_job(const JobIdentifier & job_id)
+{
+    _jobs.erase(job_id);
+}
 
-    free(buf);
+size_t PajeTracer::nb_registered_jobs() const
+{
+    return _jobs.size();
 }
 
 void PajeTracer::set_machine_idle(int machine_id, double time)
 {
-    const int buf_size = 256;
+    const int buf_size = line_buffer_size;
     int nb_printed;
     (void) nb_printed; // Avoids a warning if assertions are ignored
-    char * buf = static_cast<char*>(malloc(sizeof(char) * buf_size));
-    xbt_assert(buf != NULL, "Couldn't allocate memory");
+    char buf[buf_size];
 
     nb_printed = snprintf(buf, buf_size,
                           "%d %lf %s %s%d %s\n",
@@ -537,35 +1391,28 @@ void PajeTracer::set_machine_idle(int machine_id, double time)
                "Writing error: buffer has been completely filled, some information might "
                "have been lost. Please increase Batsim's output temporary buffers' size");
     _wbuf->append_text(buf);
-
-    free(buf);
 }
 
 void PajeTracer::set_machine_as_computing_job(int machine_id, const JobIdentifier & job_id, double time)
 {
-    auto mit = _jobs.find(job_id);
-    if (mit == _jobs.end())
+    if (_jobs.find(job_id) == _jobs.end())
     {
         register_new_job(job_id);
-        mit = _jobs.find(job_id);
     }
 
-    const int buf_size = 256;
+    const int buf_size = line_buffer_size;
     int nb_printed;
     (void) nb_printed; // Avoids a warning if assertions are ignored
-    char * buf = static_cast<char*>(malloc(sizeof(char) * buf_size));
-    xbt_assert(buf != NULL, "Couldn't allocate memory");
+    char buf[buf_size];
 
     nb_printed = snprintf(buf, buf_size,
-                          "%d %lf %s %s%d %s\n",
+                          "%d %lf %s %s%d %s%s\n",
                           SET_STATE, time, machineState, machinePrefix, machine_id,
-                          mit->second.c_str());
+                          jobPrefix, job_id.to_cstring());
     xbt_assert(nb_printed < buf_size - 1,
                "Writing error: buffer has been completely filled, some information might "
                "have been lost. Please increase Batsim's output temporary buffers' size");
     _wbuf->append_text(buf);
-
-    free(buf);
 }
 
 void PajeTracer::add_job_kill(const JobIdentifier & job_id, const IntervalSet & used_machine_ids,
@@ -573,11 +1420,10 @@ void PajeTracer::add_job_kill(const JobIdentifier & job_id, const IntervalSet &
 {
     xbt_assert(state == INITIALIZED, "Bad addJobKill call: the PajeTracer object is not initialized or had been finalized");
 
-    const int buf_size = 256;
+    const int buf_size = line_buffer_size;
     int nb_printed;
     (void) nb_printed; // Avoids a warning if assertions are ignored
-    char * buf = static_cast<char*>(malloc(sizeof(char) * buf_size));
-    xbt_assert(buf != NULL, "Couldn't allocate memory");
+    char buf[buf_size];
 
     // Let's add a kill event associated with the scheduler
     nb_printed = snprintf(buf, buf_size,
@@ -604,19 +1450,87 @@ void PajeTracer::add_job_kill(const JobIdentifier & job_id, const IntervalSet &
             _wbuf->append_text(buf);
         }
     }
+}
+
+BinaryScheduleTracer::~BinaryScheduleTracer()
+{
+    if (_writer != nullptr)
+    {
+        delete _writer;
+        _writer = nullptr;
+    }
+}
 
-    free(buf);
+void BinaryScheduleTracer::initialize(const BatsimContext * context, const std::string & filename, double time)
+{
+    xbt_assert(_writer == nullptr, "Double call of BinaryScheduleTracer::initialize");
+    _writer = new ColumnarWriter(filename);
+
+    // The column indexes are the ones used by write_event
+    using ColumnType = ColumnarWriter::ColumnType;
+    _writer->add_column("time", ColumnType::FLOAT64);
+    _writer->add_column("event", ColumnType::DICT8, {"MACHINE", "JOB_START", "JOB_END", "JOB_KILL", "END"});
+    _writer->add_column("name", ColumnType::STRING);
+    _writer->add_column("machines", ColumnType::INTERVALS);
+
+    for (const Machine * machine : context->machines.machines())
+    {
+        add_machine(machine->id, machine->name, time);
+    }
+}
+
+void BinaryScheduleTracer::finalize(double time)
+{
+    xbt_assert(_writer != nullptr, "Bad BinaryScheduleTracer::finalize call: the object has not been initialized yet");
+    write_event(time, Event::END, "", IntervalSet());
+
+    delete _writer;
+    _writer = nullptr;
+
+    XBT_INFO("BinaryScheduleTracer finalized");
 }
 
+void BinaryScheduleTracer::add_machine(int machine_id, const std::string & machine_name, double time)
+{
+    IntervalSet machine_set;
+    machine_set.insert(machine_id);
+    write_event(time, Event::MACHINE, machine_name, machine_set);
+}
+
+void BinaryScheduleTracer::add_job_start(const JobIdentifier & job_id, const IntervalSet & machines, double time)
+{
+    write_event(time, Event::JOB_START, job_id.to_string(), machines);
+}
+
+void BinaryScheduleTracer::add_job_end(const JobIdentifier & job_id, const IntervalSet & machines, double time)
+{
+    write_event(time, Event::JOB_END, job_id.to_string(), machines);
+}
+
+void BinaryScheduleTracer::add_job_kill(const JobIdentifier & job_id, const IntervalSet & machines, double time)
+{
+    write_event(time, Event::JOB_KILL, job_id.to_string(), machines);
+}
+
+void BinaryScheduleTracer::write_event(double time, Event event, const std::string & name, const IntervalSet & machines)
+{
+    xbt_assert(_writer != nullptr, "Bad BinaryScheduleTracer call: the object is not initialized or has been finalized");
+    _writer->append_float64(0, time);
+    _writer->append_dict8(1, static_cast<uint8_t>(event));
+    _writer->append_string(2, name);
+    _writer->append_intervals(3, machines);
+    _writer->end_row();
+}
+
+
 void PajeTracer::generate_colors(int color_count)
 {
     xbt_assert(color_count > 0, "wrong call: color_count (%d) must be strictly positive", color_count);
 
-    const int buf_size = 256;
+    const int buf_size = line_buffer_size;
     int nb_printed;
     (void) nb_printed; // Avoids a warning if assertions are ignored
-    char * buf = static_cast<char*>(malloc(sizeof(char) * buf_size));
-    xbt_assert(buf != NULL, "Couldn't allocate memory");
+    char buf[buf_size];
 
     double hueFraction = 360.0 / color_count;
     for (int i = 0; i < color_count; ++i)
@@ -631,8 +1545,6 @@ void PajeTracer::generate_colors(int color_count)
                    "have been lost. Please increase Batsim's output temporary buffers' size");
         _colors.push_back(buf);
     }
-
-    free(buf);
 }
 
 void PajeTracer::shuffle_colors()
@@ -695,70 +1607,93 @@ void PajeTracer::hsv_to_rgb(double h, double s, double v, double & r, double & g
 
 /* Part related to PStateChangeTracer */
 
-PStateChangeTracer::PStateChangeTracer()
+void PStateChangeTracer::setFilename(const string &filename)
 {
-    xbt_assert(_temporary_buffer == nullptr, "wrong call: _temporary_buffer is null");
-    _temporary_buffer = static_cast<char*>(malloc(512 * sizeof(char)));
-    xbt_assert(_temporary_buffer != NULL, "Couldn't allocate memory");
+    xbt_assert(_output == nullptr, "Double call of PStateChangeTracer::setFilename");
+    _output = new ChunkedOutput(filename, "time,machine_id,new_pstate\n");
 }
 
-void PStateChangeTracer::setFilename(const string &filename)
+void PStateChangeTracer::set_coalesce(bool coalesce)
 {
-    xbt_assert(_wbuf == nullptr, "Double call of PStateChangeTracer::setFilename");
-    _wbuf = new WriteBuffer(filename);
-
-    _wbuf->append_text("time,machine_id,new_pstate\n");
+    xbt_assert(_pending_machines.empty(), "Bad PStateChangeTracer::set_coalesce call: power state changes have already been added");
+    _coalesce = coalesce;
 }
 
 PStateChangeTracer::~PStateChangeTracer()
 {
-    if (_wbuf != nullptr)
-    {
-        delete _wbuf;
-        _wbuf = nullptr;
-    }
-
-    if (_temporary_buffer != nullptr)
+    if (_output != nullptr)
     {
-        free(_temporary_buffer);
-        _temporary_buffer = nullptr;
+        delete _output;
+        _output = nullptr;
     }
 }
 
 void PStateChangeTracer::add_pstate_change(double time, const IntervalSet & machines, int pstate_after)
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
-    const string machines_as_string = machines.to_string_hyphen(" ", "-");
-    const size_t minimum_buf_size = 256 + machines_as_string.size();
-    int nb_printed;
-    (void) nb_printed; // Avoids a warning if assertions are ignored
+    if (!_coalesce)
+    {
+        write_line(time, machines, pstate_after);
+        return;
+    }
 
-    // Increases the buffer size if needed
-    _temporary_buffer = static_cast<char*>(realloc(_temporary_buffer, minimum_buf_size));
-    xbt_assert(_temporary_buffer != NULL, "Couldn't allocate memory!");
+    // The pending lines are final once the date changes
+    if (!_pending_machines.empty() && time != _pending_time)
+    {
+        write_pending_lines();
+    }
+    _pending_time = time;
 
-    nb_printed = snprintf(_temporary_buffer, minimum_buf_size, "%g,%s,%d\n",
-                          time, machines_as_string.c_str(), pstate_after);
-    xbt_assert(nb_printed < static_cast<int>(minimum_buf_size) - 1,
-               "Writing error: buffer has been completely filled, some information might "
-               "have been lost. Please increase Batsim's output temporary buffers' size");
-    _wbuf->append_text(_temporary_buffer);
+    // Only the last power state of each machine at this date is kept
+    for (auto & pending : _pending_machines)
+    {
+        if (pending.first != pstate_after)
+        {
+            pending.second -= machines;
+        }
+    }
+    _pending_machines[pstate_after] += machines;
+}
+
+void PStateChangeTracer::write_line(double time, const IntervalSet & machines, int pstate_after)
+{
+    WriteBuffer * wbuf = _output->begin_row(time);
+    wbuf->append_general(time);
+    wbuf->append_char(',');
+    append_interval_set_hyphen(wbuf, machines);
+    wbuf->append_char(',');
+    wbuf->append_int(pstate_after);
+    wbuf->append_char('\n');
+}
+
+void PStateChangeTracer::write_pending_lines()
+{
+    for (const auto & pending : _pending_machines)
+    {
+        if (pending.second.size() > 0)
+        {
+            write_line(_pending_time, pending.second, pending.first);
+        }
+    }
+    _pending_machines.clear();
 }
 
 void PStateChangeTracer::flush()
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
-    _wbuf->flush_buffer();
+    _output->flush();
 }
 
 void PStateChangeTracer::close_buffer()
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
-    delete _wbuf;
-    _wbuf = nullptr;
+    write_pending_lines();
+
+    delete _output;
+    _output = nullptr;
 }
 
 
@@ -766,10 +1701,10 @@ void PStateChangeTracer::close_buffer()
 
 EnergyConsumptionTracer::~EnergyConsumptionTracer()
 {
-    if (_wbuf != nullptr)
+    if (_output != nullptr)
     {
-        delete _wbuf;
-        _wbuf = nullptr;
+        delete _output;
+        _output = nullptr;
     }
 }
 
@@ -781,10 +1716,14 @@ void EnergyConsumptionTracer::set_context(BatsimContext *context)
 
 void EnergyConsumptionTracer::set_filename(const string &filename)
 {
-    xbt_assert(_wbuf == nullptr, "Double call of EnergyConsumptionTracer::set_filename");
-    _wbuf = new WriteBuffer(filename);
+    xbt_assert(_output == nullptr, "Double call of EnergyConsumptionTracer::set_filename");
+    _output = new ChunkedOutput(filename, "time,energy,event_type,wattmin,epower\n");
+}
 
-    _wbuf->append_text("time,energy,event_type,wattmin,epower\n");
+void EnergyConsumptionTracer::set_coalesce(bool coalesce)
+{
+    xbt_assert(!_has_pending_entry, "Bad EnergyConsumptionTracer::set_coalesce call: entries have already been added");
+    _coalesce = coalesce;
 }
 
 void EnergyConsumptionTracer::add_job_start(double date, JobIdentifier job_id)
@@ -808,63 +1747,81 @@ void EnergyConsumptionTracer::add_pstate_change(double date, const IntervalSet &
 
 void EnergyConsumptionTracer::flush()
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
-    _wbuf->flush_buffer();
+    _output->flush();
 }
 
 void EnergyConsumptionTracer::close_buffer()
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
-    delete _wbuf;
-    _wbuf = nullptr;
+    if (_has_pending_entry)
+    {
+        write_line(_pending_date, _pending_energy, _pending_event_type, _pending_wattmin);
+        _has_pending_entry = false;
+    }
+
+    delete _output;
+    _output = nullptr;
 }
 
 long double EnergyConsumptionTracer::add_entry(double date, char event_type)
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
+    // Both values are maintained incrementally by Machines, computing them does not scan every machine
     long double energy = _context->machines.total_consumed_energy(_context);
     long double wattmin = _context->machines.total_wattmin(_context);
 
-    long double time_diff = static_cast<long double>(date) - _last_entry_date;
-    long double energy_diff = energy - _last_entry_energy;
-    long double epower = -1;
+    if (!_coalesce)
+    {
+        write_line(date, energy, event_type, wattmin);
+        return energy;
+    }
 
-    if (time_diff > 0)
+    // The pending entry is final once the date changes
+    if (_has_pending_entry && date != _pending_date)
     {
-        epower = energy_diff / time_diff;
+        write_line(_pending_date, _pending_energy, _pending_event_type, _pending_wattmin);
     }
 
-    const int buf_size = 256;
-    int nb_printed;
-    (void) nb_printed; // Avoids a warning if assertions are ignored
-    char * buf = static_cast<char*>(malloc(sizeof(char) * buf_size));
-    xbt_assert(buf != NULL, "Couldn't allocate memory");
+    _has_pending_entry = true;
+    _pending_date = date;
+    _pending_energy = energy;
+    _pending_event_type = event_type;
+    _pending_wattmin = wattmin;
+
+    return energy;
+}
+
+void EnergyConsumptionTracer::write_line(double date, long double energy, char event_type, long double wattmin)
+{
+    long double time_diff = static_cast<long double>(date) - _last_entry_date;
+    long double energy_diff = energy - _last_entry_energy;
 
-    if (epower != -1)
+    // Same text as "%g,%Lg,%c,%Lg,%g\n" (or NA as epower if the time has not changed)
+    WriteBuffer * wbuf = _output->begin_row(date);
+    wbuf->append_general(date);
+    wbuf->append_char(',');
+    wbuf->append_general(energy);
+    wbuf->append_char(',');
+    wbuf->append_char(event_type);
+    wbuf->append_char(',');
+    wbuf->append_general(wattmin);
+    wbuf->append_char(',');
+    if (time_diff > 0)
     {
-        nb_printed = snprintf(buf, buf_size, "%g,%Lg,%c,%Lg,%g\n",
-                              date, energy, event_type, wattmin, static_cast<double>(epower));
+        wbuf->append_general(static_cast<double>(energy_diff / time_diff));
     }
     else
     {
-        nb_printed = snprintf(buf, buf_size, "%g,%Lg,%c,%Lg,NA\n",
-                              date, energy, event_type, wattmin);
+        wbuf->append_text("NA", 2);
     }
-    xbt_assert(nb_printed < buf_size - 1,
-               "Writing error: buffer has been completely filled, some information might "
-               "have been lost. Please increase Batsim's output temporary buffers' size");
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
-    _wbuf->append_text(buf);
-
-    free(buf);
+    wbuf->append_char('\n');
 
     _last_entry_date = static_cast<long double>(date);
     _last_entry_energy = energy;
-
-    return energy;
 }
 
 
@@ -873,10 +1830,10 @@ long double EnergyConsumptionTracer::add_entry(double date, char event_type)
 
 MachineStateTracer::~MachineStateTracer()
 {
-    if (_wbuf != nullptr)
+    if (_output != nullptr)
     {
-        delete _wbuf;
-        _wbuf = nullptr;
+        delete _output;
+        _output = nullptr;
     }
 }
 
@@ -887,8 +1844,7 @@ void MachineStateTracer::set_context(BatsimContext *context)
 
 void MachineStateTracer::set_filename(const string &filename)
 {
-    xbt_assert(_wbuf == nullptr, "Double call of MachineStateTracer::set_filename");
-    _wbuf = new WriteBuffer(filename);
+    xbt_assert(_output == nullptr, "Double call of MachineStateTracer::set_filename");
 
     vector<string> header_substrings;
     const vector<MachineState> machine_states = {MachineState::SLEEPING,
@@ -903,98 +1859,171 @@ void MachineStateTracer::set_filename(const string &filename)
 
     string header = "time," + boost::algorithm::join(header_substrings, ",") + "\n";
 
-    _wbuf->append_text(header.c_str());
-    _wbuf->flush_buffer();
+    _output = new ChunkedOutput(filename, header);
+    _output->flush();
+}
+
+void MachineStateTracer::set_aggregation(bool coalesce, double period)
+{
+    xbt_assert(period >= 0, "Invalid machine state sampling period (%g)", period);
+    xbt_assert(!_has_pending_line, "Bad MachineStateTracer::set_aggregation call: machine states have already been written");
+    _coalesce = coalesce;
+    _period = period;
 }
 
 void MachineStateTracer::write_machine_states(double date)
 {
     xbt_assert(_context != nullptr, "wrong call: _context is null");
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
     const std::map<MachineState, int> & numbers = _context->machines.nb_machines_in_each_state();
+    const int current_numbers[nb_traced_states] = {
+        numbers.at(MachineState::SLEEPING),
+        numbers.at(MachineState::TRANSITING_FROM_SLEEPING_TO_COMPUTING),
+        numbers.at(MachineState::TRANSITING_FROM_COMPUTING_TO_SLEEPING),
+        numbers.at(MachineState::IDLE),
+        numbers.at(MachineState::COMPUTING)
+    };
+
+    if (_period > 0)
+    {
+        // The samples before this date see the previous state
+        if (!_has_pending_line)
+        {
+            _first_sample_date = date;
+            _next_sample_date = date;
+        }
+        while (_has_pending_line && _next_sample_date < date)
+        {
+            write_line(_next_sample_date, _pending_numbers);
+            _next_sample_date = _first_sample_date + (++_nb_samples) * _period;
+        }
+    }
+    else if (_coalesce)
+    {
+        // The pending line is final once the date changes
+        if (_has_pending_line && date != _pending_date)
+        {
+            write_line(_pending_date, _pending_numbers);
+        }
+    }
+    else
+    {
+        write_line(date, current_numbers);
+        return;
+    }
+
+    _has_pending_line = true;
+    _pending_date = date;
+    std::copy(current_numbers, current_numbers + nb_traced_states, _pending_numbers);
+}
 
+void MachineStateTracer::write_line(double date, const int (&numbers)[nb_traced_states])
+{
     const int buf_size = 256;
     int nb_printed;
     (void) nb_printed; // Avoids a warning if assertions are ignored
-    char * buf = static_cast<char*>(malloc(sizeof(char) * buf_size));
-    xbt_assert(buf != NULL, "Couldn't allocate memory");
+    char buf[buf_size];
 
     nb_printed = snprintf(buf, buf_size, "%g,%d,%d,%d,%d,%d\n",
-                          date,
-                          numbers.at(MachineState::SLEEPING),
-                          numbers.at(MachineState::TRANSITING_FROM_SLEEPING_TO_COMPUTING),
-                          numbers.at(MachineState::TRANSITING_FROM_COMPUTING_TO_SLEEPING),
-                          numbers.at(MachineState::IDLE),
-                          numbers.at(MachineState::COMPUTING));
+                          date, numbers[0], numbers[1], numbers[2], numbers[3], numbers[4]);
     xbt_assert(nb_printed < buf_size - 1,
                "Writing error: buffer has been completely filled, some information might "
                "have been lost. Please increase Batsim's output temporary buffers' size");
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
-    _wbuf->append_text(buf);
-
-    free(buf);
+    _output->begin_row(date)->append_text(buf);
 }
 
 void MachineStateTracer::flush()
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
-    _wbuf->flush_buffer();
+    _output->flush();
 }
 
 void MachineStateTracer::close_buffer()
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
 
-    delete _wbuf;
-    _wbuf = nullptr;
+    // The latest state is written: as the last sample (up to its date) or as the last coalesced line
+    if (_has_pending_line)
+    {
+        if (_period > 0)
+        {
+            while (_next_sample_date <= _pending_date)
+            {
+                write_line(_next_sample_date, _pending_numbers);
+                _next_sample_date = _first_sample_date + (++_nb_samples) * _period;
+            }
+        }
+        else
+        {
+            write_line(_pending_date, _pending_numbers);
+        }
+        _has_pending_line = false;
+    }
+
+    delete _output;
+    _output = nullptr;
 }
 
 /* Part related to JobsTracer */
 
 JobsTracer::~JobsTracer()
 {
-    if (_wbuf != nullptr)
+    if (_output != nullptr)
     {
-        delete _wbuf;
-        _wbuf = nullptr;
+        delete _output;
+        _output = nullptr;
+    }
+
+    if (_columnar_writer != nullptr)
+    {
+        delete _columnar_writer;
+        _columnar_writer = nullptr;
     }
 }
 
 void JobsTracer::initialize(BatsimContext *context,
                        const string & jobs_filename,
-                       const string & schedule_filename)
+                       const string & schedule_filename,
+                       const string & columnar_jobs_filename)
 {
-    xbt_assert(_wbuf == nullptr, "Double call of JobsTracer::initialize");
-    _wbuf = new WriteBuffer(jobs_filename);
+    xbt_assert(_output == nullptr, "Double call of JobsTracer::initialize");
     _context = context;
     _schedule_filename = schedule_filename;
 
-    // Prepare for jobs output file
-    _job_keys = {
-        "job_id",
-        "workload_name",
-        "profile",
-        "submission_time",
-        "requested_number_of_resources",
-        "requested_time",
-        "success",
-        "final_state",
-        "starting_time",
-        "execution_time",
-        "finish_time",
-        "waiting_time",
-        "turnaround_time",
-        "stretch",
-        "allocated_resources",
-        "consumed_energy",
-        "metadata"
-    };
-    string header = boost::algorithm::join(_job_keys, ",") + "\n";
-    _row_content.reserve(_job_keys.size());
-    _wbuf->append_text(header.c_str());
-    _wbuf->flush_buffer();
+    // Prepare for jobs output file. The columns must match the order in which write_job writes them
+    _output = new ChunkedOutput(jobs_filename,
+                                "job_id,workload_name,profile,submission_time,requested_number_of_resources,requested_time,"
+                                "success,final_state,starting_time,execution_time,finish_time,waiting_time,turnaround_time,"
+                                "stretch,allocated_resources,consumed_energy,metadata\n");
+    _output->flush();
+
+    if (!columnar_jobs_filename.empty())
+    {
+        // Same columns as the CSV file. Codes of final_state are the JobState values
+        _columnar_writer = new ColumnarWriter(columnar_jobs_filename);
+        using ColumnType = ColumnarWriter::ColumnType;
+        _columnar_writer->add_column("job_id", ColumnType::STRING);
+        _columnar_writer->add_column("workload_name", ColumnType::STRING);
+        _columnar_writer->add_column("profile", ColumnType::STRING);
+        _columnar_writer->add_column("submission_time", ColumnType::FLOAT64);
+        _columnar_writer->add_column("requested_number_of_resources", ColumnType::INT32);
+        _columnar_writer->add_column("requested_time", ColumnType::FLOAT64);
+        _columnar_writer->add_column("success", ColumnType::INT32);
+        _columnar_writer->add_column("final_state", ColumnType::DICT8,
+                                     {"NOT_SUBMITTED", "SUBMITTED", "RUNNING", "COMPLETED_SUCCESSFULLY",
+                                      "COMPLETED_FAILED", "COMPLETED_WALLTIME_REACHED", "COMPLETED_KILLED", "REJECTED"});
+        _columnar_writer->add_column("starting_time", ColumnType::FLOAT64);
+        _columnar_writer->add_column("execution_time", ColumnType::FLOAT64);
+        _columnar_writer->add_column("finish_time", ColumnType::FLOAT64);
+        _columnar_writer->add_column("waiting_time", ColumnType::FLOAT64);
+        _columnar_writer->add_column("turnaround_time", ColumnType::FLOAT64);
+        _columnar_writer->add_column("stretch", ColumnType::FLOAT64);
+        _columnar_writer->add_column("allocated_resources", ColumnType::INTERVALS);
+        _columnar_writer->add_column("consumed_energy", ColumnType::FLOAT64);
+        _columnar_writer->add_column("metadata", ColumnType::STRING);
+    }
 
     // Prepare for schedule output file
     for (int i = 0; i < static_cast<int>(context->machines.nb_machines()); ++i)
@@ -1003,6 +2032,21 @@ void JobsTracer::initialize(BatsimContext *context,
     }
 }
 
+/**
+ * @brief Returns the string representation of a quantile of a sketch
+ * @param[in] sketch The sketch
+ * @param[in] q The quantile, in [0,1]
+ * @return The estimated quantile, or an empty string if the sketch is empty
+ */
+static std::string quantile_to_string(const QuantileSketch & sketch, double q)
+{
+    if (sketch.count() == 0)
+    {
+        return "";
+    }
+    return to_string(sketch.quantile(q));
+}
+
 void JobsTracer::finalize()
 {
     // Finalize jobs output file
@@ -1056,6 +2100,14 @@ void JobsTracer::finalize()
     output_map["max_turnaround_time"] = to_string(static_cast<double>(_max_turnaround_time));
     output_map["max_slowdown"] = to_string(static_cast<double>(_max_slowdown));
 
+    const std::vector<std::pair<std::string, double> > percentiles = {{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}};
+    for (const auto & percentile : percentiles)
+    {
+        output_map[percentile.first + "_waiting_time"] = quantile_to_string(_waiting_time_sketch, percentile.second);
+        output_map[percentile.first + "_turnaround_time"] = quantile_to_string(_turnaround_time_sketch, percentile.second);
+        output_map[percentile.first + "_slowdown"] = quantile_to_string(_slowdown_sketch, percentile.second);
+    }
+
     output_map["nb_computing_machines"] = to_string(_context->machines.nb_machines());
 
     XBT_INFO("jobs=%d, finished=%d, success=%d, killed=%d, success_rate=%lf",
@@ -1065,6 +2117,12 @@ void JobsTracer::finalize()
              static_cast<double>(_makespan), static_cast<double>(seconds_used_by_scheduler),
              static_cast<double>(mean_waiting_time), static_cast<double>(mean_turnaround_time), mean_slowdown,
              static_cast<double>(_max_waiting_time), static_cast<double>(_max_turnaround_time), static_cast<double>(_max_slowdown));
+    XBT_INFO("p50_waiting_time=%lf, p90_waiting_time=%lf, p99_waiting_time=%lf, "
+             "p50_turnaround_time=%lf, p90_turnaround_time=%lf, p99_turnaround_time=%lf, "
+             "p50_slowdown=%lf, p90_slowdown=%lf, p99_slowdown=%lf",
+             _waiting_time_sketch.quantile(0.5), _waiting_time_sketch.quantile(0.9), _waiting_time_sketch.quantile(0.99),
+             _turnaround_time_sketch.quantile(0.5), _turnaround_time_sketch.quantile(0.9), _turnaround_time_sketch.quantile(0.99),
+             _slowdown_sketch.quantile(0.5), _slowdown_sketch.quantile(0.9), _slowdown_sketch.quantile(0.99));
     XBT_INFO("mean_machines_running=%lf, max_machines_running=%lf",
              static_cast<double>(mean_time_running), static_cast<double>(max_time_running));
 
@@ -1149,6 +2207,10 @@ void JobsTracer::write_job(const JobPtr job)
             _sum_turnaround_time += turnaround_time;
             _sum_slowdown += slowdown;
 
+            _waiting_time_sketch.add(static_cast<double>(waiting_time));
+            _turnaround_time_sketch.add(static_cast<double>(turnaround_time));
+            _slowdown_sketch.add(static_cast<double>(slowdown));
+
             if (completion_time > _makespan)
             {
                 _makespan = completion_time;
@@ -1181,42 +2243,99 @@ void JobsTracer::write_job(const JobPtr job)
         xbt_die("Job %s did not complete", job->id.job_name().c_str());
     }
 
-    // Set all values to be written
-    _job_map["job_id"] = job->id.job_name();
-    _job_map["workload_name"] = job->workload->name;
-    _job_map["profile"] = (job->profile)->name;
-    _job_map["submission_time"] = to_string(static_cast<double>(job->submission_time));
-    _job_map["requested_number_of_resources"] = to_string(job->requested_nb_res);
-    _job_map["requested_time"] = to_string(static_cast<double>(job->walltime));
-    _job_map["success"] = to_string(success);
-    _job_map["final_state"] = job_state_to_string(job->state);
-    _job_map["starting_time"] = rejected ? "" : to_string(static_cast<double>(job->starting_time));
-    _job_map["execution_time"] = rejected ? "" : to_string(static_cast<double>(job->runtime));
-    _job_map["finish_time"] = rejected ? "" : to_string(static_cast<double>(job->starting_time + job->runtime));
-    _job_map["waiting_time"] = rejected ? "" : to_string(static_cast<double>(job->starting_time - job->submission_time));
-    _job_map["turnaround_time"] = rejected ? "" : to_string(static_cast<double>(job->starting_time + job->runtime - job->submission_time));
-    _job_map["stretch"] = rejected ? "" : to_string(static_cast<double>((job->starting_time + job->runtime - job->submission_time) / job->runtime));
-    _job_map["consumed_energy"] = rejected ? "" : to_string(job->consumed_energy);
-    _job_map["allocated_resources"] = job->allocation.to_string_hyphen(" ");
-    _job_map["metadata"] = '"' + job->metadata + '"';
-    // And then write them
-    for (string & mit : _job_keys)
-    {
-        _row_content.push_back(_job_map[mit]);
-    }
-    _wbuf->append_text((boost::algorithm::join(_row_content, ",") + "\n").c_str());
-    _row_content.clear();
+    // Write the row, column by column (in the header order). Time columns are empty for rejected jobs
+    WriteBuffer * wbuf = _output->begin_row(simgrid::s4u::Engine::get_clock());
+    auto append_string_column = [wbuf](const std::string & value)
+    {
+        wbuf->append_text(value.c_str(), value.size());
+        wbuf->append_char(',');
+    };
+    auto append_time_column = [wbuf, rejected](long double value)
+    {
+        if (!rejected)
+        {
+            wbuf->append_fixed(static_cast<double>(value));
+        }
+        wbuf->append_char(',');
+    };
+
+    append_string_column(job->id.job_name());
+    append_string_column(job->workload->name);
+    append_string_column(job->profile->name);
+    wbuf->append_fixed(static_cast<double>(job->submission_time));
+    wbuf->append_char(',');
+    wbuf->append_int(job->requested_nb_res);
+    wbuf->append_char(',');
+    wbuf->append_fixed(static_cast<double>(job->walltime));
+    wbuf->append_char(',');
+    wbuf->append_int(success);
+    wbuf->append_char(',');
+    wbuf->append_text(job_state_to_cstring(job->state));
+    wbuf->append_char(',');
+    append_time_column(job->starting_time);
+    append_time_column(job->runtime);
+    append_time_column(job->starting_time + job->runtime);
+    append_time_column(job->starting_time - job->submission_time);
+    append_time_column(job->starting_time + job->runtime - job->submission_time);
+    append_time_column((job->starting_time + job->runtime - job->submission_time) / job->runtime);
+    append_interval_set_hyphen(wbuf, job->allocation);
+    wbuf->append_char(',');
+    if (!rejected)
+    {
+        wbuf->append_fixed(job->consumed_energy);
+    }
+    wbuf->append_char(',');
+    wbuf->append_char('"');
+    wbuf->append_text(job->metadata.c_str(), job->metadata.size());
+    wbuf->append_text("\"\n", 2);
+
+    if (_columnar_writer != nullptr)
+    {
+        write_columnar_job(job, success, rejected);
+    }
+}
+
+void JobsTracer::write_columnar_job(const JobPtr & job, int success, bool rejected)
+{
+    // Columns are set in the order in which they have been added. Missing times of rejected jobs are NaN
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+    int column = 0;
+
+    _columnar_writer->append_string(column++, job->id.job_name());
+    _columnar_writer->append_string(column++, job->workload->name);
+    _columnar_writer->append_string(column++, job->profile->name);
+    _columnar_writer->append_float64(column++, static_cast<double>(job->submission_time));
+    _columnar_writer->append_int32(column++, static_cast<int32_t>(job->requested_nb_res));
+    _columnar_writer->append_float64(column++, static_cast<double>(job->walltime));
+    _columnar_writer->append_int32(column++, success);
+    _columnar_writer->append_dict8(column++, static_cast<uint8_t>(job->state));
+    _columnar_writer->append_float64(column++, rejected ? missing : static_cast<double>(job->starting_time));
+    _columnar_writer->append_float64(column++, rejected ? missing : static_cast<double>(job->runtime));
+    _columnar_writer->append_float64(column++, rejected ? missing : static_cast<double>(job->starting_time + job->runtime));
+    _columnar_writer->append_float64(column++, rejected ? missing : static_cast<double>(job->starting_time - job->submission_time));
+    _columnar_writer->append_float64(column++, rejected ? missing : static_cast<double>(job->starting_time + job->runtime - job->submission_time));
+    _columnar_writer->append_float64(column++, rejected ? missing : static_cast<double>((job->starting_time + job->runtime - job->submission_time) / job->runtime));
+    _columnar_writer->append_intervals(column++, job->allocation);
+    _columnar_writer->append_float64(column++, rejected ? missing : static_cast<double>(job->consumed_energy));
+    _columnar_writer->append_string(column++, job->metadata);
+    _columnar_writer->end_row();
 }
 
 void JobsTracer::flush()
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
-    _wbuf->flush_buffer();
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
+    _output->flush();
 }
 
 void JobsTracer::close_buffer()
 {
-    xbt_assert(_wbuf != nullptr, "wrong call: _wbuf is null");
-    delete _wbuf;
-    _wbuf = nullptr;
+    xbt_assert(_output != nullptr, "wrong call: _output is null");
+    delete _output;
+    _output = nullptr;
+
+    if (_columnar_writer != nullptr)
+    {
+        delete _columnar_writer;
+        _columnar_writer = nullptr;
+    }
 }
@@ -13,10 +13,16 @@
 #include <fstream>
 #include <map>
 #include <memory>
+#include <unordered_set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 #include "pointers.hpp"
 #include "machines.hpp"
 #include "jobs.hpp"
+#include "quantile_sketch.hpp"
 
 struct BatsimContext;
 struct Job;
@@ -33,8 +39,52 @@ void prepare_batsim_outputs(BatsimContext * context);
  */
 void finalize_batsim_outputs(BatsimContext * context);
 
+/**
+ * @brief The compression algorithms of output files
+ */
+enum class OutputCompression
+{
+    NONE    //!< Files are not compressed
+    ,GZIP   //!< Files are compressed with gzip (.gz suffix)
+    ,ZSTD   //!< Files are compressed with zstd (.zst suffix)
+};
+
+/**
+ * @brief Returns the OutputCompression corresponding to a string
+ * @param[in] str The string ("none", "gzip" or "zstd")
+ * @return The OutputCompression corresponding to str. Throws an exception if str is invalid.
+ */
+OutputCompression output_compression_from_string(const std::string & str);
+
+/**
+ * @brief Returns the OutputCompression that corresponds to the suffix of a filename
+ * @param[in] filename The filename
+ * @return OutputCompression::GZIP if filename ends with ".gz", OutputCompression::ZSTD if it ends with ".zst", OutputCompression::NONE otherwise
+ */
+OutputCompression output_compression_from_filename(const std::string & filename);
+
+/**
+ * @brief Returns the filename suffix of an OutputCompression
+ * @param[in] compression The OutputCompression
+ * @return The filename suffix of compression (empty for OutputCompression::NONE)
+ */
+std::string output_compression_suffix(OutputCompression compression);
+
+/**
+ * @brief Returns whether Batsim has been built with the support of an OutputCompression
+ * @param[in] compression The OutputCompression
+ * @return Whether compression is supported
+ */
+bool output_compression_is_supported(OutputCompression compression);
+
+class StreamCompressor;
+
 /**
  * @brief Buffered-write output file
+ * @details In asynchronous mode, full buffers are handed over to a writer thread which writes them into the file
+ *          while the simulation thread fills another buffer. At most nb_async_buffers buffers exist at the same time.
+ *          Files whose name ends with ".gz" or ".zst" are compressed on the fly. Such WriteBuffers are always
+ *          asynchronous, so that the compression is done by the writer thread.
  */
 class WriteBuffer
 {
@@ -43,9 +93,11 @@ public:
      * @brief Builds a WriteBuffer
      * @param[in] filename The file that will be written
      * @param[in] buffer_size The size of the buffer (in bytes).
+     * @param[in] asynchronous Whether the buffers should be written into the file by a writer thread. Ignored (forced to true) if the file is compressed.
      */
     explicit WriteBuffer(const std::string & filename,
-                         size_t buffer_size = 64*1024);
+                         size_t buffer_size = 64*1024,
+                         bool asynchronous = WriteBuffer::asynchronous_by_default());
 
     /**
      * @brief WriteBuffers cannot be copied.
@@ -55,7 +107,7 @@ public:
 
     /**
      * @brief Destructor
-     * @details This method flushes the buffer if it is not empty, destroys the buffer and closes the file.
+     * @details This method flushes the buffer if it is not empty, waits for the writer thread to write everything, ends the compressed stream if any, destroys the buffers and closes the file.
      */
     ~WriteBuffer();
 
@@ -65,16 +117,347 @@ public:
      */
     void append_text(const char * text);
 
+    /**
+     * @brief Appends a text whose length is known at the end of the buffer. If the buffer is full, it is automatically flushed into the disk.
+     * @param[in] text The text to append (does not need to be null-terminated)
+     * @param[in] text_length The length of the text (in bytes)
+     */
+    void append_text(const char * text, size_t text_length);
+
+    /**
+     * @brief Appends a character at the end of the buffer
+     * @param[in] c The character to append
+     */
+    void append_char(char c);
+
+    /**
+     * @brief Appends the decimal representation of an integer at the end of the buffer, without allocating memory
+     * @param[in] value The integer to append
+     */
+    void append_int(long long value);
+
+    /**
+     * @brief Appends the fixed-point representation of a number at the end of the buffer, without allocating memory
+     * @details The text is the same as the one of printf's "%.<precision>Lf" (std::to_string for precision 6).
+     * @param[in] value The number to append
+     * @param[in] precision The number of decimals
+     */
+    void append_fixed(long double value, int precision = 6);
+
+    /**
+     * @brief Appends the shortest of the fixed-point and scientific representations of a number at the end of the buffer, without allocating memory
+     * @details The text is the same as the one of printf's "%.<precision>Lg".
+     * @param[in] value The number to append
+     * @param[in] precision The number of significant digits
+     */
+    void append_general(long double value, int precision = 6);
+
     /**
      * @brief Write the current content of the buffer into the file
+     * @details In asynchronous mode, the buffer is handed over to the writer thread and this method returns without waiting for the write.
      */
     void flush_buffer();
 
+    /**
+     * @brief Sets whether the WriteBuffers created afterwards are asynchronous by default
+     * @param[in] asynchronous Whether the WriteBuffers created afterwards should be asynchronous by default
+     */
+    static void set_asynchronous_by_default(bool asynchronous);
+
+    /**
+     * @brief Returns whether WriteBuffers are asynchronous by default
+     * @return Whether WriteBuffers are asynchronous by default
+     */
+    static bool asynchronous_by_default();
+
+    /**
+     * @brief Returns the compression algorithm used to write the file
+     * @return The compression algorithm used to write the file
+     */
+    OutputCompression compression() const;
+
+    /**
+     * @brief Returns the number of bytes that have been appended so far (before compression)
+     * @return The number of bytes that have been appended so far
+     */
+    uint64_t nb_appended_bytes() const;
+
+    static constexpr size_t nb_async_buffers = 2; //!< The maximum number of buffers of an asynchronous WriteBuffer
+
+private:
+    /**
+     * @brief Writes data into the file, compressing it if needed
+     * @details This is called by the writer thread in asynchronous mode, and by the simulation thread otherwise.
+     * @param[in] data The data to write
+     * @param[in] size The size of the data (in bytes)
+     */
+    void write_into_file(const char * data, size_t size);
+
+    /**
+     * @brief Hands the current buffer over to the writer thread, then gets a free buffer
+     */
+    void hand_buffer_over();
+
+    /**
+     * @brief The writer thread main loop: writes the full buffers into the file until the WriteBuffer is destroyed
+     */
+    void writer_thread_loop();
+
 private:
     std::ofstream f;            //!< The file stream on which the buffer is outputted
     const size_t buffer_size;   //!< The buffer maximum size
     char * buffer = nullptr;    //!< The buffer
     size_t buffer_pos = 0;         //!< The current position of the buffer (previous positions are already written)
+    uint64_t _nb_flushed_bytes = 0; //!< The number of bytes that have left the buffer (written or handed over to the writer thread)
+
+    const OutputCompression _compression; //!< The compression algorithm used to write the file
+    std::unique_ptr<StreamCompressor> _compressor; //!< The stream compressor (only if the file is compressed)
+    const bool _asynchronous;   //!< Whether buffers are written into the file by the writer thread
+    std::thread _writer_thread; //!< The writer thread (only in asynchronous mode)
+    std::mutex _mutex;          //!< Protects the buffer queues
+    std::condition_variable _full_buffer_available; //!< Notified when a full buffer is handed over to the writer thread
+    std::condition_variable _free_buffer_available; //!< Notified when the writer thread has written a buffer
+    std::deque<std::pair<char *, size_t>> _full_buffers; //!< The buffers waiting to be written, with their size
+    std::vector<char *> _free_buffers; //!< The buffers that can be filled
+    size_t _nb_allocated_buffers = 0; //!< The number of buffers that have been allocated
+    bool _writer_should_stop = false; //!< Whether the writer thread should stop once all full buffers are written
+
+    static bool _asynchronous_by_default; //!< Whether WriteBuffers are asynchronous by default
+};
+
+/**
+ * @brief Writes the rows of a CSV output file, possibly split into numbered chunks
+ * @details Without chunk limits (the default), the rows are written into a single file, exactly as with a WriteBuffer.
+ *          Otherwise, the rows are written into chunks named after the file (out_jobs.00000.csv.gz, out_jobs.00001.csv.gz...
+ *          for out_jobs.csv.gz), each of them starting with the header. A new chunk is started before a row that is
+ *          in another chunk period than the first row of the current chunk, or once the current chunk has reached the
+ *          chunk size. An index file (out_jobs.index.csv) lists the chunks with the dates of their first and last rows.
+ *          Rows must be written in non-decreasing date order.
+ */
+class ChunkedOutput
+{
+public:
+    /**
+     * @brief Builds a ChunkedOutput and writes the header of its first chunk
+     * @param[in] filename The file that will be written if there is no chunk limit (the chunk filenames are derived from it)
+     * @param[in] header The header of the file, written at the beginning of every chunk
+     */
+    ChunkedOutput(const std::string & filename, const std::string & header);
+
+    /**
+     * @brief ChunkedOutputs cannot be copied.
+     * @param[in] other Another instance
+     */
+    ChunkedOutput(const ChunkedOutput & other) = delete;
+
+    /**
+     * @brief Destructor. Closes the current chunk and completes the index file
+     */
+    ~ChunkedOutput();
+
+    /**
+     * @brief Starts a row, after having started a new chunk if needed
+     * @param[in] date The date of the row
+     * @return The buffer into which the row must be written
+     */
+    WriteBuffer * begin_row(double date);
+
+    /**
+     * @brief Writes the content of the buffer of the current chunk into its file
+     */
+    void flush();
+
+    /**
+     * @brief Sets the chunk limits of the ChunkedOutputs created afterwards
+     * @param[in] chunk_size If strictly positive, the size (in bytes, before compression) from which a chunk is ended
+     * @param[in] chunk_period If strictly positive, the duration (in simulated seconds) covered by each chunk
+     */
+    static void set_chunk_limits_by_default(uint64_t chunk_size, double chunk_period);
+
+    /**
+     * @brief Computes the name of a chunk file
+     * @param[in] filename The name of the file that would be written if there was no chunk limit
+     * @param[in] chunk The chunk number
+     * @return The name of the chunk file
+     */
+    static std::string chunk_filename(const std::string & filename, int chunk);
+
+    /**
+     * @brief Computes the name of the index file of chunks
+     * @param[in] filename The name of the file that would be written if there was no chunk limit
+     * @return The name of the index file
+     */
+    static std::string index_filename(const std::string & filename);
+
+private:
+    /**
+     * @brief Opens the next chunk and writes its header
+     */
+    void open_chunk();
+
+    /**
+     * @brief Closes the current chunk and writes its row in the index file
+     */
+    void close_chunk();
+
+private:
+    const std::string _filename;        //!< The name of the file that would be written if there was no chunk limit
+    const std::string _header;          //!< The header written at the beginning of every chunk
+    const uint64_t _chunk_size;         //!< The size from which a chunk is ended (0 if unlimited)
+    const double _chunk_period;         //!< The duration covered by each chunk (0 if unlimited)
+    WriteBuffer * _wbuf = nullptr;      //!< The buffer of the current chunk
+    WriteBuffer * _index_wbuf = nullptr; //!< The buffer of the index file (only if there is a chunk limit)
+    int _nb_chunks = 0;                 //!< The number of chunks that have been opened
+    uint64_t _nb_chunk_rows = 0;        //!< The number of rows of the current chunk
+    double _chunk_first_date = 0;       //!< The date of the first row of the current chunk
+    double _chunk_last_date = 0;        //!< The date of the last row of the current chunk
+
+    static uint64_t _chunk_size_by_default;  //!< The chunk size of the ChunkedOutputs created afterwards
+    static double _chunk_period_by_default;  //!< The chunk period of the ChunkedOutputs created afterwards
+};
+
+/**
+ * @brief Writes rows of typed columns into a binary columnar file
+ * @details Rows are buffered column by column and written in row groups of bounded size.
+ *          The file format is described in the documentation of the jobs output (docs/output-jobs.rst).
+ *          All columns must be added before the first row, and each row must set every column exactly once.
+ */
+class ColumnarWriter
+{
+public:
+    /**
+     * @brief The types of the columns
+     */
+    enum class ColumnType : uint8_t
+    {
+        FLOAT64 = 1     //!< 64-bit IEEE 754 floating-point numbers. Missing values are NaN
+        ,INT32 = 2      //!< 32-bit signed integers
+        ,STRING = 3     //!< Variable-length strings
+        ,DICT8 = 4      //!< 8-bit codes whose meaning is given by a dictionary of strings
+        ,INTERVALS = 5  //!< IntervalSets, as variable-length lists of closed intervals
+    };
+
+    /**
+     * @brief Builds a ColumnarWriter
+     * @param[in] filename The file that will be written (it can be compressed, see WriteBuffer)
+     * @param[in] row_group_size The maximum number of rows of a row group
+     */
+    explicit ColumnarWriter(const std::string & filename, uint32_t row_group_size = 65536);
+
+    /**
+     * @brief ColumnarWriters cannot be copied.
+     * @param[in] other Another instance
+     */
+    ColumnarWriter(const ColumnarWriter & other) = delete;
+
+    /**
+     * @brief Destructor. Writes the last row group and the end of the file
+     */
+    ~ColumnarWriter();
+
+    /**
+     * @brief Adds a column. Must be called before the first row is written
+     * @param[in] name The column name
+     * @param[in] type The column type
+     * @param[in] dictionary The strings associated with the codes of a DICT8 column (unused for other types)
+     * @return The index of the column
+     */
+    int add_column(const std::string & name, ColumnType type, const std::vector<std::string> & dictionary = {});
+
+    /**
+     * @brief Sets the value of a FLOAT64 column in the current row
+     * @param[in] column The column index
+     * @param[in] value The value
+     */
+    void append_float64(int column, double value);
+
+    /**
+     * @brief Sets the value of an INT32 column in the current row
+     * @param[in] column The column index
+     * @param[in] value The value
+     */
+    void append_int32(int column, int32_t value);
+
+    /**
+     * @brief Sets the value of a STRING column in the current row
+     * @param[in] column The column index
+     * @param[in] value The value
+     */
+    void append_string(int column, const std::string & value);
+
+    /**
+     * @brief Sets the value of a DICT8 column in the current row
+     * @param[in] column The column index
+     * @param[in] code The code of the value in the column dictionary
+     */
+    void append_dict8(int column, uint8_t code);
+
+    /**
+     * @brief Sets the value of an INTERVALS column in the current row
+     * @param[in] column The column index
+     * @param[in] set The value
+     */
+    void append_intervals(int column, const IntervalSet & set);
+
+    /**
+     * @brief Ends the current row. The row group is written into the file if it is full
+     */
+    void end_row();
+
+    /**
+     * @brief Writes the current row group into the file (if it is not empty)
+     */
+    void flush_row_group();
+
+    /**
+     * @brief Returns the number of rows that have been ended
+     * @return The number of rows that have been ended
+     */
+    uint64_t nb_rows() const;
+
+    static constexpr char magic[9] = "BATCOLv1"; //!< The 8 first bytes of the files
+
+private:
+    /**
+     * @brief A column and the values of the current row group
+     */
+    struct Column
+    {
+        std::string name;                     //!< The column name
+        ColumnType type;                      //!< The column type
+        std::vector<std::string> dictionary;  //!< The dictionary of a DICT8 column
+        std::vector<char> data;               //!< The values of the current row group
+        std::vector<uint32_t> offsets;        //!< Where the values start in data (STRING: in bytes, INTERVALS: in intervals), for variable-length columns
+        uint32_t nb_values = 0;               //!< The number of values in the current row group
+    };
+
+    /**
+     * @brief Returns a column into which a value of the current row can be set
+     * @param[in] column The column index
+     * @param[in] type The type of the value
+     * @return The column
+     */
+    Column & column_to_set(int column, ColumnType type);
+
+    /**
+     * @brief Appends raw bytes into the WriteBuffer
+     * @param[in] data The bytes
+     * @param[in] size The number of bytes
+     */
+    void write_bytes(const void * data, size_t size);
+
+    /**
+     * @brief Writes the file header (magic and columns description)
+     */
+    void write_header();
+
+private:
+    WriteBuffer * _wbuf = nullptr;          //!< The buffer used to handle the output file
+    std::vector<Column> _columns;           //!< The columns
+    const uint32_t _row_group_size;         //!< The maximum number of rows of a row group
+    uint32_t _nb_rows_in_group = 0;         //!< The number of rows in the current row group
+    uint64_t _nb_rows = 0;                  //!< The number of rows that have been ended
+    bool _header_written = false;           //!< Whether the file header has been written
 };
 
 
@@ -165,6 +548,19 @@ public:
      */
     void register_new_job(const JobIdentifier & job_id);
 
+    /**
+     * @brief Forgets a job that has left every machine, so that the memory of the tracer does not grow with the number of jobs
+     * @details The job must not be set on machines afterwards. Nothing is done if the job has not been registered.
+     * @param[in] job_id The job identifier
+     */
+    void unregister_job(const JobIdentifier & job_id);
+
+    /**
+     * @brief Returns the number of jobs that are currently registered
+     * @return The number of jobs that are currently registered
+     */
+    size_t nb_registered_jobs() const;
+
     /**
      * @brief Sets a machine in the idle state
      * @param[in] machine_id The unique machine number
@@ -243,7 +639,8 @@ private:
 
     WriteBuffer * _wbuf = nullptr;  //!< The buffer class used to handle the output file
 
-    std::map<JobIdentifier, std::string> _jobs; //!< Maps jobs to their Pajé representation
+    std::unordered_set<JobIdentifier, JobIdentifierHasher> _jobs; //!< The jobs that have been registered and not unregistered yet. Their Pajé representation is jobPrefix followed by their identifier
+    static constexpr int line_buffer_size = 256; //!< The size of the stack buffers used to format lines
     std::vector<std::string> _colors; //!< Strings associated with colors, used for the jobs
 
     PajeTracerState state = UNINITIALIZED; //!< The state of the PajeTracer
@@ -251,6 +648,104 @@ private:
 };
 
 
+/**
+ * @brief Traces the schedule into a compact binary file, as an alternative to the Pajé trace
+ * @details One row is written per job start, end or kill, with the allocation as an IntervalSet, instead of one Pajé line
+ *          per machine. The file is a columnar file (see ColumnarWriter) whose columns are time, event, name and machines.
+ *          tools/batsim_binary_schedule_to_paje.py converts it into a Pajé trace.
+ */
+class BinaryScheduleTracer
+{
+public:
+    /**
+     * @brief The events of the binary schedule trace. Their codes are stored in the event column
+     */
+    enum class Event : uint8_t
+    {
+        MACHINE         //!< Declares a machine (name: the machine name, machines: the machine id)
+        ,JOB_START      //!< A job starts (name: the job identifier, machines: its allocation)
+        ,JOB_END        //!< A job ends (name: the job identifier, machines: its allocation)
+        ,JOB_KILL       //!< A job is killed, it will end at the same time (name: the job identifier, machines: its allocation)
+        ,END            //!< The end of the simulation
+    };
+
+    /**
+     * @brief Constructs a BinaryScheduleTracer
+     */
+    BinaryScheduleTracer() = default;
+
+    /**
+     * @brief BinaryScheduleTracer cannot be copied.
+     * @param[in] other Another instance
+     */
+    BinaryScheduleTracer(const BinaryScheduleTracer & other) = delete;
+
+    /**
+     * @brief Destroys a BinaryScheduleTracer
+     */
+    ~BinaryScheduleTracer();
+
+    /**
+     * @brief Initializes the tracer: opens the file and declares the machines
+     * @param[in] context The BatsimContext
+     * @param[in] filename The name of the output file
+     * @param[in] time The beginning time
+     */
+    void initialize(const BatsimContext * context, const std::string & filename, double time);
+
+    /**
+     * @brief Finalizes the tracer: writes the end of the simulation and closes the file
+     * @param[in] time The simulation time at which the finalization is done
+     */
+    void finalize(double time);
+
+    /**
+     * @brief Declares a machine in the trace. Called by initialize for each machine of the context
+     * @param[in] machine_id The machine id
+     * @param[in] machine_name The machine name
+     * @param[in] time The simulation time at which the machine is declared
+     */
+    void add_machine(int machine_id, const std::string & machine_name, double time);
+
+    /**
+     * @brief Adds a job start in the trace
+     * @param[in] job_id The job identifier
+     * @param[in] machines The machines allocated to the job
+     * @param[in] time The simulation time at which the job starts
+     */
+    void add_job_start(const JobIdentifier & job_id, const IntervalSet & machines, double time);
+
+    /**
+     * @brief Adds a job end in the trace
+     * @param[in] job_id The job identifier
+     * @param[in] machines The machines allocated to the job
+     * @param[in] time The simulation time at which the job ends
+     */
+    void add_job_end(const JobIdentifier & job_id, const IntervalSet & machines, double time);
+
+    /**
+     * @brief Adds a job kill in the trace
+     * @param[in] job_id The job identifier
+     * @param[in] machines The machines allocated to the job
+     * @param[in] time The simulation time at which the job is killed
+     */
+    void add_job_kill(const JobIdentifier & job_id, const IntervalSet & machines, double time);
+
+private:
+    /**
+     * @brief Writes an event (a row) into the trace
+     * @param[in] time The simulation time of the event
+     * @param[in] event The event
+     * @param[in] name The name associated with the event
+     * @param[in] machines The machines associated with the event
+     */
+    void write_event(double time, Event event, const std::string & name, const IntervalSet & machines);
+
+private:
+    ColumnarWriter * _writer = nullptr; //!< The writer of the output file
+};
+
+
 /**
  * @brief Traces how power states are changed over time
  */
@@ -260,7 +755,7 @@ public:
     /**
      * @brief Constructs a PStateChangeTracer
      */
-    PStateChangeTracer();
+    PStateChangeTracer() = default;
 
     /**
      * @brief PStateChangeTracer cannot be copied.
@@ -280,6 +775,12 @@ public:
      */
     void setFilename(const std::string & filename);
 
+    /**
+     * @brief Sets whether the power state changes are coalesced per date. Must be called before the first add_pstate_change call
+     * @param[in] coalesce If true, at most one line is written per date and power state: the machines that are in this power state after all the changes at this date
+     */
+    void set_coalesce(bool coalesce);
+
     /**
      * @brief Adds a power state change in the tracer
      * @param time The time at which the change occurs
@@ -299,8 +800,24 @@ public:
     void close_buffer();
 
 private:
-    WriteBuffer * _wbuf = nullptr; //!< The buffer used to handle the output file
-    char * _temporary_buffer = nullptr; //!< The buffer used to generate text
+    /**
+     * @brief Writes a line into the output file
+     * @param[in] time The time at which the change occurs
+     * @param[in] machines The machines whose state has been changed
+     * @param[in] pstate_after The power state the machine will be in after the given time
+     */
+    void write_line(double time, const IntervalSet & machines, int pstate_after);
+
+    /**
+     * @brief Writes the pending lines (coalesce mode) into the output file
+     */
+    void write_pending_lines();
+
+private:
+    ChunkedOutput * _output = nullptr; //!< The output file (possibly split into chunks)
+    bool _coalesce = false; //!< Whether at most one line is written per date and power state
+    double _pending_time = 0; //!< The time of the pending lines (coalesce mode)
+    std::map<int, IntervalSet> _pending_machines; //!< The machines of the pending lines, per power state (coalesce mode)
 };
 
 /**
@@ -338,6 +855,12 @@ public:
      */
     void set_filename(const std::string & filename);
 
+    /**
+     * @brief Sets whether the entries are coalesced per date. Must be called before the first entry is added
+     * @param[in] coalesce If true, at most one line is written per date: the last entry at this date
+     */
+    void set_coalesce(bool coalesce);
+
     /**
      * @brief Adds a job start in the tracer
      * @param[in] date The date at which the job has been started
@@ -379,12 +902,28 @@ private:
      */
     long double add_entry(double date, char event_type);
 
-    long double _last_entry_date = 0; //!< The date of the last entry
-    long double _last_entry_energy = 0; //!< The energy of the last entry
+    /**
+     * @brief Writes a line into the output file
+     * @param[in] date The date at which the event has occured
+     * @param[in] energy The energy consumed by the computing machines from simulation's start to date
+     * @param[in] event_type The type of the event which occured
+     * @param[in] wattmin The sum of the minimum power of the computing machines at date
+     */
+    void write_line(double date, long double energy, char event_type, long double wattmin);
+
+    long double _last_entry_date = 0; //!< The date of the last written entry
+    long double _last_entry_energy = 0; //!< The energy of the last written entry
+
+    bool _coalesce = false; //!< Whether at most one line is written per date
+    bool _has_pending_entry = false; //!< Whether an entry is waiting to be written (coalesce mode)
+    double _pending_date = 0; //!< The date of the pending entry
+    long double _pending_energy = 0; //!< The energy of the pending entry
+    char _pending_event_type = 0; //!< The event type of the pending entry
+    long double _pending_wattmin = 0; //!< The wattmin of the pending entry
 
 private:
     BatsimContext * _context = nullptr; //!< The Batsim context
-    WriteBuffer * _wbuf = nullptr; //!< The buffer used to handle the output file
+    ChunkedOutput * _output = nullptr; //!< The output file (possibly split into chunks)
 };
 
 /**
@@ -421,8 +960,16 @@ public:
      */
     void set_filename(const std::string & filename);
 
+    /**
+     * @brief Sets how the machine states are aggregated over time. Must be called before the first write_machine_states call
+     * @param[in] coalesce If true, at most one line is written per date: the one corresponding to the state after all updates at this date
+     * @param[in] period If strictly positive, the machine states are sampled every period seconds (the coalesce parameter is then ignored)
+     */
+    void set_aggregation(bool coalesce, double period);
+
     /**
      * @brief Writes a line in the output file, corresponding to the current state, at the given date
+     * @details Depending on the aggregation, the line may be written later (once the date has changed), merged with other lines or sampled.
      * @param[in] date The current date
      */
     void write_machine_states(double date);
@@ -433,13 +980,32 @@ public:
     void flush();
 
     /**
-     * @brief Closes the output buffer
+     * @brief Closes the output buffer. The pending line, if any, is written beforehand
      */
     void close_buffer();
 
+private:
+    static constexpr int nb_traced_states = 5; //!< The number of machine states in a line
+
+    /**
+     * @brief Writes a line into the buffer
+     * @param[in] date The date of the line
+     * @param[in] numbers The number of machines in each traced state, in the header order
+     */
+    void write_line(double date, const int (&numbers)[nb_traced_states]);
+
 private:
     BatsimContext * _context = nullptr; //!< The Batsim context
-    WriteBuffer * _wbuf = nullptr; //!< The buffer used to handle the output file
+    ChunkedOutput * _output = nullptr; //!< The output file (possibly split into chunks)
+
+    bool _coalesce = false; //!< Whether at most one line is written per date
+    double _period = 0; //!< The sampling period (0 if the machine states are not sampled)
+    bool _has_pending_line = false; //!< Whether a line is waiting to be written (coalesce or sampling mode)
+    double _pending_date = 0; //!< The date of the pending line
+    int _pending_numbers[nb_traced_states] = {0}; //!< The numbers of machines of the pending line (the latest state)
+    double _first_sample_date = 0; //!< The date of the first sample (sampling mode)
+    double _next_sample_date = 0; //!< The date of the next sample (sampling mode)
+    long _nb_samples = 0; //!< The number of samples that have been written (sampling mode)
 };
 
 /**
@@ -469,10 +1035,12 @@ public:
      * @param[in] context The Batsim context
      * @param[in] jobs_filename The name of the jobs output file
      * @param[in] schedule_filename The name of the schedule output file
+     * @param[in] columnar_jobs_filename The name of the binary columnar jobs output file. Empty if it should not be written.
      */
     void initialize(BatsimContext * context,
                     const std::string & jobs_filename,
-                    const std::string & schedule_filename);
+                    const std::string & schedule_filename,
+                    const std::string & columnar_jobs_filename = "");
 
     /**
      * @brief Finalizes the tracer. Writes schedule output file
@@ -481,31 +1049,37 @@ public:
 
     /**
      * @brief Writes a line in the jobs output file and updates schedule metrics.
+     * @details The columns are written in the order of the file header, directly into the buffer.
      * @param[in] job The Job involved
      */
     void write_job(const JobPtr job);
 
     /**
      * @brief Flushes the pending writings to the jobs output file
+     * @details The binary columnar jobs output file is only written by row groups, it is not flushed by this method.
      */
     void flush();
 
     /**
-     * @brief Closes the jobs output buffer
+     * @brief Closes the jobs output buffer (and the binary columnar jobs output file, if any)
      */
     void close_buffer();
 
+private:
+    /**
+     * @brief Writes a row in the binary columnar jobs output file
+     * @param[in] job The Job involved
+     * @param[in] success Whether the job has completed successfully (1) or not (0)
+     * @param[in] rejected Whether the job has been rejected
+     */
+    void write_columnar_job(const JobPtr & job, int success, bool rejected);
 
 private:
     BatsimContext * _context = nullptr; //!< The Batsim context
-    WriteBuffer * _wbuf = nullptr; //!< The buffer used to handle the jobs output file
+    ChunkedOutput * _output = nullptr; //!< The jobs output file (possibly split into chunks)
+    ColumnarWriter * _columnar_writer = nullptr; //!< The writer of the binary columnar jobs output file (if enabled)
     std::string _schedule_filename; //!< The filename of the schedule output file
 
-    // Jobs-related
-    std::vector<std::string> _job_keys; //!< The list of keys in the map
-    std::map<std::string, std::string> _job_map; //!< The map holding info of the Job to write
-    std::vector<std::string> _row_content; //!< The vector containing string to write
-
     // Schedule-related
     int _nb_jobs = 0; //!< The number of jobs.
     int _nb_jobs_finished = 0; //!< The number of finished jobs.
@@ -519,5 +1093,8 @@ private:
     long double _max_waiting_time = 0; //!< The maximum waiting time observed.
     long double _max_turnaround_time = 0; //!< The maximum turnaround time observed.
     long double _max_slowdown = 0; //!< The maximum slowdown observed.
+    QuantileSketch _waiting_time_sketch; //!< Estimates the quantiles of the waiting time of jobs.
+    QuantileSketch _turnaround_time_sketch; //!< Estimates the quantiles of the turnaround time of jobs.
+    QuantileSketch _slowdown_sketch; //!< Estimates the quantiles of the slowdown of jobs.
     std::map<int, long double> _machines_utilization; //!< Counts the utilization time of each machine.
 };
@@ -131,6 +131,9 @@ std::string ip_message_type_to_string(IPMessageType type)
         case IPMessageType::EVENT_OCCURRED:
             s = "EVENT_OCCURRED";
             break;
+        case IPMessageType::TIMELINE_SUBMITTED:
+            s = "TIMELINE_SUBMITTED";
+            break;
     }
 
     return s;
@@ -142,6 +145,22 @@ void send_message(const char *destination_mailbox, IPMessageType type, void *dat
     send_message(str, type, data);
 }
 
+EventOccurredMessage::~EventOccurredMessage()
+{
+    for (const Event * event : occurred_events)
+    {
+        delete event;
+    }
+}
+
+TimelineSubmittedMessage::~TimelineSubmittedMessage()
+{
+    for (IPMessage * message : messages)
+    {
+        delete message;
+    }
+}
+
 IPMessage::~IPMessage()
 {
     // Do not remove the switch. If one adds a new IPMessageType but forgets to handle it in the
@@ -274,6 +293,11 @@ IPMessage::~IPMessage()
             auto * msg = static_cast<EventOccurredMessage *>(data);
             delete msg;
         } break;
+        case IPMessageType::TIMELINE_SUBMITTED:
+        {
+            auto * msg = static_cast<TimelineSubmittedMessage *>(data);
+            delete msg;
+        } break;
     }
 
     data = nullptr;
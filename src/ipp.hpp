@@ -21,6 +21,7 @@
 
 struct BatsimContext;
 struct ServerData;
+struct IPMessage;
 
 /**
  * @brief Stores the different types of inter-process messages
@@ -54,6 +55,7 @@ enum class IPMessageType
     ,TO_JOB_MSG                //!< Scheduler -> Server. The scheduler sends a message to a job.
     ,FROM_JOB_MSG              //!< Job -> Server. The job wants to send a message to the scheduler via the server.
     ,EVENT_OCCURRED            //!< Sumbitter -> Server. The event submitter tells the server that one or several events have occurred.
+    ,TIMELINE_SUBMITTED        //!< Timeline submitter -> Server. The timeline submitter tells the server everything that happens at a date (job submissions, event occurrences, submitter hellos and byes).
 };
 
 /**
@@ -277,8 +279,26 @@ struct FromJobMessage
  */
 struct EventOccurredMessage
 {
+    /**
+     * @brief Destroys an EventOccurredMessage, and the Events it owns
+     */
+    ~EventOccurredMessage();
+
     std::string submitter_name;          //!< The name of the submitter which submitted the events.
-    std::vector<const Event *> occurred_events; //!< The list of Event that occurred
+    std::vector<const Event *> occurred_events; //!< The list of Event that occurred (owned by the message)
+};
+
+/**
+ * @brief The content of the TIMELINE_SUBMITTED message
+ */
+struct TimelineSubmittedMessage
+{
+    /**
+     * @brief Destroys a TimelineSubmittedMessage, and the messages it owns
+     */
+    ~TimelineSubmittedMessage();
+
+    std::vector<IPMessage *> messages; //!< The SUBMITTER_HELLO, JOB_SUBMITTED, EVENT_OCCURRED and SUBMITTER_BYE messages, to handle in order (owned by the message)
 };
 
 /**
@@ -7,8 +7,8 @@
 
 #include <vector>
 #include <algorithm>
-#include <boost/bind.hpp>
 #include <memory>
+#include <queue>
 
 #include <simgrid/s4u.hpp>
 
@@ -19,149 +19,10 @@
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(job_submitter, "job_submitter"); //!< Logging
 
-Task* inc_child (Task *i)
-{
-  i->nb_parent_completed++;
-
-  return i;
-}
-
-Task* bottom_level_f (Task *child, Task *parent)
-{
-  child->depth = std::max( child->depth, (parent->depth)+1 );
-
-  return child;
-}
-
 using namespace std;
 
-static void submit_jobs_to_server(const vector<JobPtr> & jobs_to_submit, const std::string & submitter_name)
-{
-    if (!jobs_to_submit.empty())
-    {
-        JobSubmittedMessage * msg = new JobSubmittedMessage;
-        msg->submitter_name = submitter_name;
-        msg->jobs = jobs_to_submit;
-        send_message("server", IPMessageType::JOB_SUBMITTED, static_cast<void*>(msg));
-    }
-}
-
-void static_job_submitter_process(BatsimContext * context,
-                                  std::string workload_name)
-{
-    xbt_assert(context->workloads.exists(workload_name),
-               "Error: a static_job_submitter_process is in charge of workload '%s', "
-               "which does not exist", workload_name.c_str());
-
-    Workload * workload = context->workloads.at(workload_name);
-
-    string submitter_name = workload_name + "_submitter";
-
-    /*  ░░░░░░░░▄▄▄███░░░░░░░░░░░░░░░░░░░░
-        ░░░▄▄██████████░░░░░░░░░░░░░░░░░░░
-        ░███████████████░░░░░░░░░░░░░░░░░░
-        ░▀███████████████░░░░░▄▄▄░░░░░░░░░
-        ░░░███████████████▄███▀▀▀░░░░░░░░░
-        ░░░░███████████████▄▄░░░░░░░░░░░░░
-        ░░░░▄████████▀▀▄▄▄▄▄░▀░░░░░░░░░░░░
-        ▄███████▀█▄▀█▄░░█░▀▀▀░█░░▄▄░░░░░░░
-        ▀▀░░░██▄█▄░░▀█░░▄███████▄█▀░░░▄░░░
-        ░░░░░█░█▀▄▄▀▄▀░█▀▀▀█▀▄▄▀░░░░░░▄░▄█
-        ░░░░░█░█░░▀▀▄▄█▀░█▀▀░░█░░░░░░░▀██░
-        ░░░░░▀█▄░░░░░░░░░░░░░▄▀░░░░░░▄██░░
-        ░░░░░░▀█▄▄░░░░░░░░▄▄█░░░░░░▄▀░░█░░
-        ░░░░░░░░░▀███▀▀████▄██▄▄░░▄▀░░░░░░
-        ░░░░░░░░░░░█▄▀██▀██▀▄█▄░▀▀░░░░░░░░
-        ░░░░░░░░░░░██░▀█▄█░█▀░▀▄░░░░░░░░░░
-        ░░░░░░░░░░█░█▄░░▀█▄▄▄░░█░░░░░░░░░░
-        ░░░░░░░░░░█▀██▀▀▀▀░█▄░░░░░░░░░░░░░
-        ░░░░░░░░░░░░▀░░░░░░░░░░░▀░░░░░░░░░ */
-
-    SubmitterHelloMessage * hello_msg = new SubmitterHelloMessage;
-    hello_msg->submitter_name = submitter_name;
-    hello_msg->enable_callback_on_job_completion = false;
-    hello_msg->submitter_type = SubmitterType::JOB_SUBMITTER;
-
-    send_message("server", IPMessageType::SUBMITTER_HELLO, static_cast<void*>(hello_msg));
-
-    long double current_submission_date = static_cast<long double>(simgrid::s4u::Engine::get_clock());
-
-    // sort jobs by arrival date in a temporary vector
-    vector<JobPtr> jobs_to_submit_vector;
-    const auto & jobs = workload->jobs->jobs();
-    for (const auto & mit : jobs)
-    {
-        const auto job = mit.second;
-        jobs_to_submit_vector.push_back(job);
-    }
-    sort(jobs_to_submit_vector.begin(), jobs_to_submit_vector.end(), job_comparator_subtime_number);
-
-    // put jobs to submit into a list whose elements are dropped online (for smooth refcounting-based memory clean-up)
-    list<JobPtr> jobs_to_submit;
-    std::copy(jobs_to_submit_vector.begin(), jobs_to_submit_vector.end(), std::back_inserter(jobs_to_submit));
-    jobs_to_submit_vector.clear();
-
-    if (jobs_to_submit.size() > 0)
-    {
-        vector<JobPtr> jobs_to_send;
-        bool is_first_job = true;
-
-        for ( ; !jobs_to_submit.empty() ; jobs_to_submit.pop_front())
-        {
-            auto job = jobs_to_submit.front();
-            if (job->submission_time > current_submission_date)
-            {
-                // Next job submission time is after current time, send the message to the server for previous submitted jobs
-                submit_jobs_to_server(jobs_to_send, submitter_name);
-                jobs_to_send.clear();
-
-                // Now let's sleep until it's time to submit the current job
-                simgrid::s4u::this_actor::sleep_for(static_cast<double>(job->submission_time - current_submission_date));
-                current_submission_date = static_cast<long double>(simgrid::s4u::Engine::get_clock());
-            }
-            // Setting the mailbox
-            //job->completion_notification_mailbox = "SOME_MAILBOX";
-
-            // Populate the vector of job identifiers to submit
-            jobs_to_send.push_back(job);
-
-            // Let's put the metadata about the job into the data storage
-            if (context->redis_enabled)
-            {
-                string job_key = RedisStorage::job_key(job->id);
-                string profile_key = RedisStorage::profile_key(workload->name, job->profile->name);
-
-                context->storage.set(job_key, job->json_description);
-                if (context->submission_forward_profiles)
-                {
-                    context->storage.set(profile_key, job->profile->json_description);
-                }
-            }
-
-            if (is_first_job)
-            {
-                is_first_job = false;
-                if (context->energy_first_job_submission < 0)
-                {
-                    context->energy_first_job_submission = context->machines.total_consumed_energy(context);
-                }
-            }
-        }
-
-        // Send last vector of submitted jobs
-        submit_jobs_to_server(jobs_to_send, submitter_name);
-    }
-
-    SubmitterByeMessage * bye_msg = new SubmitterByeMessage;
-    bye_msg->is_workflow_submitter = false;
-    bye_msg->submitter_name = submitter_name;
-    bye_msg->submitter_type = SubmitterType::JOB_SUBMITTER;
-    send_message("server", IPMessageType::SUBMITTER_BYE, static_cast<void*>(bye_msg));
-}
-
-
 static string submit_workflow_task_as_job(BatsimContext *context, string workflow_name, string submitter_name, Task *task);
-static string wait_for_job_completion(string submitter_name);
+static JobIdentifier wait_for_job_completion(string submitter_name);
 static std::tuple<int,double,double> wait_for_query_answer(string submitter_name);
 
 /* Ugly Global */
@@ -195,11 +56,33 @@ void workflow_submitter_process(BatsimContext * context,
     hello_msg->submitter_type = SubmitterType::JOB_SUBMITTER;
     send_message("server", IPMessageType::SUBMITTER_HELLO, static_cast<void*>(hello_msg));
 
-    /* Create submitted_tasks map */
-    std::map<std::string, Task *> submitted_tasks;
+    /* Ready tasks are submitted by decreasing bottom level (critical path first), then by index */
+    auto ready_comparator = [workflow](int a, int b)
+    {
+        const Task * task_a = workflow->tasks[static_cast<size_t>(a)];
+        const Task * task_b = workflow->tasks[static_cast<size_t>(b)];
+        if (task_a->bottom_level != task_b->bottom_level)
+        {
+            return task_a->bottom_level < task_b->bottom_level;
+        }
+        return a > b;
+    };
+    std::priority_queue<int, std::vector<int>, decltype(ready_comparator)> ready_tasks(ready_comparator);
+    for (const Task * task : workflow->get_source_tasks())
+    {
+        ready_tasks.push(task->index);
+    }
+
+    /* The number of parents that have not completed yet, for each task */
+    std::vector<int> nb_remaining_parents(static_cast<size_t>(workflow->nb_tasks()));
+    for (int i = 0; i < workflow->nb_tasks(); ++i)
+    {
+        nb_remaining_parents[static_cast<size_t>(i)] = workflow->nb_parents(i);
+    }
 
-    /* Create ready_tasks vector */
-    std::vector<Task *> ready_tasks = workflow->get_source_tasks();
+    /* The task of each submitted job, indexed by job number */
+    std::vector<int> task_of_job;
+    int nb_submitted_tasks = 0;
 
     /* Wait until the workflow start-time */
     if (workflow->start_time > simgrid::s4u::Engine::get_clock())
@@ -211,54 +94,47 @@ void workflow_submitter_process(BatsimContext * context,
 
     /* Submit all the ready tasks */
 
-    while((!ready_tasks.empty())||(!submitted_tasks.empty())) /* Stops when there are no more ready tasks or tasks actually running */
+    while((!ready_tasks.empty())||(nb_submitted_tasks > 0)) /* Stops when there are no more ready tasks or tasks actually running */
     {
         while((!ready_tasks.empty())&&(not_limiting || (limit > current_nb))) /* we have some ready tasks to submit */
         {
-            Task *task = ready_tasks.at(0);
-            ready_tasks.erase(ready_tasks.begin() + 0);
+            Task *task = workflow->tasks[static_cast<size_t>(ready_tasks.top())];
+            ready_tasks.pop();
 
             /* Send a Job corresponding to the Task Job */
+            xbt_assert(task_id_counters[workflow_name] == static_cast<int>(task_of_job.size()),
+                       "inconsistency: the jobs of workflow '%s' are not numbered sequentially", workflow_name.c_str());
+            task_of_job.push_back(task->index);
             string job_key = submit_workflow_task_as_job(context, workflow_name, submitter_name, task);
 
             XBT_INFO("Inserting task %s", job_key.c_str());
 
-            /* Insert the task into the submitted_tasks map */
-            submitted_tasks[job_key] = task;
+            nb_submitted_tasks++;
             current_nb++;
         }
 
-        if(!submitted_tasks.empty()) /* we are done submitting tasks, wait for one to complete */
+        if(nb_submitted_tasks > 0) /* we are done submitting tasks, wait for one to complete */
         {
             /* Wait for callback */
-            string completed_job_key = wait_for_job_completion(submitter_name);
+            JobIdentifier completed_job_id = wait_for_job_completion(submitter_name);
             current_nb--;
+            nb_submitted_tasks--;
 
-            //XBT_INFO("TASK # %s has completed!!!\n", completed_job_key.c_str());
-
-            /* Look for the task in the map */
-            Task *completed_task = submitted_tasks[completed_job_key];
+            /* Look for the task of the job */
+            const int completed_task_index = task_of_job.at(static_cast<size_t>(std::stoi(completed_job_id.job_name())));
+            const Task *completed_task = workflow->tasks[static_cast<size_t>(completed_task_index)];
 
             XBT_INFO("TASK %s has completed! (depth=%d)\n", completed_task->id.c_str(),completed_task->depth);
 
-            /* All those poor hungry kids */
-            std::vector<Task *> my_kids = completed_task->children;
-
-            /* tell them they are closer to being elected */
-            std::transform (my_kids.begin(),my_kids.end(),my_kids.begin(),inc_child);
-            std::transform (my_kids.begin(),my_kids.end(),my_kids.begin(), boost::bind(&bottom_level_f, _1, completed_task));
-
-            /* look for ready kids */
-            for (std::vector<Task *>::iterator kiddo=my_kids.begin(); kiddo!=my_kids.end(); ++kiddo)
+            /* tell the children they are closer to being elected, and look for ready ones */
+            for (const int * child = workflow->children_begin(completed_task_index);
+                 child != workflow->children_end(completed_task_index); ++child)
             {
-                if((*kiddo)->nb_parent_completed==static_cast<int>((*kiddo)->parents.size()))
+                if (--nb_remaining_parents[static_cast<size_t>(*child)] == 0)
                 {
-                    ready_tasks.push_back(*kiddo);
+                    ready_tasks.push(*child);
                 }
             }
-
-            /* Nothing left for this task */
-            submitted_tasks.erase(completed_job_key);
         }
     }
 
@@ -290,46 +166,28 @@ static string submit_workflow_task_as_job(BatsimContext *context, string workflo
 
 
     // Create a profile
-    auto profile = make_shared<Profile>();
-    profile->type = ProfileType::DELAY;
-    DelayProfileData * data = new DelayProfileData;
-    data->delay = task->execution_time;
-    profile->data = data;
-    profile->json_description = std::string() + "{" +
-            "\"type\": \"delay\", "+
-            "\"delay\": " + std::to_string(task->execution_time) +
-            "}";
     string profile_name = workflow_name + "_" + task->id; // Create a profile name
-    profile->name = profile_name;
-    context->workloads.at(workload_name)->profiles->add_profile(profile_name, profile);
+    auto profile = Profile::new_delay_profile(profile_name, task->execution_time);
+    Workload * workload = context->workloads.at(workload_name);
+    workload->profiles->add_profile(profile_name, profile);
 
-    // Create JSON description of Job corresponding to Task
+    // Create the Job corresponding to the Task and put it into memory
+    JobIdentifier job_id(workload_name, job_number);
     double walltime = task->execution_time + 10.0;
-    string job_json_description = std::string() + "{" +
-            "\"id\": \"" + workload_name + "!" + job_number +  "\", " +
-            "\"subtime\":" + std::to_string(simgrid::s4u::Engine::get_clock()) + ", " +
-            "\"walltime\":" + std::to_string(walltime) + ", " +
-            "\"res\":" + std::to_string(task->num_procs) + ", " +
-            "\"profile\": \"" + profile_name + "\"" +
-            "}";
-
-    // Puts the job into memory
-    auto job = Job::from_json(job_json_description, context->workloads.at(workload_name),
-                              "Invalid workflow-injected JSON job");
-    context->workloads.at(workload_name)->jobs->add_job(job);
+    auto job = Job::create(job_id, workload, profile,
+                           static_cast<long double>(simgrid::s4u::Engine::get_clock()),
+                           static_cast<unsigned int>(task->num_procs), walltime);
+    workload->jobs->add_job(job);
 
     // Put the metadata about the job into the data storage
-    JobIdentifier job_id(workload_name, job_number);
     if (context->redis_enabled)
     {
-        string job_key = RedisStorage::job_key(job_id);
-        context->storage.set(job_key, job_json_description);
-
+        vector<pair<string, string>> storage_key_values = {{Storage::job_key(job_id), job->get_json_description()}};
         if (context->submission_forward_profiles)
         {
-            string profile_key = RedisStorage::profile_key(workflow_name, profile_name);
-            context->storage.set(profile_key, profile->json_description);
+            storage_key_values.emplace_back(Storage::profile_key(workflow_name, profile_name), profile->get_json_description());
         }
+        context->storage->set_many(storage_key_values);
     }
 
     // Submit the job
@@ -356,18 +214,19 @@ static string submit_workflow_task_as_job(BatsimContext *context, string workflo
 }
 
 /**
- * @brief TODO
- * @param submitter_name TODO
- * @return TODO
+ * @brief Waits until a job submitted by a submitter has completed
+ * @param submitter_name The name (and mailbox) of the submitter
+ * @return The identifier of the completed job
  */
-static string wait_for_job_completion(string submitter_name)
+static JobIdentifier wait_for_job_completion(string submitter_name)
 {
     IPMessage * notification = receive_message(submitter_name);
 
     auto * notification_data = static_cast<SubmitterJobCompletionCallbackMessage *>(notification->data);
+    JobIdentifier job_id = notification_data->job_id;
 
-    // TODO: memory cleanup
-    return notification_data->job_id.to_string();
+    delete notification;
+    return job_id;
 }
 
 /**
@@ -9,14 +9,6 @@
 
 struct BatsimContext;
 
-/**
- * @brief The process in charge of submitting static jobs (those described before running the simulations)
- * @param[in] context The BatsimContext
- * @param[in] workload_name The name of the workload attached to the submitter
- */
-void static_job_submitter_process(BatsimContext * context,
-                                  std::string workload_name);
-
 /**
  * @brief The process in charge of submitting dynamic jobs that are part of a workflow
  * @param[in] context The BatsimContext
@@ -92,12 +92,12 @@ void JobIdentifier::check_lexically_valid() const
     xbt_assert(is_lexically_valid(reason), "%s", reason.c_str());
 }
 
-string JobIdentifier::workload_name() const
+const string & JobIdentifier::workload_name() const
 {
     return _workload_name;
 }
 
-string JobIdentifier::job_name() const
+const string & JobIdentifier::job_name() const
 {
     return _job_name;
 }
@@ -138,6 +138,59 @@ BatTask::~BatTask()
     }
 }
 
+void * BatTask::_free_list = nullptr;
+unsigned int BatTask::_free_list_size = 0;
+
+//! The maximum number of memory blocks kept in the free list of BatTask (0 once the free list has been released)
+static unsigned int max_free_list_size = 4096;
+
+void * BatTask::operator new(std::size_t size)
+{
+    xbt_assert(size == sizeof(BatTask), "BatTask allocator only handles BatTask objects (asked size=%zu)", size);
+
+    if (_free_list != nullptr)
+    {
+        void * block = _free_list;
+        _free_list = *static_cast<void **>(block);
+        --_free_list_size;
+        return block;
+    }
+
+    return ::operator new(sizeof(BatTask));
+}
+
+void BatTask::operator delete(void * ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    if (_free_list_size >= max_free_list_size)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    *static_cast<void **>(ptr) = _free_list;
+    _free_list = ptr;
+    ++_free_list_size;
+}
+
+void BatTask::release_free_list()
+{
+    while (_free_list != nullptr)
+    {
+        void * block = _free_list;
+        _free_list = *static_cast<void **>(block);
+        ::operator delete(block);
+    }
+    _free_list_size = 0;
+
+    // The tasks deleted afterwards (with the jobs) are directly given back to the system
+    max_free_list_size = 0;
+}
+
 void BatTask::compute_leaf_progress()
 {
     xbt_assert(sub_tasks.empty(), "Leaves should not contain sub tasks");
@@ -553,9 +606,79 @@ JobPtr Job::from_json(const std::string & json_str,
     return Job::from_json(doc, workload, error_prefix);
 }
 
+JobPtr Job::create(const JobIdentifier & id,
+                   Workload * workload,
+                   ProfilePtr profile,
+                   long double submission_time,
+                   unsigned int requested_nb_res,
+                   long double walltime)
+{
+    xbt_assert(walltime == -1 || walltime > 0,
+               "Cannot create job '%s': invalid walltime (%Lg). It should either be -1 (no walltime) "
+               "or a strictly positive number.", id.to_cstring(), walltime);
+    xbt_assert(profile != nullptr, "Cannot create job '%s': it has no profile", id.to_cstring());
+
+    auto j = std::make_shared<Job>();
+    j->workload = workload;
+    j->id = id;
+    j->starting_time = -1;
+    j->runtime = -1;
+    j->state = JobState::JOB_STATE_NOT_SUBMITTED;
+    j->consumed_energy = -1;
+    j->profile = std::move(profile);
+    j->submission_time = submission_time;
+    j->walltime = walltime;
+    j->requested_nb_res = requested_nb_res;
+
+    XBT_DEBUG("Job '%s' Created", j->id.to_cstring());
+    return j;
+}
+
+const std::string & Job::get_json_description() const
+{
+    if (json_description.empty())
+    {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.StartObject();
+        writer.Key("id");
+        writer.String(id.to_string().c_str());
+        writer.Key("subtime");
+        writer.Double(static_cast<double>(submission_time));
+        if (walltime != -1)
+        {
+            writer.Key("walltime");
+            writer.Double(static_cast<double>(walltime));
+        }
+        writer.Key("res");
+        writer.Uint(requested_nb_res);
+        writer.Key("profile");
+        writer.String(profile->name.c_str());
+        if (!smpi_ranks_to_hosts_mapping.empty())
+        {
+            writer.Key("smpi_ranks_to_hosts_mapping");
+            writer.StartArray();
+            for (int host_number : smpi_ranks_to_hosts_mapping)
+            {
+                writer.Int(host_number);
+            }
+            writer.EndArray();
+        }
+        writer.EndObject();
+        json_description = string(buffer.GetString(), buffer.GetSize());
+    }
+
+    return json_description;
+}
+
 std::string job_state_to_string(const JobState & state)
 {
-    string job_state("UNKNOWN");
+    return job_state_to_cstring(state);
+}
+
+const char * job_state_to_cstring(const JobState & state)
+{
+    const char * job_state = "UNKNOWN";
 
     switch (state)
     {
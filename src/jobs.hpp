@@ -79,13 +79,13 @@ public:
      * @brief Returns the workload name.
      * @return The workload name.
      */
-    std::string workload_name() const;
+    const std::string & workload_name() const;
 
     /**
      * @brief Returns the job name within the workload.
      * @return The job name within the workload.
      */
-    std::string job_name() const;
+    const std::string & job_name() const;
 
 private:
     /**
@@ -168,6 +168,26 @@ struct BatTask
       */
     ~BatTask();
 
+    /**
+     * @brief Allocates the memory of a BatTask, reusing the memory of a previously deleted BatTask if possible
+     * @param[in] size The size of the memory block
+     * @return The memory block
+     */
+    static void * operator new(std::size_t size);
+
+    /**
+     * @brief Puts the memory of a deleted BatTask in the free list, so it can be reused by the next allocation
+     * @details The memory is given back to the system if the free list is full.
+     * @param[in] ptr The memory block
+     */
+    static void operator delete(void * ptr);
+
+    /**
+     * @brief Gives the memory of the free list back to the system
+     * @details Meant to be called once the simulation is finished: the BatTask deleted afterwards are not put in the free list.
+     */
+    static void release_free_list();
+
     /**
      * @brief Computes the current progress of a task
      * @details This function does recursive calls if needed (composed tasks).
@@ -181,6 +201,11 @@ private:
      */
     void compute_leaf_progress();
 
+    // The free list is not protected: BatTask objects must only be created and deleted by the simulation actors,
+    // which is true as long as SimGrid runs its actors in a single thread (contexts/nthreads=1, the default).
+    static void * _free_list; //!< The memory blocks of deleted BatTask, chained through their first bytes
+    static unsigned int _free_list_size; //!< The number of memory blocks in the free list
+
 public:
     JobPtrWeak parent_job; //!< The parent job that owns this task
     ProfilePtr profile; //!< The task profile. The corresponding profile tells how the job should be computed
@@ -216,7 +241,7 @@ struct Job
     Workload * workload = nullptr; //!< The workload the job belongs to
     JobIdentifier id; //!< The job unique identifier
     BatTask * task = nullptr; //!< The root task be executed by this job (profile instantiation).
-    std::string json_description; //!< The JSON description of the job
+    mutable std::string json_description; //!< The JSON description of the job. Jobs built by Job::create only have it once get_json_description has been called
     std::set<simgrid::s4u::ActorPtr> execution_actors; //!< The actors involved in running the job
     std::deque<std::string> incoming_message_buffer; //!< The buffer for incoming messages from the scheduler.
 
@@ -269,6 +294,31 @@ public:
     static JobPtr from_json(const std::string & json_str,
                            Workload * workload,
                            const std::string & error_prefix = "Invalid JSON job");
+
+    /**
+     * @brief Creates a new-allocated Job from its fields, without going through JSON
+     * @details The JSON description of the job is only synthesized if get_json_description is called
+     * @param[in] id The job unique identifier
+     * @param[in] workload The Workload the job is in
+     * @param[in] profile The profile of the job
+     * @param[in] submission_time The job submission time
+     * @param[in] requested_nb_res The number of resources the job requests
+     * @param[in] walltime The job walltime (-1 to disable it)
+     * @return The newly allocated Job
+     */
+    static JobPtr create(const JobIdentifier & id,
+                         Workload * workload,
+                         ProfilePtr profile,
+                         long double submission_time,
+                         unsigned int requested_nb_res,
+                         long double walltime = -1);
+
+    /**
+     * @brief Returns the JSON description of the job, synthesizing it from the job fields if needed
+     * @return The JSON description of the job
+     */
+    const std::string & get_json_description() const;
+
     /**
      * @brief Checks whether a job is complete (regardless of the job success)
      * @return true if the job is complete (=has started then finished), false otherwise.
@@ -428,6 +478,13 @@ private:
  */
 std::string job_state_to_string(const JobState & state);
 
+/**
+ * @brief Returns a null-terminated C string corresponding to a given JobState
+ * @param[in] state The JobState
+ * @return A static null-terminated C string corresponding to a given JobState
+ */
+const char * job_state_to_cstring(const JobState & state);
+
 /**
  * @brief Returns a JobState corresponding to a given std::string
  * @param[in] state The std::string
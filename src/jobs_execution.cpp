@@ -374,7 +374,7 @@ int execute_task(BatTask * btask,
     }
     else
         xbt_die("Cannot execute job %s: the profile '%s' is of unknown type: %s",
-                job->id.to_cstring(), job->profile->name.c_str(), profile->json_description.c_str());
+                job->id.to_cstring(), job->profile->name.c_str(), profile->get_json_description().c_str());
 
     return 1;
 }
@@ -423,6 +423,7 @@ BatTask * initialize_sequential_tasks(JobPtr job, ProfilePtr profile, ProfilePtr
 
     // it's a sequence profile
     auto * data = static_cast<SequenceProfileData *>(profile->data);
+    task->sub_tasks.reserve(data->repeat * data->sequence.size());
 
     // Sequences can be repeated several times
     for (unsigned int repeated = 0; repeated < data->repeat; repeated++)
@@ -530,7 +531,12 @@ void execute_job_process(BatsimContext * context,
     {
         XBT_INFO("Job '%s' had been killed (walltime %Lg reached)", job->id.to_cstring(), job->walltime);
         job->state = JobState::JOB_STATE_COMPLETED_WALLTIME_REACHED;
-        if (context->trace_schedule)
+        if (context->trace_schedule && context->binary_schedule_trace)
+        {
+            context->binary_schedule_tracer.add_job_kill(job->id, allocation->machine_ids,
+                                                         simgrid::s4u::Engine::get_clock());
+        }
+        else if (context->trace_schedule)
         {
             context->paje_tracer.add_job_kill(job->id, allocation->machine_ids,
                                               simgrid::s4u::Engine::get_clock(), true);
@@ -540,7 +546,12 @@ void execute_job_process(BatsimContext * context,
     {
         XBT_INFO("Job '%s' has been killed by the scheduler", job->id.to_cstring());
         job->state = JobState::JOB_STATE_COMPLETED_KILLED;
-        if (context->trace_schedule)
+        if (context->trace_schedule && context->binary_schedule_trace)
+        {
+            context->binary_schedule_tracer.add_job_kill(job->id, allocation->machine_ids,
+                                                         simgrid::s4u::Engine::get_clock());
+        }
+        else if (context->trace_schedule)
         {
             context->paje_tracer.add_job_kill(job->id, allocation->machine_ids,
                                               simgrid::s4u::Engine::get_clock(), true);
@@ -584,6 +595,98 @@ void execute_job_process(BatsimContext * context,
     job->execution_actors.erase(simgrid::s4u::Actor::self());
 }
 
+simgrid::s4u::ActorPtr JobExecutorPool::execute_job(BatsimContext * context,
+                                                    SchedulingAllocation * allocation,
+                                                    ProfilePtr io_profile)
+{
+    xbt_assert(!_pool->stopped, "Cannot execute job '%s': the job executor pool has been stopped",
+               allocation->job->id.to_cstring());
+
+    if (_pool->idle_executors.empty())
+    {
+        auto executor = std::make_shared<Executor>();
+        executor->mutex = simgrid::s4u::Mutex::create();
+        executor->job_available = simgrid::s4u::ConditionVariable::create();
+        executor->allocation = allocation;
+        executor->io_profile = io_profile;
+
+        string pname = "job_executor_" + to_string(_nb_created_executors++);
+        executor->actor = simgrid::s4u::Actor::create(pname.c_str(),
+                                                      context->machines[allocation->machine_ids.first_element()]->host,
+                                                      executor_process, context, _pool, executor);
+        return executor->actor;
+    }
+
+    // Conditions variables are used rather than mailboxes, as communications would take simulated time
+    auto executor = _pool->idle_executors.back();
+    _pool->idle_executors.pop_back();
+
+    executor->allocation = allocation;
+    executor->io_profile = io_profile;
+    executor->job_available->notify_one();
+    return executor->actor;
+}
+
+unsigned int JobExecutorPool::nb_created_executors() const
+{
+    return _nb_created_executors;
+}
+
+unsigned int JobExecutorPool::nb_idle_executors() const
+{
+    return static_cast<unsigned int>(_pool->idle_executors.size());
+}
+
+void JobExecutorPool::stop()
+{
+    _pool->stopped = true;
+
+    // Idle executors are woken up without a job, which makes them finish
+    for (auto & executor : _pool->idle_executors)
+    {
+        executor->job_available->notify_one();
+    }
+    _pool->idle_executors.clear();
+}
+
+void JobExecutorPool::executor_process(BatsimContext * context,
+                                       std::shared_ptr<PoolState> pool,
+                                       std::shared_ptr<Executor> executor)
+{
+    // Executors are not daemons: SimGrid must not end the simulation while one of them runs a job
+    while (true)
+    {
+        {
+            std::unique_lock<simgrid::s4u::Mutex> lock(*executor->mutex);
+            while (executor->allocation == nullptr && !pool->stopped)
+            {
+                executor->job_available->wait(lock);
+            }
+        }
+
+        if (executor->allocation == nullptr)
+        {
+            // The pool has been stopped while the executor was idle
+            return;
+        }
+
+        SchedulingAllocation * allocation = executor->allocation;
+        ProfilePtr io_profile = executor->io_profile;
+        executor->allocation = nullptr;
+        executor->io_profile = nullptr;
+
+        XBT_DEBUG("Executor '%s' executes job '%s'", simgrid::s4u::this_actor::get_cname(), allocation->job->id.to_cstring());
+        simgrid::s4u::this_actor::set_host(context->machines[allocation->machine_ids.first_element()]->host);
+        execute_job_process(context, allocation, true, io_profile);
+
+        if (pool->stopped)
+        {
+            return;
+        }
+        pool->idle_executors.push_back(executor);
+    }
+}
+
 void waiter_process(double target_time, const ServerData * server_data)
 {
     double curr_time = simgrid::s4u::Engine::get_clock();
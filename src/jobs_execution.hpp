@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "ipp.hpp"
 #include "context.hpp"
 
@@ -67,6 +70,83 @@ int execute_task(BatTask * btask,
  */
 void execute_job_process(BatsimContext *context, SchedulingAllocation *allocation, bool notify_server_at_end, ProfilePtr io_profile);
 
+/**
+ * @brief A pool of reusable actors in charge of executing jobs
+ * @details Executors are created on demand and put back into the pool when their job completes.
+ *          An executor killed with its job simply leaves the pool.
+ *          Executors are not daemons, so that SimGrid waits for the jobs they run:
+ *          the idle ones must be released with stop() once the simulation is finished.
+ */
+class JobExecutorPool
+{
+public:
+    /**
+     * @brief Executes a job on an idle executor, or on a new executor if none is idle
+     * @param[in] context The BatsimContext
+     * @param[in] allocation The job allocation
+     * @param[in] io_profile The optional IO profile
+     * @return The actor that executes the job
+     */
+    simgrid::s4u::ActorPtr execute_job(BatsimContext * context,
+                                       SchedulingAllocation * allocation,
+                                       ProfilePtr io_profile);
+
+    /**
+     * @brief Returns the number of executors that have been created
+     * @return The number of executors that have been created
+     */
+    unsigned int nb_created_executors() const;
+
+    /**
+     * @brief Returns the number of idle executors
+     * @return The number of idle executors
+     */
+    unsigned int nb_idle_executors() const;
+
+    /**
+     * @brief Stops the idle executors, and the busy ones as soon as their job completes
+     * @details No job can be executed by the pool once it has been stopped
+     */
+    void stop();
+
+private:
+    /**
+     * @brief The state of one executor
+     */
+    struct Executor
+    {
+        simgrid::s4u::ActorPtr actor; //!< The actor that executes the jobs
+        simgrid::s4u::MutexPtr mutex; //!< Protects the pending job
+        simgrid::s4u::ConditionVariablePtr job_available; //!< Notified when a job is given to the executor
+        SchedulingAllocation * allocation = nullptr; //!< The allocation of the pending job, if any
+        ProfilePtr io_profile = nullptr; //!< The optional IO profile of the pending job
+    };
+
+    /**
+     * @brief The state of the pool shared with its executors
+     */
+    struct PoolState
+    {
+        std::vector<std::shared_ptr<Executor>> idle_executors; //!< The executors waiting for a job
+        bool stopped = false; //!< Whether the pool has been stopped
+    };
+
+    /**
+     * @brief The process run by each executor: executes the jobs it is given until the pool is stopped
+     * @details The pool state is shared with the executors so that it remains valid if the pool is destroyed first
+     * @param[in] context The BatsimContext
+     * @param[in] pool The state of the pool the executor belongs to
+     * @param[in] executor The executor state
+     */
+    static void executor_process(BatsimContext * context,
+                                 std::shared_ptr<PoolState> pool,
+                                 std::shared_ptr<Executor> executor);
+
+private:
+    std::shared_ptr<PoolState> _pool = std::make_shared<PoolState>(); //!< The state shared with the executors
+    unsigned int _nb_created_executors = 0; //!< The number of executors that have been created
+};
+
 /**
  * @brief The process in charge of waiting for a given amount of time (related to the NOPMeLater message)
  * @param[in] target_time The time at which the waiter should stop waiting
@@ -0,0 +1,115 @@
+/**
+ * @file machine_sets.cpp
+ * @brief Contains the machine sets used to check job allocations as a whole
+ */
+
+#include "machine_sets.hpp"
+
+#include "machines.hpp"
+
+void MachineSets::add_machine(int machine_id, MachineState state, bool is_compute_node, bool is_storage)
+{
+    _machines_in_each_state[state].insert(machine_id);
+    set_roles(machine_id, is_compute_node, is_storage);
+}
+
+void MachineSets::set_roles(int machine_id, bool is_compute_node, bool is_storage)
+{
+    if (is_compute_node)
+    {
+        _compute_machine_ids.insert(machine_id);
+    }
+    else
+    {
+        _compute_machine_ids.remove(machine_id);
+    }
+
+    if (is_storage)
+    {
+        _storage_machine_ids.insert(machine_id);
+    }
+    else
+    {
+        _storage_machine_ids.remove(machine_id);
+    }
+}
+
+void MachineSets::set_state(int machine_id, MachineState old_state, MachineState new_state)
+{
+    _machines_in_each_state[old_state].remove(machine_id);
+    _machines_in_each_state[new_state].insert(machine_id);
+}
+
+void MachineSets::set_occupied(const IntervalSet & machine_ids)
+{
+    _occupied_machines += machine_ids;
+}
+
+void MachineSets::set_unoccupied(int machine_id)
+{
+    _occupied_machines.remove(machine_id);
+}
+
+void MachineSets::set_in_computation_pstate(int machine_id, bool in_computation_pstate)
+{
+    if (in_computation_pstate)
+    {
+        _machines_in_computation_pstate.insert(machine_id);
+    }
+    else
+    {
+        _machines_in_computation_pstate.remove(machine_id);
+    }
+}
+
+const IntervalSet & MachineSets::machines_in_state(MachineState state) const
+{
+    static const IntervalSet no_machines;
+
+    auto machines_it = _machines_in_each_state.find(state);
+    if (machines_it == _machines_in_each_state.end())
+    {
+        return no_machines;
+    }
+    return machines_it->second;
+}
+
+const IntervalSet & MachineSets::compute_machine_ids() const
+{
+    return _compute_machine_ids;
+}
+
+const IntervalSet & MachineSets::storage_machine_ids() const
+{
+    return _storage_machine_ids;
+}
+
+const IntervalSet & MachineSets::occupied_machines() const
+{
+    return _occupied_machines;
+}
+
+const IntervalSet & MachineSets::machines_in_computation_pstate() const
+{
+    return _machines_in_computation_pstate;
+}
+
+IntervalSet MachineSets::busy_compute_machines(const IntervalSet & allocation) const
+{
+    return (allocation & _compute_machine_ids) & _occupied_machines;
+}
+
+IntervalSet MachineSets::busy_storage_machines(const IntervalSet & allocation) const
+{
+    return (allocation & _storage_machine_ids) & _occupied_machines;
+}
+
+IntervalSet MachineSets::unusable_machines(const IntervalSet & allocation) const
+{
+    return (allocation - machines_in_state(MachineState::COMPUTING)) - machines_in_state(MachineState::IDLE);
+}
+
+IntervalSet MachineSets::machines_not_in_computation_pstate(const IntervalSet & allocation) const
+{
+    return allocation - _machines_in_computation_pstate;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file machine_sets.hpp
+ * @brief Contains the machine sets used to check job allocations as a whole
+ */
+
+#pragma once
+
+#include <map>
+
+#include <intervalset.hpp>
+
+enum class MachineState;
+
+/**
+ * @brief Maintains the sets of machines in each state, with each role, computing jobs or in a computation power state
+ * @details The sets are updated on every change of a machine, so that a whole allocation can be checked
+ *          with a few set operations instead of inspecting each of its machines.
+ */
+class MachineSets
+{
+public:
+    /**
+     * @brief Adds a machine to the sets. The machine is not occupied and not in a computation power state
+     * @param[in] machine_id The machine unique number
+     * @param[in] state The current state of the machine
+     * @param[in] is_compute_node Whether the machine has the compute node role
+     * @param[in] is_storage Whether the machine has the storage role
+     */
+    void add_machine(int machine_id, MachineState state, bool is_compute_node, bool is_storage);
+
+    /**
+     * @brief Sets the roles of a machine
+     * @param[in] machine_id The machine unique number
+     * @param[in] is_compute_node Whether the machine has the compute node role
+     * @param[in] is_storage Whether the machine has the storage role
+     */
+    void set_roles(int machine_id, bool is_compute_node, bool is_storage);
+
+    /**
+     * @brief Moves a machine from a state set to another
+     * @param[in] machine_id The machine unique number
+     * @param[in] old_state The old state of the machine
+     * @param[in] new_state The new state of the machine
+     */
+    void set_state(int machine_id, MachineState old_state, MachineState new_state);
+
+    /**
+     * @brief Marks machines as computing at least one job
+     * @param[in] machine_ids The machines
+     */
+    void set_occupied(const IntervalSet & machine_ids);
+
+    /**
+     * @brief Marks a machine as computing no job
+     * @param[in] machine_id The machine unique number
+     */
+    void set_unoccupied(int machine_id);
+
+    /**
+     * @brief Sets whether a machine is in a computation power state
+     * @param[in] machine_id The machine unique number
+     * @param[in] in_computation_pstate Whether the machine is in a computation power state
+     */
+    void set_in_computation_pstate(int machine_id, bool in_computation_pstate);
+
+    /**
+     * @brief Returns the machines which are in a given MachineState
+     * @param[in] state The MachineState
+     * @return A const reference to the machines which are in the given state
+     */
+    const IntervalSet & machines_in_state(MachineState state) const;
+
+    /**
+     * @brief Returns the machines which have the compute node role
+     * @return A const reference to the machines which have the compute node role
+     */
+    const IntervalSet & compute_machine_ids() const;
+
+    /**
+     * @brief Returns the machines which have the storage role
+     * @return A const reference to the machines which have the storage role
+     */
+    const IntervalSet & storage_machine_ids() const;
+
+    /**
+     * @brief Returns the machines which are currently computing at least one job
+     * @return A const reference to the machines which are currently computing at least one job
+     */
+    const IntervalSet & occupied_machines() const;
+
+    /**
+     * @brief Returns the machines which are currently in a computation power state
+     * @return A const reference to the machines which are currently in a computation power state
+     */
+    const IntervalSet & machines_in_computation_pstate() const;
+
+    /**
+     * @brief Returns the compute machines of an allocation which are currently computing at least one job
+     * @param[in] allocation The allocated machines
+     * @return The compute machines of the allocation which are currently computing at least one job
+     */
+    IntervalSet busy_compute_machines(const IntervalSet & allocation) const;
+
+    /**
+     * @brief Returns the storage machines of an allocation which are currently computing at least one job
+     * @param[in] allocation The allocated machines
+     * @return The storage machines of the allocation which are currently computing at least one job
+     */
+    IntervalSet busy_storage_machines(const IntervalSet & allocation) const;
+
+    /**
+     * @brief Returns the machines of an allocation which cannot compute a job now (neither computing nor idle)
+     * @param[in] allocation The allocated machines
+     * @return The machines of the allocation which cannot compute a job now
+     */
+    IntervalSet unusable_machines(const IntervalSet & allocation) const;
+
+    /**
+     * @brief Returns the machines of an allocation which are not in a computation power state
+     * @param[in] allocation The allocated machines
+     * @return The machines of the allocation which are not in a computation power state
+     */
+    IntervalSet machines_not_in_computation_pstate(const IntervalSet & allocation) const;
+
+private:
+    std::map<MachineState, IntervalSet> _machines_in_each_state; //!< The machines which are in each state
+    IntervalSet _compute_machine_ids; //!< The machines which have the compute node role
+    IntervalSet _storage_machine_ids; //!< The machines which have the storage role
+    IntervalSet _occupied_machines; //!< The machines which are currently computing at least one job
+    IntervalSet _machines_in_computation_pstate; //!< The machines which are currently in a computation power state
+};
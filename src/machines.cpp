@@ -290,6 +290,7 @@ void Machines::create_machines(const BatsimContext *context,
         machine->id = id;
         ++id;
         _machines.push_back(machine);
+        _machines_by_name[machine->name] = machine;
     }
 
     // then attibute ids to storage machines
@@ -298,45 +299,79 @@ void Machines::create_machines(const BatsimContext *context,
         machine->id = id;
         ++id;
         _machines.push_back(machine);
+        _machines_by_name[machine->name] = machine;
     }
 
     // Retrieve zone properties and forward it to machines
     simgrid::s4u::NetZone * root = simgrid::s4u::Engine::get_instance()->get_netzone_root();
-    std::unordered_map<std::string, std::string> parent_properties;
-    attach_zone_properties_to_machines(root, parent_properties);
+    attach_zone_properties_to_machines(root);
 
     xbt_assert(_master_machine != nullptr,
                "Cannot find the \"master\" role in the platform file");
 
     _nb_machines_in_each_state[MachineState::IDLE] = static_cast<int>(_compute_nodes.size());
+
+    // Let the machine sets be initialized. All machines are idle at this point.
+    for (const Machine * machine : _machines)
+    {
+        _machine_sets.add_machine(machine->id, machine->state,
+                                  machine->has_role(Permissions::COMPUTE_NODE),
+                                  machine->has_role(Permissions::STORAGE));
+        if (context->energy_used)
+        {
+            update_machines_in_computation_pstate(machine);
+        }
+    }
+
+    _energy_used = context->energy_used;
+    if (_energy_used)
+    {
+        initialize_energy_tracking();
+    }
 }
 
 
-void Machines::attach_zone_properties_to_machines(simgrid::s4u::NetZone * current_zone,
-                                                  std::unordered_map<std::string, std::string> parent_properties)
+void Machines::attach_zone_properties_to_machines(simgrid::s4u::NetZone * root_zone)
 {
-    // First add current properties to parent_properties
-    for (auto const& it: *current_zone->get_properties())
+    std::unordered_map<const simgrid::s4u::NetZone *, std::shared_ptr<const ZoneProperties>> zone_properties;
+    build_zone_properties(root_zone, std::make_shared<const ZoneProperties>(), zone_properties);
+
+    // Each machine gets the table of the zone that directly contains it
+    for (Machine * machine : _machines)
     {
-        // If property was already defined by parent zones it is overwritten
-        parent_properties[it.first] = it.second;
+        auto zone_it = zone_properties.find(machine->host->get_englobing_zone());
+        if (zone_it != zone_properties.end())
+        {
+            machine->zone_properties = zone_it->second;
+        }
     }
+}
 
-    // Second add zone properties to the hosts of this zone
-    for (simgrid::s4u::Host * host : current_zone->get_all_hosts())
+void Machines::build_zone_properties(simgrid::s4u::NetZone * current_zone,
+                                     const std::shared_ptr<const ZoneProperties> & parent_properties,
+                                     std::unordered_map<const simgrid::s4u::NetZone *, std::shared_ptr<const ZoneProperties>> & zone_properties)
+{
+    // Zones without properties of their own share the table of their parent
+    std::shared_ptr<const ZoneProperties> current_properties = parent_properties;
+
+    const auto * properties = current_zone->get_properties();
+    if (properties != nullptr && !properties->empty())
     {
-        Machine * m = machine_by_name_or_null(host->get_name());
-        if (m != nullptr) // Filter out the master_host
+        auto merged_properties = std::make_shared<ZoneProperties>(*parent_properties);
+        for (auto const& it: *properties)
         {
-            m->zone_properties = parent_properties;
+            // If property was already defined by parent zones it is overwritten
+            (*merged_properties)[it.first] = it.second;
         }
+        current_properties = merged_properties;
     }
 
+    zone_properties[current_zone] = current_properties;
+
     // Then recursively call this function for child zones
-    //std::vector<simgrid::s4u::NetZone *> child_zones = ;
     for (simgrid::s4u::NetZone * zone : current_zone->get_children())
     {
-        attach_zone_properties_to_machines(zone, parent_properties);
+        build_zone_properties(zone, current_properties, zone_properties);
     }
 }
 
@@ -355,12 +390,9 @@ Machine * Machines::operator[](int machineID)
 
 Machine * Machines::machine_by_name_or_null(const std::string & name) const
 {
-
-    auto it = std::find_if(_machines.begin(), _machines.end(), [& name](Machine * machine) {
-        return machine->name == name;
-    });
-    if (it != _machines.end())
-        return *it;
+    auto it = _machines_by_name.find(name);
+    if (it != _machines_by_name.end())
+        return it->second;
     return nullptr;
 }
 
@@ -412,40 +444,101 @@ const Machine *Machines::master_machine() const
 
 long double Machines::total_consumed_energy(const BatsimContext *context) const
 {
-    long double total_consumed_energy = 0;
+    if (!context->energy_used)
+    {
+        return -1;
+    }
 
-    if (context->energy_used)
+    // The energy consumed since time 0 only depends on the current date
+    long double now = static_cast<long double>(simgrid::s4u::Engine::get_clock());
+    if (now == _energy_cache_date)
     {
-        for (const Machine * m : _machines)
-        {
-            total_consumed_energy += static_cast<long double>(sg_host_get_consumed_energy(m->host));
-        }
+        return _energy_cache;
     }
-    else
+
+    long double total_consumed_energy = _stable_energy.total_energy(now);
+    for (const int machine_id : _unstable_machines)
     {
-        total_consumed_energy = -1;
+        total_consumed_energy += static_cast<long double>(sg_host_get_consumed_energy(_machines[static_cast<size_t>(machine_id)]->host));
     }
 
+    _energy_cache_date = now;
+    _energy_cache = total_consumed_energy;
     return total_consumed_energy;
 }
 
 long double Machines::total_wattmin(const BatsimContext *context) const
 {
-    long double total_wattmin = 0;
+    if (!context->energy_used)
+    {
+        return -1;
+    }
 
-    if (context->energy_used)
+    return _total_wattmin;
+}
+
+long double Machines::consumed_energy_of_machine(const Machine *machine) const
+{
+    const size_t machine_id = static_cast<size_t>(machine->id);
+    if (_stable_energy.is_stable(machine_id))
     {
-        for (const Machine * m : _machines)
-        {
-            total_wattmin += static_cast<long double>(sg_host_get_wattmin_at(m->host, sg_host_get_pstate(m->host)));
-        }
+        return _stable_energy.machine_energy(machine_id, static_cast<long double>(simgrid::s4u::Engine::get_clock()));
+    }
+
+    return static_cast<long double>(sg_host_get_consumed_energy(machine->host));
+}
+
+void Machines::update_machine_energy_tracking(const Machine *machine)
+{
+    if (!_energy_used || machine->id < 0)
+    {
+        return;
+    }
+
+    const size_t machine_id = static_cast<size_t>(machine->id);
+    long double now = static_cast<long double>(simgrid::s4u::Engine::get_clock());
+
+    // The wattmin only depends on the power state
+    long double wattmin = static_cast<long double>(sg_host_get_wattmin_at(machine->host, sg_host_get_pstate(machine->host)));
+    _total_wattmin += wattmin - _wattmin[machine_id];
+    _wattmin[machine_id] = wattmin;
+
+    if (has_stable_power(machine))
+    {
+        _stable_energy.set_stable(machine_id, now,
+                                  static_cast<long double>(sg_host_get_consumed_energy(machine->host)),
+                                  static_cast<long double>(sg_host_get_current_consumption(machine->host)));
+        _unstable_machines.erase(machine->id);
     }
     else
     {
-        total_wattmin = -1;
+        _stable_energy.set_unstable(machine_id, now);
+        _unstable_machines.insert(machine->id);
     }
+}
+
+void Machines::initialize_energy_tracking()
+{
+    const size_t nb_machines = _machines.size();
+    _wattmin.assign(nb_machines, 0);
+    _unstable_machines.clear();
+    _stable_energy.reset(nb_machines, static_cast<long double>(simgrid::s4u::Engine::get_clock()));
+    _total_wattmin = 0;
+    _energy_cache_date = -1;
 
-    return total_wattmin;
+    for (const Machine * machine : _machines)
+    {
+        update_machine_energy_tracking(machine);
+    }
+}
+
+bool Machines::has_stable_power(const Machine *machine)
+{
+    return machine->permissions != Permissions::STORAGE &&
+           machine->jobs_being_computed.empty() &&
+           (machine->state == MachineState::IDLE ||
+            machine->state == MachineState::SLEEPING ||
+            machine->state == MachineState::UNAVAILABLE);
 }
 
 unsigned int Machines::nb_machines() const
@@ -474,6 +567,29 @@ const std::map<MachineState, int> &Machines::nb_machines_in_each_state() const
     return _nb_machines_in_each_state;
 }
 
+void Machines::update_machines_in_each_state(int machine_id, MachineState old_state, MachineState new_state)
+{
+    _machine_sets.set_state(machine_id, old_state, new_state);
+}
+
+void Machines::update_machines_in_computation_pstate(const Machine *machine)
+{
+    if (machine->id < 0)
+    {
+        return;
+    }
+
+    int pstate = machine->host->get_pstate();
+    auto pstate_it = machine->pstates.find(pstate);
+    _machine_sets.set_in_computation_pstate(machine->id, pstate_it != machine->pstates.end() &&
+                                                         pstate_it->second == PStateType::COMPUTATION_PSTATE);
+}
+
+const MachineSets &Machines::machine_sets() const
+{
+    return _machine_sets;
+}
+
 void Machines::update_machines_on_job_run(const JobPtr job,
                                           const IntervalSet & used_machines,
                                           BatsimContext * context)
@@ -503,6 +619,13 @@ void Machines::update_machines_on_job_run(const JobPtr job,
         }
     }
 
+    _machine_sets.set_occupied(used_machines);
+
+    if (_binary_schedule_tracer != nullptr)
+    {
+        _binary_schedule_tracer->add_job_start(job->id, used_machines, simgrid::s4u::Engine::get_clock());
+    }
+
     if (context->trace_machine_states)
     {
         context->machine_state_tracer.write_machine_states(simgrid::s4u::Engine::get_clock());
@@ -525,9 +648,12 @@ void Machines::update_machines_on_job_end(const JobPtr job,
         size_t ret = machine->jobs_being_computed.erase(job);
         (void) ret; // Avoids a warning if assertions are ignored
         xbt_assert(ret == 1, "could not erase job '%s' from jobs being computed of machine %d", job->id.to_cstring(), machine_id);
+        update_machine_energy_tracking(machine);
 
         if (machine->jobs_being_computed.empty())
         {
+            _machine_sets.set_unoccupied(machine_id);
+
             if (machine->state != MachineState::UNAVAILABLE)
             {
                 machine->update_machine_state(MachineState::IDLE);
@@ -548,6 +674,17 @@ void Machines::update_machines_on_job_end(const JobPtr job,
         }
     }
 
+    // The job has left every machine: the tracer can forget it
+    if (_tracer != nullptr)
+    {
+        _tracer->unregister_job(job->id);
+    }
+
+    if (_binary_schedule_tracer != nullptr)
+    {
+        _binary_schedule_tracer->add_job_end(job->id, used_machines, simgrid::s4u::Engine::get_clock());
+    }
+
     if (context->trace_machine_states)
     {
         context->machine_state_tracer.write_machine_states(simgrid::s4u::Engine::get_clock());
@@ -559,6 +696,11 @@ void Machines::set_tracer(PajeTracer *tracer)
     _tracer = tracer;
 }
 
+void Machines::set_binary_schedule_tracer(BinaryScheduleTracer * tracer)
+{
+    _binary_schedule_tracer = tracer;
+}
+
 string machine_state_to_string(MachineState state)
 {
     string s;
@@ -701,8 +843,21 @@ void Machine::update_machine_state(MachineState new_state)
     time_spent_in_each_state[state] += delta_time;
 
     machines->update_nb_machines_in_each_state(state, new_state);
+    if (id >= 0)
+    {
+        machines->update_machines_in_each_state(id, state, new_state);
+    }
     state = new_state;
     last_state_change_date = current_date;
+
+    machines->update_machine_energy_tracking(this);
+}
+
+void Machine::set_pstate(int new_pstate)
+{
+    host->set_pstate(new_pstate);
+    machines->update_machines_in_computation_pstate(this);
+    machines->update_machine_energy_tracking(this);
 }
 
 int string_numeric_comparator(const std::string & s1, const std::string & s2)
@@ -827,8 +982,8 @@ long double consumed_energy_on_machines(BatsimContext * context,
     for (auto it = machines.elements_begin(); it != machines.elements_end(); ++it)
     {
         int machine_id = *it;
-        Machine * machine = context->machines[machine_id];
-        consumed_energy += static_cast<long double>(sg_host_get_consumed_energy(machine->host));
+        const Machine * machine = context->machines[machine_id];
+        consumed_energy += context->machines.consumed_energy_of_machine(machine);
     }
 
     return consumed_energy;
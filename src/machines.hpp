@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -14,6 +15,8 @@
 
 #include <intervalset.hpp>
 
+#include "energy_aggregate.hpp"
+#include "machine_sets.hpp"
 #include "pointers.hpp"
 #include "pstate.hpp"
 #include "permissions.hpp"
@@ -23,6 +26,7 @@ struct Job;
 class Machines;
 struct MainArguments;
 class PajeTracer;
+class BinaryScheduleTracer;
 
 /**
  * @brief Enumerates the different states of a Machine
@@ -48,6 +52,11 @@ namespace std
 }
 /// @endcond
 
+/**
+ * @brief The properties of a SimGrid NetZone, which also contains the properties of its parent zones
+ */
+typedef std::unordered_map<std::string, std::string> ZoneProperties;
+
 /**
  * @brief Represents a machine
  */
@@ -79,7 +88,7 @@ struct Machine
     std::unordered_map<MachineState, long double> time_spent_in_each_state; //!< The cumulated time of the machine in each MachineState
 
     std::unordered_map<std::string, std::string> properties; //!< Properties defined in the platform file
-    std::unordered_map<std::string, std::string> zone_properties; //!< Properties of Zones defined in the platform file
+    std::shared_ptr<const ZoneProperties> zone_properties; //!< Properties of Zones defined in the platform file. Shared by all the machines of a zone
 
     /**
      * @brief Returns whether the Machine has the given role
@@ -112,6 +121,12 @@ struct Machine
      * @param[in] new_state The new state of the machine
      */
     void update_machine_state(MachineState new_state);
+
+    /**
+     * @brief Sets the power state of the machine, keeping the energy accounting of the Machines up to date
+     * @param[in] new_pstate The new power state of the machine
+     */
+    void set_pstate(int new_pstate);
 };
 
 /**
@@ -191,6 +206,12 @@ public:
      */
     void set_tracer(PajeTracer * tracer);
 
+    /**
+     * @brief Sets the BinaryScheduleTracer
+     * @param[in] tracer The BinaryScheduleTracer
+     */
+    void set_binary_schedule_tracer(BinaryScheduleTracer * tracer);
+
     /**
      * @brief Accesses a Machine thanks to its unique number
      * @param[in] machineID The unique machine number
@@ -262,6 +283,23 @@ public:
      */
     long double total_wattmin(const BatsimContext * context) const;
 
+    /**
+     * @brief Computes and returns the energy consumed by one machine since time 0
+     * @details The energy of machines whose power is known to be constant is computed without querying SimGrid
+     * @param[in] machine The machine
+     * @return The energy (in joules) consumed by the machine since time 0
+     */
+    long double consumed_energy_of_machine(const Machine * machine) const;
+
+    /**
+     * @brief Must be called when the power consumption of a machine may have changed
+     * @details This is called on every MachineState transition, power state change or job end on the machine.
+     *          Machines that are idle, sleeping or unavailable (without jobs) have a constant power consumption,
+     *          which allows their energy to be accumulated without querying SimGrid.
+     * @param[in] machine The machine whose power consumption may have changed
+     */
+    void update_machine_energy_tracking(const Machine * machine);
+
     /**
      * @brief Returns the total number of machines
      * @return The total number of machines
@@ -293,22 +331,77 @@ public:
      */
     const std::map<MachineState, int> & nb_machines_in_each_state() const;
 
+    /**
+     * @brief Updates the sets of machines in each state after a MachineState transition
+     * @param[in] machine_id The unique number of the machine whose state changed
+     * @param[in] old_state The old state of the machine
+     * @param[in] new_state The new state of the machine
+     */
+    void update_machines_in_each_state(int machine_id, MachineState old_state, MachineState new_state);
+
+    /**
+     * @brief Updates the set of machines in a computation power state after a power state change
+     * @param[in] machine The machine whose power state changed
+     */
+    void update_machines_in_computation_pstate(const Machine * machine);
+
+    /**
+     * @brief Returns the sets of machines in each state, with each role, computing jobs or in a computation power state
+     * @details The set of machines in a computation power state is only maintained if energy is used
+     * @return A const reference to the machine sets
+     */
+    const MachineSets & machine_sets() const;
+
     /**
      * @brief Add the properties of zones to each machine inside the zone
-     * @param[in] current_zone The considered NetZone of SimGrid
-     * @param[in] parent_properties The properties of the parent zones
+     * @details One property table is built per zone that defines properties, and it is shared by all the machines of the zone
+     * @param[in] root_zone The root NetZone of SimGrid
      */
-    void attach_zone_properties_to_machines(simgrid::s4u::NetZone * current_zone,
-                                            std::unordered_map<std::string, std::string> parent_properties);
+    void attach_zone_properties_to_machines(simgrid::s4u::NetZone * root_zone);
 
 
 private:
     std::vector<Machine *> _machines;       //!< The vector of all machines
     std::vector<Machine *> _storage_nodes;  //!< The vector of storage machines
     std::vector<Machine *> _compute_nodes;  //!< The vector of computing machines
+    std::unordered_map<std::string, Machine *> _machines_by_name; //!< Indexes the machines by their name
     Machine * _master_machine = nullptr;    //!< The master machine
     PajeTracer * _tracer = nullptr;         //!< The PajeTracer
+    BinaryScheduleTracer * _binary_schedule_tracer = nullptr; //!< The BinaryScheduleTracer
     std::map<MachineState, int> _nb_machines_in_each_state; //!< Counts how many machines are in each state
+
+    /**
+     * @brief Builds the property table of a zone and of its children zones
+     * @param[in] current_zone The considered NetZone of SimGrid
+     * @param[in] parent_properties The property table of the parent zone
+     * @param[in,out] zone_properties The property table of each zone
+     */
+    static void build_zone_properties(simgrid::s4u::NetZone * current_zone,
+                                      const std::shared_ptr<const ZoneProperties> & parent_properties,
+                                      std::unordered_map<const simgrid::s4u::NetZone *, std::shared_ptr<const ZoneProperties>> & zone_properties);
+    MachineSets _machine_sets; //!< The sets of machines in each state, role, occupancy and power state
+
+    /**
+     * @brief Initializes the incremental energy accounting once the machines have been created
+     */
+    void initialize_energy_tracking();
+
+    /**
+     * @brief Returns whether the power consumption of a machine can only change on a notified event
+     * @param[in] machine The machine
+     * @return True if and only if the machine is not a storage machine, computes no job and is idle, sleeping or unavailable
+     * @details Storage machines are never stable since their power depends on the I/O transfers (PFS, data staging) they serve,
+     *          which are not notified to the machines.
+     */
+    static bool has_stable_power(const Machine * machine);
+
+    bool _energy_used = false; //!< Whether the incremental energy accounting is enabled
+    std::vector<long double> _wattmin; //!< The wattmin of each machine in its current power state
+    StableEnergyAggregate _stable_energy; //!< The energy of the machines whose power consumption is constant
+    std::set<int> _unstable_machines; //!< The machines whose energy must be queried from SimGrid
+    long double _total_wattmin = 0; //!< The sum of the wattmin of all machines
+    mutable long double _energy_cache_date = -1; //!< The date of the cached total consumed energy
+    mutable long double _energy_cache = 0; //!< The total consumed energy at _energy_cache_date
 };
 
 /**
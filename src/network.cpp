@@ -35,27 +35,40 @@ void request_reply_scheduler_process(BatsimContext * context, std::string send_b
 
         // Send the message
         XBT_INFO("Sending '%s'", message_to_send.c_str());
-        if (zmq_send(context->zmq_socket, message_to_send.data(), message_to_send.size(), 0) == -1)
+        if (context->builtin_scheduler == nullptr &&
+            zmq_send(context->zmq_socket, message_to_send.data(), message_to_send.size(), 0) == -1)
             throw std::runtime_error(std::string("Cannot send message on socket (errno=") + strerror(errno) + ")");
 
         auto start = chrono::steady_clock::now();
         string message_received;
 
         // Get the reply
-        zmq_msg_t msg;
-        zmq_msg_init(&msg);
-        if (zmq_msg_recv(&msg, context->zmq_socket, 0) == -1)
-            throw std::runtime_error(std::string("Cannot read message on socket (errno=") + strerror(errno) + ")");
-
-        string raw_message_received(static_cast<char*>(zmq_msg_data(&msg)), zmq_msg_size(&msg));
-        message_received = raw_message_received;
+        if (context->builtin_scheduler != nullptr)
+        {
+            ProfiledSection profiled(context->server_profiler ? &context->server_profiler->scheduler_wait : nullptr);
+            message_received = context->builtin_scheduler->take_decisions(message_to_send);
+        }
+        else
+        {
+            zmq_msg_t msg;
+            zmq_msg_init(&msg);
+            {
+                ProfiledSection profiled(context->server_profiler ? &context->server_profiler->scheduler_wait : nullptr);
+                if (zmq_msg_recv(&msg, context->zmq_socket, 0) == -1)
+                    throw std::runtime_error(std::string("Cannot read message on socket (errno=") + strerror(errno) + ")");
+            }
+
+            string raw_message_received(static_cast<char*>(zmq_msg_data(&msg)), zmq_msg_size(&msg));
+            message_received = raw_message_received;
+            zmq_msg_close(&msg);
+        }
         XBT_INFO("Received '%s'", message_received.c_str());
-        zmq_msg_close(&msg);
 
         auto end = chrono::steady_clock::now();
         long double elapsed_microseconds = static_cast<long double>(chrono::duration <long double, micro> (end - start).count());
         context->microseconds_used_by_scheduler += elapsed_microseconds;
 
+        ProfiledSection profiled(context->server_profiler ? &context->server_profiler->parse_and_apply_message : nullptr);
         context->proto_reader->parse_and_apply_message(message_received);
     }
     catch(const std::runtime_error & error)
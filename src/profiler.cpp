@@ -0,0 +1,162 @@
+/**
+ * @file profiler.cpp
+ * @brief Wall-clock profiling of Batsim's server loop
+ */
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include <xbt.h>
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "ipp.hpp"
+
+using namespace std;
+
+constexpr int ProfiledStatistics::NB_HISTOGRAM_BUCKETS;
+
+void ProfiledStatistics::add(double seconds, uint64_t nb_allocations_of_call)
+{
+    ++nb_calls;
+    total_seconds += seconds;
+    max_seconds = std::max(max_seconds, seconds);
+    nb_allocations += nb_allocations_of_call;
+    ++histogram[static_cast<size_t>(histogram_bucket(seconds))];
+    quantiles.add(seconds);
+}
+
+int ProfiledStatistics::histogram_bucket(double seconds)
+{
+    const double microseconds = seconds * 1e6;
+    if (!(microseconds >= 1))
+    {
+        return 0;
+    }
+
+    // [2^(i-1),2^i[ µs is in bucket i
+    const int bucket = std::ilogb(microseconds) + 1;
+    return std::min(bucket, NB_HISTOGRAM_BUCKETS - 1);
+}
+
+ProfiledSection::ProfiledSection(ProfiledStatistics * statistics) :
+    _statistics(statistics)
+{
+    if (_statistics != nullptr)
+    {
+        _nb_allocations_at_start = nb_allocations_of_current_thread();
+        _start = chrono::steady_clock::now();
+    }
+}
+
+ProfiledSection::~ProfiledSection()
+{
+    if (_statistics != nullptr)
+    {
+        const chrono::duration<double> elapsed = chrono::steady_clock::now() - _start;
+        _statistics->add(elapsed.count(), nb_allocations_of_current_thread() - _nb_allocations_at_start);
+    }
+}
+
+ProfiledStatistics & ServerProfiler::handler(IPMessageType type)
+{
+    return _handlers[type];
+}
+
+/**
+ * @brief Writes the statistics of a profiled section as a JSON object
+ * @param[in,out] writer The JSON writer
+ * @param[in] statistics The statistics of the section
+ */
+static void write_statistics(rapidjson::PrettyWriter<rapidjson::StringBuffer> & writer,
+                             const ProfiledStatistics & statistics)
+{
+    writer.StartObject();
+    writer.Key("nb_calls");
+    writer.Uint64(statistics.nb_calls);
+    writer.Key("total_time");
+    writer.Double(static_cast<double>(statistics.total_seconds));
+    writer.Key("mean_time");
+    writer.Double(statistics.nb_calls > 0 ? static_cast<double>(statistics.total_seconds / statistics.nb_calls) : 0);
+    writer.Key("max_time");
+    writer.Double(statistics.max_seconds);
+    for (const auto & percentile : {std::make_pair("p50_time", 0.5), std::make_pair("p90_time", 0.9), std::make_pair("p99_time", 0.99)})
+    {
+        writer.Key(percentile.first);
+        if (statistics.nb_calls > 0)
+        {
+            writer.Double(statistics.quantiles.quantile(percentile.second));
+        }
+        else
+        {
+            writer.Null();
+        }
+    }
+    writer.Key("nb_allocations");
+    if (allocations_are_counted())
+    {
+        writer.Uint64(statistics.nb_allocations);
+    }
+    else
+    {
+        writer.Null();
+    }
+
+    // Only the non-empty buckets are written, with their upper bound (null for the last, unbounded one)
+    writer.Key("time_histogram");
+    writer.StartArray();
+    for (int i = 0; i < ProfiledStatistics::NB_HISTOGRAM_BUCKETS; ++i)
+    {
+        if (statistics.histogram[static_cast<size_t>(i)] > 0)
+        {
+            writer.StartObject();
+            writer.Key("time_lt");
+            if (i < ProfiledStatistics::NB_HISTOGRAM_BUCKETS - 1)
+            {
+                writer.Double(std::ldexp(1e-6, i));
+            }
+            else
+            {
+                writer.Null();
+            }
+            writer.Key("nb_calls");
+            writer.Uint64(statistics.histogram[static_cast<size_t>(i)]);
+            writer.EndObject();
+        }
+    }
+    writer.EndArray();
+    writer.EndObject();
+}
+
+void ServerProfiler::write_report(const std::string & filename) const
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+
+    writer.Key("handlers");
+    writer.StartObject();
+    for (const auto & mit : _handlers)
+    {
+        writer.Key(ip_message_type_to_string(mit.first).c_str());
+        write_statistics(writer, mit.second);
+    }
+    writer.EndObject();
+
+    writer.Key("generate_current_message");
+    write_statistics(writer, generate_current_message);
+    writer.Key("scheduler_wait");
+    write_statistics(writer, scheduler_wait);
+    writer.Key("parse_and_apply_message");
+    write_statistics(writer, parse_and_apply_message);
+
+    writer.EndObject();
+
+    ofstream f(filename, ios_base::trunc);
+    xbt_assert(f.is_open(), "Cannot write file '%s'", filename.c_str());
+    f << buffer.GetString() << endl;
+}
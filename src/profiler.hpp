@@ -0,0 +1,117 @@
+/**
+ * @file profiler.hpp
+ * @brief Wall-clock profiling of Batsim's server loop
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "quantile_sketch.hpp"
+
+enum class IPMessageType;
+
+/**
+ * @brief Returns whether the memory allocations are counted
+ * @details They are only counted if Batsim is built with the profile_allocations Meson option
+ * @return Whether the memory allocations are counted
+ */
+bool allocations_are_counted();
+
+/**
+ * @brief Returns the number of memory allocations (operator new calls) done so far by the calling thread
+ * @return The number of memory allocations done so far by the calling thread (always 0 if allocations are not counted)
+ */
+uint64_t nb_allocations_of_current_thread();
+
+/**
+ * @brief The statistics of a profiled code section
+ */
+struct ProfiledStatistics
+{
+    static constexpr int NB_HISTOGRAM_BUCKETS = 32; //!< Bucket 0 counts the calls shorter than 1 µs, bucket i>0 the calls in [2^(i-1),2^i[ µs. The last bucket is unbounded
+
+    /**
+     * @brief Adds a call of the section into the statistics
+     * @param[in] seconds The wall-clock duration of the call, in seconds
+     * @param[in] nb_allocations The number of memory allocations done during the call
+     */
+    void add(double seconds, uint64_t nb_allocations);
+
+    /**
+     * @brief Returns the histogram bucket of a duration
+     * @param[in] seconds The duration, in seconds
+     * @return The index of the histogram bucket of the duration
+     */
+    static int histogram_bucket(double seconds);
+
+    uint64_t nb_calls = 0; //!< The number of calls
+    long double total_seconds = 0; //!< The wall-clock time spent in the section, in seconds
+    double max_seconds = 0; //!< The longest call, in seconds
+    uint64_t nb_allocations = 0; //!< The number of memory allocations done in the section
+    std::array<uint64_t, NB_HISTOGRAM_BUCKETS> histogram{}; //!< The number of calls per duration bucket (see NB_HISTOGRAM_BUCKETS)
+    QuantileSketch quantiles; //!< The distribution of the call durations
+};
+
+/**
+ * @brief Measures the wall-clock time and the memory allocations of a code section, from its construction to its destruction
+ */
+class ProfiledSection
+{
+public:
+    /**
+     * @brief Starts measuring a code section
+     * @param[in,out] statistics The statistics of the section, updated on destruction. Nothing is measured if nullptr
+     */
+    explicit ProfiledSection(ProfiledStatistics * statistics);
+
+    /**
+     * @brief ProfiledSection cannot be copied.
+     * @param[in] other Another instance
+     */
+    ProfiledSection(const ProfiledSection & other) = delete;
+
+    /**
+     * @brief Stops measuring the code section and updates its statistics
+     */
+    ~ProfiledSection();
+
+private:
+    ProfiledStatistics * _statistics; //!< The statistics of the section (nullptr if not measured)
+    std::chrono::steady_clock::time_point _start; //!< The moment at which the section started
+    uint64_t _nb_allocations_at_start = 0; //!< The number of allocations of the thread when the section started
+};
+
+/**
+ * @brief Profiles the server loop: its message handlers and its communications with the decision process
+ * @details Handlers that send an inter-process message may be suspended until the message is received by another actor.
+ *          The time (and the allocations) of the actors that run meanwhile is then counted in the handler.
+ */
+class ServerProfiler
+{
+public:
+    /**
+     * @brief Returns the statistics of the server handler of a message type
+     * @param[in] type The message type
+     * @return The statistics of the handler of type
+     */
+    ProfiledStatistics & handler(IPMessageType type);
+
+    /**
+     * @brief Writes the profiling report into a JSON file
+     * @param[in] filename The name of the output file
+     */
+    void write_report(const std::string & filename) const;
+
+public:
+    ProfiledStatistics generate_current_message; //!< The generation of the messages sent to the decision process
+    ProfiledStatistics scheduler_wait; //!< The wait for the replies of the decision process (in zmq_msg_recv)
+    ProfiledStatistics parse_and_apply_message; //!< The parsing of the replies of the decision process
+
+private:
+    std::map<IPMessageType, ProfiledStatistics> _handlers; //!< The statistics of the server handlers, by message type
+};
@@ -0,0 +1,94 @@
+/**
+ * @file profiler_allocations.cpp
+ * @brief Counting of the memory allocations, used by the profiler
+ * @details The global allocation functions are only replaced if Batsim is built with the profile_allocations Meson option,
+ *          as it would slow every allocation down and conflict with allocators such as tcmalloc or jemalloc.
+ *          They are replaced in their own translation unit, so that the compiler does not see them
+ *          when it inlines the standard containers.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "profiler.hpp"
+
+#ifdef BATSIM_PROFILE_ALLOCATIONS
+
+// The allocations are counted per thread, so that the counter needs no synchronization.
+// It is trivially initialized, so that it can be used by the allocations done before main.
+static thread_local uint64_t thread_nb_allocations = 0; //!< The number of allocations done so far by the thread
+
+/**
+ * @brief Allocates memory, counting the allocations of each thread
+ * @param[in] size The number of bytes to allocate
+ * @return The allocated memory
+ */
+void * operator new(std::size_t size)
+{
+    ++thread_nb_allocations;
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    while (true)
+    {
+        void * memory = std::malloc(size);
+        if (memory != nullptr)
+        {
+            return memory;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+/**
+ * @brief Frees memory allocated by operator new
+ * @param[in] memory The memory to free
+ */
+void operator delete(void * memory) noexcept
+{
+    std::free(memory);
+}
+
+/**
+ * @brief Frees memory allocated by operator new
+ * @param[in] memory The memory to free
+ * @param[in] size The size of the memory to free (unused)
+ */
+void operator delete(void * memory, std::size_t size) noexcept
+{
+    (void) size;
+    std::free(memory);
+}
+
+bool allocations_are_counted()
+{
+    return true;
+}
+
+uint64_t nb_allocations_of_current_thread()
+{
+    return thread_nb_allocations;
+}
+
+#else
+
+bool allocations_are_counted()
+{
+    return false;
+}
+
+uint64_t nb_allocations_of_current_thread()
+{
+    return 0;
+}
+
+#endif
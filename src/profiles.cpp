@@ -721,6 +721,46 @@ ProfilePtr Profile::from_json(const std::string & profile_name,
     return Profile::from_json(profile_name, doc, error_prefix, false);
 }
 
+ProfilePtr Profile::new_delay_profile(const std::string & profile_name,
+                                      double delay)
+{
+    xbt_assert(delay >= 0, "Cannot create the delay profile '%s': its delay (%g) is negative",
+               profile_name.c_str(), delay);
+
+    auto profile = std::make_shared<Profile>();
+    profile->type = ProfileType::DELAY;
+    profile->name = profile_name;
+
+    auto * data = new DelayProfileData;
+    data->delay = delay;
+    profile->data = data;
+
+    return profile;
+}
+
+const std::string & Profile::get_json_description() const
+{
+    if (json_description.empty())
+    {
+        // Only the profiles built without JSON (delay ones) have no description yet
+        xbt_assert(type == ProfileType::DELAY,
+                   "Internal error: profile '%s' has no JSON description", name.c_str());
+        const auto * data_delay = static_cast<const DelayProfileData *>(data);
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.StartObject();
+        writer.Key("type");
+        writer.String("delay");
+        writer.Key("delay");
+        writer.Double(data_delay->delay);
+        writer.EndObject();
+        json_description = string(buffer.GetString(), buffer.GetSize());
+    }
+
+    return json_description;
+}
+
 bool Profile::is_parallel_task() const
 {
     return (type == ProfileType::PARALLEL) ||
@@ -47,7 +47,7 @@ struct Profile
 
     ProfileType type; //!< The type of the profile
     void * data; //!< The associated data
-    std::string json_description; //!< The JSON description of the profile
+    mutable std::string json_description; //!< The JSON description of the profile. Profiles built by Profile::new_delay_profile only have it once get_json_description has been called
     std::string name; //!< the profile unique name
     int return_code = 0;  //!< The return code of this profile's execution (SUCCESS == 0)
 
@@ -79,6 +79,22 @@ struct Profile
                                const std::string & json_str,
                                const std::string & error_prefix = "Invalid JSON profile");
 
+    /**
+     * @brief Creates a new-allocated DELAY Profile, without going through JSON
+     * @details The JSON description of the profile is only synthesized if get_json_description is called
+     * @param[in] profile_name The name of the profile
+     * @param[in] delay The time amount, in seconds, that the profile takes. Zero is allowed (e.g., for empty workflow tasks)
+     * @return The new-allocated Profile
+     */
+    static ProfilePtr new_delay_profile(const std::string & profile_name,
+                                        double delay);
+
+    /**
+     * @brief Returns the JSON description of the profile, synthesizing it from the profile data if needed
+     * @return The JSON description of the profile
+     */
+    const std::string & get_json_description() const;
+
     /**
      * @brief Returns whether a profile is a parallel task (or its derivatives)
      * @return Whether a profile is a parallel task (or its derivatives)
@@ -154,7 +154,7 @@ void JsonProtocolWriter::append_simulation_begins(Machines & machines,
             if (profile.second.get() != nullptr) // unused profiles may have been removed from memory at workload loading time.
             {
                 Document profile_description_doc;
-                const string & profile_json_description = profile.second->json_description;
+                const string & profile_json_description = profile.second->get_json_description();
                 profile_description_doc.Parse(profile_json_description.c_str());
                 profile_dict.AddMember(
                         Value().SetString(profile.first.c_str(), _alloc),
@@ -193,11 +193,14 @@ Value JsonProtocolWriter::machine_to_json_value(const Machine & machine)
     machine_doc.AddMember("properties", properties, _alloc);
 
     Value zone_properties(rapidjson::kObjectType);
-    for(auto const &entry : machine.zone_properties)
+    if (machine.zone_properties != nullptr)
     {
-        rapidjson::Value key(entry.first.c_str(), _alloc);
-        rapidjson::Value value(entry.second.c_str(), _alloc);
-        zone_properties.AddMember(key, value, _alloc);
+        for(auto const &entry : *machine.zone_properties)
+        {
+            rapidjson::Value key(entry.first.c_str(), _alloc);
+            rapidjson::Value value(entry.second.c_str(), _alloc);
+            zone_properties.AddMember(key, value, _alloc);
+        }
     }
     machine_doc.AddMember("zone_properties", zone_properties, _alloc);
 
@@ -1059,7 +1062,7 @@ void JsonProtocolReader::handle_execute_job(int event_number,
             {
                 xbt_die("The given profile name '%s' already exists! Already registered profile: %s",
                         profile_name.c_str(),
-                        workload->profiles->at(profile_name)->json_description.c_str());
+                        workload->profiles->at(profile_name)->get_json_description().c_str());
             }
             else
             {
@@ -1419,8 +1422,8 @@ void JsonProtocolReader::handle_register_job(int event_number,
     {
         xbt_assert(context->redis_enabled, "Invalid JSON message: in event %d (REGISTER_JOB): ['data']['job'] is unset but redis seems disabled...", event_number);
 
-        string job_key = RedisStorage::job_key(job_id);
-        message->job_description = context->storage.get(job_key);
+        string job_key = Storage::job_key(job_id);
+        message->job_description = context->storage->get(job_key);
     }
 
     // Load job into memory. TODO: this should be between the protocol parsing and the injection in the events, not here.
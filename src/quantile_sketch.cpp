@@ -0,0 +1,111 @@
+/**
+ * @file quantile_sketch.cpp
+ * @brief Streaming quantile estimation
+ */
+
+#include "quantile_sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <xbt.h>
+
+using namespace std;
+
+constexpr double QuantileSketch::min_positive_value;
+
+QuantileSketch::QuantileSketch(double relative_accuracy, size_t max_nb_buckets) :
+    _gamma((1 + relative_accuracy) / (1 - relative_accuracy)),
+    _log_gamma(std::log(_gamma)),
+    _max_nb_buckets(max_nb_buckets)
+{
+    xbt_assert(relative_accuracy > 0 && relative_accuracy < 1,
+               "Invalid quantile sketch relative accuracy (%g)", relative_accuracy);
+    xbt_assert(max_nb_buckets > 0, "Invalid quantile sketch maximum number of buckets (%zu)", max_nb_buckets);
+}
+
+void QuantileSketch::add(double value)
+{
+    ++_count;
+    if (!(value >= min_positive_value))
+    {
+        ++_zero_count;
+        return;
+    }
+
+    const int index = bucket_index(value);
+    if (_buckets.empty())
+    {
+        _min_index = index;
+        _buckets.push_back(1);
+        return;
+    }
+
+    const int max_index = _min_index + static_cast<int>(_buckets.size()) - 1;
+    if (index >= _min_index && index <= max_index)
+    {
+        ++_buckets[static_cast<size_t>(index - _min_index)];
+        return;
+    }
+
+    // The range of buckets must be extended. If it becomes too large, the lowest buckets are merged
+    const int new_max_index = std::max(max_index, index);
+    const int new_min_index = std::max(std::min(_min_index, index),
+                                       new_max_index - static_cast<int>(_max_nb_buckets) + 1);
+
+    std::vector<uint64_t> new_buckets(static_cast<size_t>(new_max_index - new_min_index + 1), 0);
+    for (size_t i = 0; i < _buckets.size(); ++i)
+    {
+        const int old_index = _min_index + static_cast<int>(i);
+        new_buckets[static_cast<size_t>(std::max(old_index, new_min_index) - new_min_index)] += _buckets[i];
+    }
+    new_buckets[static_cast<size_t>(std::max(index, new_min_index) - new_min_index)] += 1;
+
+    _buckets.swap(new_buckets);
+    _min_index = new_min_index;
+}
+
+double QuantileSketch::quantile(double q) const
+{
+    xbt_assert(q >= 0 && q <= 1, "Invalid quantile (%g)", q);
+    if (_count == 0)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // The rank (starting at 0) of the value to return
+    const double rank = q * static_cast<double>(_count - 1);
+    if (rank < static_cast<double>(_zero_count))
+    {
+        return 0;
+    }
+
+    uint64_t nb_values_below = _zero_count;
+    for (size_t i = 0; i < _buckets.size(); ++i)
+    {
+        nb_values_below += _buckets[i];
+        if (static_cast<double>(nb_values_below) > rank)
+        {
+            return bucket_value(_min_index + static_cast<int>(i));
+        }
+    }
+
+    return bucket_value(_min_index + static_cast<int>(_buckets.size()) - 1);
+}
+
+uint64_t QuantileSketch::count() const
+{
+    return _count;
+}
+
+int QuantileSketch::bucket_index(double value) const
+{
+    // Bucket i contains the values in ]gamma^(i-1), gamma^i]
+    return static_cast<int>(std::ceil(std::log(value) / _log_gamma));
+}
+
+double QuantileSketch::bucket_value(int index) const
+{
+    return 2 * std::pow(_gamma, index) / (_gamma + 1);
+}
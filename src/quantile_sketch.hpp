@@ -0,0 +1,73 @@
+/**
+ * @file quantile_sketch.hpp
+ * @brief Streaming quantile estimation
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Estimates the quantiles of a stream of non-negative values in bounded memory (DDSketch)
+ * @details Values are counted in buckets whose bounds grow geometrically, so that every quantile is estimated with
+ *          a bounded relative error. When more than max_nb_buckets buckets are needed, the lowest buckets are merged,
+ *          which only degrades the accuracy of the lowest quantiles.
+ *          Values smaller than min_positive_value (including negative ones) are counted as zeros.
+ */
+class QuantileSketch
+{
+public:
+    /**
+     * @brief Builds an empty QuantileSketch
+     * @param[in] relative_accuracy The maximum relative error of the estimated quantiles, in ]0,1[
+     * @param[in] max_nb_buckets The maximum number of buckets
+     */
+    explicit QuantileSketch(double relative_accuracy = 0.01, size_t max_nb_buckets = 2048);
+
+    /**
+     * @brief Adds a value into the sketch
+     * @param[in] value The value
+     */
+    void add(double value);
+
+    /**
+     * @brief Estimates a quantile of the values added so far
+     * @param[in] q The quantile, in [0,1] (e.g., 0.5 for the median)
+     * @return The estimated quantile, or NaN if no value has been added
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief Returns the number of values added so far
+     * @return The number of values added so far
+     */
+    uint64_t count() const;
+
+    static constexpr double min_positive_value = 1e-9; //!< The smallest value that is not counted as a zero
+
+private:
+    /**
+     * @brief Returns the index of the bucket of a positive value
+     * @param[in] value The value
+     * @return The index of the bucket of value
+     */
+    int bucket_index(double value) const;
+
+    /**
+     * @brief Returns the value that represents a bucket (the one that minimizes the relative error within the bucket)
+     * @param[in] index The bucket index
+     * @return The value that represents the bucket
+     */
+    double bucket_value(int index) const;
+
+private:
+    double _gamma;                  //!< The ratio between the upper and the lower bounds of each bucket
+    double _log_gamma;              //!< log(_gamma)
+    size_t _max_nb_buckets;         //!< The maximum number of buckets
+    std::vector<uint64_t> _buckets; //!< The counts of the buckets, from index _min_index to _min_index + _buckets.size() - 1
+    int _min_index = 0;             //!< The index of the first bucket
+    uint64_t _zero_count = 0;       //!< The number of values counted as zeros
+    uint64_t _count = 0;            //!< The number of values
+};
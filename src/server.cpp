@@ -36,7 +36,11 @@ void server_process(BatsimContext * context)
                                                     context->allow_storage_sharing,
                                                     simgrid::s4u::Engine::get_clock());
 
-    string send_buffer = context->proto_writer->generate_current_message(simgrid::s4u::Engine::get_clock());
+    string send_buffer;
+    {
+        ProfiledSection profiled(context->server_profiler ? &context->server_profiler->generate_current_message : nullptr);
+        send_buffer = context->proto_writer->generate_current_message(simgrid::s4u::Engine::get_clock());
+    }
     context->proto_writer->clear();
 
     simgrid::s4u::Actor::create("Scheduler REQ-REP", simgrid::s4u::this_actor::get_host(),
@@ -72,6 +76,7 @@ void server_process(BatsimContext * context)
     handler_map[IPMessageType::END_DYNAMIC_REGISTER] = server_on_end_dynamic_register;
     handler_map[IPMessageType::CONTINUE_DYNAMIC_REGISTER] = server_on_continue_dynamic_register;
     handler_map[IPMessageType::EVENT_OCCURRED] = server_on_event_occurred;
+    handler_map[IPMessageType::TIMELINE_SUBMITTED] = server_on_timeline_submitted;
 
     /* Currently, there is one job submtiter per input file (workload or workflow).
        As workflows use an inner workload, calling nb_static_workloads() should
@@ -82,7 +87,7 @@ void server_process(BatsimContext * context)
     data->submitter_counters[SubmitterType::JOB_SUBMITTER] = job_counters;
 
     ServerData::SubmitterCounters event_counters;
-    event_counters.expected_nb_submitters = static_cast<unsigned int>(context->event_lists.size());
+    event_counters.expected_nb_submitters = (context->event_stream != nullptr) ? 1 : 0;
     data->submitter_counters[SubmitterType::EVENT_SUBMITTER] = event_counters;
 
     data->jobs_to_be_deleted.clear();
@@ -100,7 +105,10 @@ void server_process(BatsimContext * context)
                    "The server does not know how to handle message type %s.",
                    ip_message_type_to_string(message->type).c_str());
         auto handler_function = handler_map[message->type];
-        handler_function(data, message);
+        {
+            ProfiledSection profiled(context->server_profiler ? &context->server_profiler->handler(message->type) : nullptr);
+            handler_function(data, message);
+        }
 
         // Delete the message
         delete message;
@@ -138,6 +146,9 @@ void server_process(BatsimContext * context)
     } // end of while
 
     XBT_INFO("Simulation is finished!");
+    XBT_INFO("%u job executors have been created (%u are idle)",
+             data->job_executor_pool.nb_created_executors(), data->job_executor_pool.nb_idle_executors());
+    data->job_executor_pool.stop();
 
     // Is simulation also finished for the decision process?
     xbt_assert(data->end_of_simulation_sent, "Left simulation loop, but the SIMULATION_ENDS message has not been sent to the scheduler.");
@@ -158,7 +169,11 @@ void server_process(BatsimContext * context)
 
 void generate_and_send_message(ServerData * data)
 {
-    string send_buffer = data->context->proto_writer->generate_current_message(simgrid::s4u::Engine::get_clock());
+    string send_buffer;
+    {
+        ProfiledSection profiled(data->context->server_profiler ? &data->context->server_profiler->generate_current_message : nullptr);
+        send_buffer = data->context->proto_writer->generate_current_message(simgrid::s4u::Engine::get_clock());
+    }
     data->context->proto_writer->clear();
 
     simgrid::s4u::Actor::create("Scheduler REQ-REP", simgrid::s4u::this_actor::get_host(),
@@ -311,10 +326,10 @@ void server_on_job_submitted(ServerData * data,
 
         if (!data->context->redis_enabled)
         {
-            job_json_description = job->json_description;
+            job_json_description = job->get_json_description();
             if (data->context->submission_forward_profiles)
             {
-                profile_json_description = job->profile->json_description;
+                profile_json_description = job->profile->get_json_description();
             }
         }
 
@@ -421,6 +436,37 @@ void server_on_event_occurred(ServerData * data,
     }
 }
 
+void server_on_timeline_submitted(ServerData * data,
+                                  IPMessage * task_data)
+{
+    xbt_assert(task_data->data != nullptr, "inconsistency: task_data has null data");
+    auto * message = static_cast<TimelineSubmittedMessage *>(task_data->data);
+
+    // The grouped messages are handled as if they had been received one after the other,
+    // but the scheduler is only called once all of them have been handled
+    for (IPMessage * grouped_message : message->messages)
+    {
+        switch(grouped_message->type)
+        {
+        case IPMessageType::SUBMITTER_HELLO:
+            server_on_submitter_hello(data, grouped_message);
+            break;
+        case IPMessageType::JOB_SUBMITTED:
+            server_on_job_submitted(data, grouped_message);
+            break;
+        case IPMessageType::EVENT_OCCURRED:
+            server_on_event_occurred(data, grouped_message);
+            break;
+        case IPMessageType::SUBMITTER_BYE:
+            server_on_submitter_bye(data, grouped_message);
+            break;
+        default:
+            xbt_die("inconsistency: a TIMELINE_SUBMITTED message cannot contain a %s message",
+                    ip_message_type_to_string(grouped_message->type).c_str());
+        }
+    }
+}
+
 void server_on_pstate_modification(ServerData * data,
                                    IPMessage * task_data)
 {
@@ -472,7 +518,7 @@ void server_on_pstate_modification(ServerData * data,
             {
                 XBT_INFO("Switching machine %d ('%s') pstate : %lu -> %lu.", machine->id,
                          machine->name.c_str(), curr_pstate, message->new_pstate);
-                machine->host->set_pstate(message->new_pstate);
+                machine->set_pstate(static_cast<int>(message->new_pstate));
                 xbt_assert(machine->host->get_pstate() == message->new_pstate, "pstate inconsistency: the desired pstate has not been set");
 
                 IntervalSet all_switched_machines;
@@ -701,10 +747,10 @@ void server_on_register_job(ServerData * data,
 
         if (!data->context->redis_enabled)
         {
-            job_json_description = job->json_description;
+            job_json_description = job->get_json_description();
             if (data->context->submission_forward_profiles)
             {
-                profile_json_description = job->profile->json_description;
+                profile_json_description = job->profile->get_json_description();
             }
         }
 
@@ -948,63 +994,61 @@ void server_on_execute_job(ServerData * data,
     data->nb_running_jobs++;
     xbt_assert(data->nb_running_jobs <= data->nb_submitted_jobs, "inconsistency: nb_running_jobs > nb_submitted_jobs");
 
-    if (!data->context->allow_compute_sharing || !data->context->allow_storage_sharing)
+    // The allocation is checked as a whole against the machine sets maintained by Machines
+    const Machines & machines = data->context->machines;
+    const MachineSets & machine_sets = machines.machine_sets();
+    const IntervalSet & alloc_machines = allocation->machine_ids;
+
+    if (!data->context->allow_compute_sharing)
     {
-        for (auto machine_id_it = allocation->machine_ids.elements_begin(); machine_id_it != allocation->machine_ids.elements_end(); ++machine_id_it)
-        {
-            int machine_id = *machine_id_it;
-            const Machine * machine = data->context->machines[machine_id];
-            if (machine->has_role(roles::Permissions::COMPUTE_NODE) && !data->context->allow_compute_sharing)
-            {
-                (void) machine; // Avoids a warning if assertions are ignored
-                xbt_assert(machine->jobs_being_computed.empty(),
-                           "Job '%s': Invalid allocation ('%s'): machine %d (hostname='%s') is currently computing jobs (these ones:"
-                           " {%s}) whereas time-sharing on compute machines is disabled (rerun with --help to display the available options).",
-                           job->id.to_cstring(),
-                           allocation->machine_ids.to_string_hyphen().c_str(),
-                           machine->id, machine->name.c_str(),
-                           machine->jobs_being_computed_as_string().c_str());
-            }
-            if (machine->has_role(roles::Permissions::STORAGE) && !data->context->allow_storage_sharing)
-            {
-                (void) machine; // Avoids a warning if assertions are ignored
-                xbt_assert(machine->jobs_being_computed.empty(),
-                           "Job '%s': Invalid allocation ('%s'): machine %d (hostname='%s') is currently computing jobs (these ones:"
-                           " {%s}) whereas time-sharing on storage machines is disabled (rerun with --help to display the available options).",
-                           job->id.to_cstring(),
-                           allocation->machine_ids.to_string_hyphen().c_str(),
-                           machine->id, machine->name.c_str(),
-                           machine->jobs_being_computed_as_string().c_str());
-            }
-        }
+        IntervalSet busy_machines = machine_sets.busy_compute_machines(alloc_machines);
+        const Machine * machine = busy_machines.size() > 0 ? machines[busy_machines.first_element()] : nullptr;
+        (void) machine; // Avoids a warning if assertions are ignored
+        xbt_assert(machine == nullptr,
+                   "Job '%s': Invalid allocation ('%s'): machine %d (hostname='%s') is currently computing jobs (these ones:"
+                   " {%s}) whereas time-sharing on compute machines is disabled (rerun with --help to display the available options).",
+                   job->id.to_cstring(),
+                   alloc_machines.to_string_hyphen().c_str(),
+                   machine->id, machine->name.c_str(),
+                   machine->jobs_being_computed_as_string().c_str());
     }
-
-    // Check that every machine can compute the job
-    for (auto machine_id_it = allocation->machine_ids.elements_begin(); machine_id_it != allocation->machine_ids.elements_end(); ++machine_id_it)
+    if (!data->context->allow_storage_sharing)
     {
-        int machine_id = *machine_id_it;
-        Machine * machine = data->context->machines[machine_id];
-
-        xbt_assert(machine->state == MachineState::COMPUTING || machine->state == MachineState::IDLE,
-                   "Job '%s': Invalid job allocation ('%s'): machine %d (hostname='%s') cannot compute jobs now "
-                   "(the machine is not computing nor idle, its state is '%s')",
+        IntervalSet busy_machines = machine_sets.busy_storage_machines(alloc_machines);
+        const Machine * machine = busy_machines.size() > 0 ? machines[busy_machines.first_element()] : nullptr;
+        (void) machine; // Avoids a warning if assertions are ignored
+        xbt_assert(machine == nullptr,
+                   "Job '%s': Invalid allocation ('%s'): machine %d (hostname='%s') is currently computing jobs (these ones:"
+                   " {%s}) whereas time-sharing on storage machines is disabled (rerun with --help to display the available options).",
                    job->id.to_cstring(),
-                   allocation->machine_ids.to_string_hyphen().c_str(),
+                   alloc_machines.to_string_hyphen().c_str(),
                    machine->id, machine->name.c_str(),
-                   machine_state_to_string(machine->state).c_str());
+                   machine->jobs_being_computed_as_string().c_str());
+    }
 
-        if (data->context->energy_used)
-        {
+    // Check that every machine can compute the job
+    IntervalSet unusable_machines = machine_sets.unusable_machines(alloc_machines);
+    const Machine * unusable_machine = unusable_machines.size() > 0 ? machines[unusable_machines.first_element()] : nullptr;
+    (void) unusable_machine; // Avoids a warning if assertions are ignored
+    xbt_assert(unusable_machine == nullptr,
+               "Job '%s': Invalid job allocation ('%s'): machine %d (hostname='%s') cannot compute jobs now "
+               "(the machine is not computing nor idle, its state is '%s')",
+               job->id.to_cstring(),
+               alloc_machines.to_string_hyphen().c_str(),
+               unusable_machine->id, unusable_machine->name.c_str(),
+               machine_state_to_string(unusable_machine->state).c_str());
+
+    if (data->context->energy_used)
+    {
         // Check that every machine is in a computation pstate
-        int ps = machine->host->get_pstate();
-        (void) ps; // Avoids a warning if assertions are ignored
-        xbt_assert(machine->has_pstate(ps), "machine %d has no pstate %d", machine_id, ps);
-        xbt_assert(machine->pstates[ps] == PStateType::COMPUTATION_PSTATE,
+        IntervalSet non_computing_machines = machine_sets.machines_not_in_computation_pstate(alloc_machines);
+        const Machine * machine = non_computing_machines.size() > 0 ? machines[non_computing_machines.first_element()] : nullptr;
+        (void) machine; // Avoids a warning if assertions are ignored
+        xbt_assert(machine == nullptr,
                    "Job '%s': Invalid job allocation ('%s'): machine %d (hostname='%s') is not in a computation pstate (ps=%d)",
                    job->id.to_cstring(),
-                   allocation->machine_ids.to_string_hyphen().c_str(),
-                   machine->id, machine->name.c_str(), ps);
-        }
+                   alloc_machines.to_string_hyphen().c_str(),
+                   machine->id, machine->name.c_str(), static_cast<int>(machine->host->get_pstate()));
     }
 
     // Only PARALLEL_HOMOGENEOUS_TOTAL_AMOUNT profile, or a sequence of those profile, are able to manage the following scenario:
@@ -1047,10 +1091,7 @@ void server_on_execute_job(ServerData * data,
         }
     }
 
-    string pname = "job_" + job->id.to_string();
-    auto actor = simgrid::s4u::Actor::create(pname.c_str(),
-                                             data->context->machines[allocation->machine_ids.first_element()]->host,
-                                             execute_job_process, data->context, allocation, true, message->io_profile);
+    auto actor = data->job_executor_pool.execute_job(data->context, allocation, message->io_profile);
     job->execution_actors.insert(actor);
 }
 
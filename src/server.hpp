@@ -9,6 +9,7 @@
 #include <map>
 
 #include "ipp.hpp"
+#include "jobs_execution.hpp"
 
 struct BatsimContext;
 
@@ -55,6 +56,7 @@ struct ServerData
     std::unordered_map<SubmitterType, SubmitterCounters> submitter_counters; //!< A map of counters for Job, Event and Workflow Submitters
     std::map<JobIdentifier, Submitter*> origin_of_jobs; //!< Stores whether a Submitter must be notified on job completion
     std::vector<JobIdentifier> jobs_to_be_deleted; //!< Stores the job_ids to be deleted after sending a message
+    JobExecutorPool job_executor_pool; //!< The actors in charge of executing the jobs
 };
 
 /**
@@ -142,6 +144,14 @@ void server_on_event_generic(ServerData * data,
 void server_on_event_occurred(ServerData * data,
                               IPMessage * task_data);
 
+/**
+ * @brief Server TIMELINE_SUBMITTED handler
+ * @param[in,out] data The data associated with the server_process
+ * @param[in,out] task_data The data associated with the message the server received
+ */
+void server_on_timeline_submitted(ServerData * data,
+                                  IPMessage * task_data);
+
 
 /**
  * @brief Server PSTATE_MODIFICATION handler
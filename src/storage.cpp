@@ -1,16 +1,77 @@
 /**
  * @file storage.cpp
- * @brief Contains data storage (Redis) related methods implementation
+ * @brief Contains data storage (Redis, in-process, Unix socket) related methods implementation
  */
 
 #include "storage.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
 #include <xbt.h>
 
 using namespace std;
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(redis, "redis"); //!< Logging
 
+constexpr size_t RedisStorage::_max_nb_keys_per_command;
+
+/* Part related to Storage */
+
+bool Storage::set_many(const std::vector<std::pair<std::string, std::string>> & key_values)
+{
+    bool ret = true;
+    for (const auto & key_value : key_values)
+    {
+        ret = set(key_value.first, key_value.second) && ret;
+    }
+    return ret;
+}
+
+void Storage::set_instance_key_prefix(const std::string & key_prefix)
+{
+    _instance_key_prefix = key_prefix;
+}
+
+std::string Storage::instance_key_prefix() const
+{
+    return _instance_key_prefix;
+}
+
+std::string Storage::key_subparts_separator() const
+{
+    return _key_subparts_separator;
+}
+
+std::string Storage::job_key(const JobIdentifier &job_id)
+{
+    std::string key = "job_" + job_id.to_string();
+    return key;
+}
+
+std::string Storage::profile_key(const std::string &workload_name,
+                                 const std::string &profile_name)
+{
+    std::string key = "profile_" + workload_name + '!' + profile_name;
+    return key;
+}
+
+std::string Storage::build_key(const std::string & user_given_key) const
+{
+    return _instance_key_prefix + _key_subparts_separator + user_given_key;
+}
+
+
+/* Part related to RedisStorage */
+
 RedisStorage::RedisStorage()
 {
     //TODO: wrap redox logging into simgrid?
@@ -24,11 +85,6 @@ RedisStorage::~RedisStorage()
     }
 }
 
-void RedisStorage::set_instance_key_prefix(const std::string & key_prefix)
-{
-    _instance_key_prefix = key_prefix;
-}
-
 void RedisStorage::connect_to_server(const std::string & host,
                                      int port,
                                      std::function<void (int)> connection_callback)
@@ -73,12 +129,15 @@ bool RedisStorage::set(const std::string &key, const std::string &value)
     string real_key = build_key(key); // todo: to_utf8?
     string real_value = value; // todo: to_utf8?
 
-    xbt_assert(_is_connected, "Bad RedisStorage::get call: Not connected");
+    xbt_assert(_is_connected, "Bad RedisStorage::set call: Not connected");
     bool ret = _redox.set(real_key, real_value);
     if (ret)
     {
-        XBT_INFO("Set: '%s'='%s'", real_key.c_str(), real_value.c_str());
-        xbt_assert(get(key) == value, "Batsim <-> Redis communications are inconsistent!");
+        XBT_DEBUG("Set: '%s'='%s'", real_key.c_str(), real_value.c_str());
+        if (_check_writes)
+        {
+            xbt_assert(get(key) == value, "Batsim <-> Redis communications are inconsistent!");
+        }
     }
     else
     {
@@ -88,38 +147,501 @@ bool RedisStorage::set(const std::string &key, const std::string &value)
     return ret;
 }
 
+bool RedisStorage::set_many(const std::vector<std::pair<std::string, std::string>> & key_values)
+{
+    xbt_assert(_is_connected, "Bad RedisStorage::set_many call: Not connected");
+    bool ret = true;
+
+    // Very big batches are split so that each command remains reasonably small
+    std::vector<std::string> command;
+    for (size_t first = 0; first < key_values.size(); first += _max_nb_keys_per_command)
+    {
+        const size_t last = std::min(key_values.size(), first + _max_nb_keys_per_command);
+
+        command.clear();
+        command.reserve(1 + 2 * (last - first));
+        command.push_back("MSET");
+        for (size_t i = first; i < last; ++i)
+        {
+            command.push_back(build_key(key_values[i].first)); // todo: to_utf8?
+            command.push_back(key_values[i].second); // todo: to_utf8?
+        }
+
+        auto & reply = _redox.commandSync<std::string>(command);
+        if (reply.ok())
+        {
+            XBT_DEBUG("Set %zu keys (first: '%s')", last - first, command[1].c_str());
+        }
+        else
+        {
+            XBT_WARN("Couldn't set %zu keys (first: '%s')", last - first, command[1].c_str());
+            ret = false;
+        }
+        reply.free();
+    }
+
+    if (ret && _check_writes)
+    {
+        for (const auto & key_value : key_values)
+        {
+            xbt_assert(get(key_value.first) == key_value.second, "Batsim <-> Redis communications are inconsistent!");
+        }
+    }
+
+    return ret;
+}
+
 bool RedisStorage::del(const std::string &key)
 {
     xbt_assert(_is_connected, "Bad RedisStorage::get call: Not connected");
     return _redox.del(build_key(key));
 }
 
-std::string RedisStorage::instance_key_prefix() const
+void RedisStorage::set_write_check(bool check_writes)
 {
-    return _instance_key_prefix;
+    _check_writes = check_writes;
 }
 
-std::string RedisStorage::key_subparts_separator() const
+
+/* Part related to InProcessStorage */
+
+std::string InProcessStorage::get(const std::string & key)
 {
-    return _key_subparts_separator;
+    string real_key = build_key(key);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _values.find(real_key);
+    if (it == _values.end())
+    {
+        XBT_ERROR("Couldn't get the value associated to key '%s' in the storage: it does not exist",
+                  real_key.c_str());
+        return "";
+    }
+    return it->second;
 }
 
-std::string RedisStorage::job_key(const JobIdentifier &job_id)
+bool InProcessStorage::set(const std::string & key, const std::string & value)
 {
-    std::string key = "job_" + job_id.to_string();
-    return key;
+    string real_key = build_key(key);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _values[real_key] = value;
+    XBT_DEBUG("Set: '%s'='%s'", real_key.c_str(), value.c_str());
+    return true;
 }
 
-std::string RedisStorage::profile_key(const std::string &workload_name,
-                                        const std::string &profile_name)
+bool InProcessStorage::set_many(const std::vector<std::pair<std::string, std::string>> & key_values)
 {
-    std::string key = "profile_" + workload_name + '!' + profile_name;
-    return key;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto & key_value : key_values)
+    {
+        _values[build_key(key_value.first)] = key_value.second;
+    }
+    XBT_DEBUG("Set %zu keys", key_values.size());
+    return true;
 }
 
+bool InProcessStorage::del(const std::string & key)
+{
+    string real_key = build_key(key);
 
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _values.erase(real_key) > 0;
+}
+
+
+/* Part related to UnixSocketStorage */
 
-std::string RedisStorage::build_key(const std::string & user_given_key) const
+UnixSocketStorage::UnixSocketStorage(const std::string & socket_path) :
+    _socket_path(socket_path)
 {
-    return _instance_key_prefix + _key_subparts_separator + user_given_key;
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    xbt_assert(socket_path.size() < sizeof(address.sun_path),
+               "Invalid storage socket path '%s': it must be shorter than %zu characters",
+               socket_path.c_str(), sizeof(address.sun_path));
+    strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+    _listening_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    xbt_assert(_listening_socket != -1, "Cannot create the storage socket: %s", strerror(errno));
+
+    // A socket left by a previous execution would prevent bind from succeeding
+    unlink(socket_path.c_str());
+    int ret = bind(_listening_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    xbt_assert(ret == 0, "Cannot bind the storage socket to '%s': %s", socket_path.c_str(), strerror(errno));
+    ret = listen(_listening_socket, 16);
+    xbt_assert(ret == 0, "Cannot listen on the storage socket '%s': %s", socket_path.c_str(), strerror(errno));
+
+    ret = pipe(_stop_pipe);
+    xbt_assert(ret == 0, "Cannot create a pipe: %s", strerror(errno));
+    (void) ret; // Avoids a warning if assertions are ignored
+
+    _server_thread = std::thread(&UnixSocketStorage::server_thread_loop, this);
+    XBT_INFO("Serving the storage on Unix socket '%s'", socket_path.c_str());
+}
+
+UnixSocketStorage::~UnixSocketStorage()
+{
+    // Wakes the server thread up, which then closes every connection
+    const char stop = 0;
+    ssize_t nb_written = write(_stop_pipe[1], &stop, 1);
+    (void) nb_written;
+    _server_thread.join();
+
+    close(_stop_pipe[0]);
+    close(_stop_pipe[1]);
+    close(_listening_socket);
+    unlink(_socket_path.c_str());
+}
+
+/**
+ * @brief Reads a line terminated by CRLF in data received from a client
+ * @param[in] input The received data
+ * @param[in,out] pos The position of the line. Updated to the position after the CRLF if the line is complete
+ * @param[out] line The line, without the CRLF
+ * @return Whether the line is complete
+ */
+static bool read_resp_line(const std::string & input, size_t & pos, std::string & line)
+{
+    size_t end = input.find("\r\n", pos);
+    if (end == std::string::npos)
+    {
+        return false;
+    }
+    line = input.substr(pos, end - pos);
+    pos = end + 2;
+    return true;
+}
+
+/**
+ * @brief Reads a non-negative integer from the header line of an array or of a bulk string
+ * @param[in] line The line, type character included (e.g., "$12")
+ * @param[in] type The expected type character
+ * @param[in] max_value The maximum accepted value
+ * @return The integer, or -1 if the line is invalid
+ */
+static long long read_resp_length(const std::string & line, char type, long long max_value)
+{
+    if (line.size() < 2 || line.size() > 12 || line[0] != type)
+    {
+        return -1;
+    }
+
+    long long value = 0;
+    for (size_t i = 1; i < line.size(); ++i)
+    {
+        if (line[i] < '0' || line[i] > '9')
+        {
+            return -1;
+        }
+        value = value * 10 + (line[i] - '0');
+    }
+    return value <= max_value ? value : -1;
+}
+
+int UnixSocketStorage::parse_command(std::string & input, std::vector<std::string> & args)
+{
+    size_t pos = 0;
+    std::string line;
+    if (!read_resp_line(input, pos, line))
+    {
+        return 0;
+    }
+
+    const long long nb_args = read_resp_length(line, '*', 1024*1024);
+    if (nb_args < 1)
+    {
+        return -1;
+    }
+
+    args.clear();
+    for (long long i = 0; i < nb_args; ++i)
+    {
+        if (!read_resp_line(input, pos, line))
+        {
+            return 0;
+        }
+
+        const long long length = read_resp_length(line, '$', 512*1024*1024);
+        if (length < 0)
+        {
+            return -1;
+        }
+        if (input.size() < pos + static_cast<size_t>(length) + 2)
+        {
+            return 0;
+        }
+        if (input.compare(pos + static_cast<size_t>(length), 2, "\r\n") != 0)
+        {
+            return -1;
+        }
+
+        args.emplace_back(input, pos, static_cast<size_t>(length));
+        pos += static_cast<size_t>(length) + 2;
+    }
+
+    input.erase(0, pos);
+    return 1;
+}
+
+/**
+ * @brief Appends a bulk string reply
+ * @param[in,out] reply The reply
+ * @param[in] value The string
+ */
+static void append_bulk_string(std::string & reply, const std::string & value)
+{
+    reply += '$';
+    reply += std::to_string(value.size());
+    reply += "\r\n";
+    reply += value;
+    reply += "\r\n";
+}
+
+bool UnixSocketStorage::execute_command(const std::vector<std::string> & args, std::string & reply)
+{
+    std::string name = args[0];
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    const size_t nb_args = args.size();
+
+    auto wrong_nb_args = [&reply, &args]()
+    {
+        reply += "-ERR wrong number of arguments for '" + args[0] + "' command\r\n";
+    };
+
+    if (name == "GET")
+    {
+        if (nb_args != 2) { wrong_nb_args(); return true; }
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _values.find(args[1]);
+        if (it == _values.end())
+        {
+            reply += "$-1\r\n";
+        }
+        else
+        {
+            append_bulk_string(reply, it->second);
+        }
+    }
+    else if (name == "SET" || name == "MSET")
+    {
+        if ((name == "SET" && nb_args != 3) || nb_args < 3 || nb_args % 2 != 1) { wrong_nb_args(); return true; }
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 1; i < nb_args; i += 2)
+        {
+            _values[args[i]] = args[i+1];
+        }
+        reply += "+OK\r\n";
+    }
+    else if (name == "MGET")
+    {
+        if (nb_args < 2) { wrong_nb_args(); return true; }
+        std::lock_guard<std::mutex> lock(_mutex);
+        reply += '*' + std::to_string(nb_args - 1) + "\r\n";
+        for (size_t i = 1; i < nb_args; ++i)
+        {
+            auto it = _values.find(args[i]);
+            if (it == _values.end())
+            {
+                reply += "$-1\r\n";
+            }
+            else
+            {
+                append_bulk_string(reply, it->second);
+            }
+        }
+    }
+    else if (name == "DEL" || name == "EXISTS")
+    {
+        if (nb_args < 2) { wrong_nb_args(); return true; }
+        std::lock_guard<std::mutex> lock(_mutex);
+        size_t count = 0;
+        for (size_t i = 1; i < nb_args; ++i)
+        {
+            count += (name == "DEL") ? _values.erase(args[i]) : _values.count(args[i]);
+        }
+        reply += ':' + std::to_string(count) + "\r\n";
+    }
+    else if (name == "PING")
+    {
+        if (nb_args == 2)
+        {
+            append_bulk_string(reply, args[1]);
+        }
+        else
+        {
+            reply += "+PONG\r\n";
+        }
+    }
+    else if (name == "SELECT")
+    {
+        reply += "+OK\r\n";
+    }
+    else if (name == "QUIT")
+    {
+        reply += "+OK\r\n";
+        return false;
+    }
+    else
+    {
+        reply += "-ERR unknown command '" + args[0] + "'\r\n";
+    }
+
+    return true;
+}
+
+//! The size of the pending replies of a client above which its commands are no longer read, until it reads its replies
+static const size_t max_client_output_size = 16*1024*1024;
+
+/**
+ * @brief The state of a client of a UnixSocketStorage
+ */
+struct UnixSocketClient
+{
+    int fd = -1;                //!< The client socket (non-blocking)
+    std::string input;          //!< The received data that has not been parsed yet
+    std::string output;         //!< The replies that have not been sent yet
+    size_t output_pos = 0;      //!< The position of the first byte of output that has not been sent yet
+    bool closing = false;       //!< Whether the connection must be closed once the replies have been sent
+};
+
+/**
+ * @brief Sends as much pending replies as possible to a client, without blocking
+ * @param[in,out] client The client
+ * @return false if the connection is broken, true otherwise
+ */
+static bool flush_client_output(UnixSocketClient & client)
+{
+    while (client.output_pos < client.output.size())
+    {
+        ssize_t ret = send(client.fd, client.output.data() + client.output_pos,
+                           client.output.size() - client.output_pos, MSG_NOSIGNAL);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        client.output_pos += static_cast<size_t>(ret);
+    }
+
+    client.output.clear();
+    client.output_pos = 0;
+    return true;
+}
+
+void UnixSocketStorage::server_thread_loop()
+{
+    // The thread only blocks in poll: a client that does not read its replies cannot stall the other clients
+    // nor prevent the storage from being destroyed
+    std::vector<UnixSocketClient> clients;
+    std::vector<pollfd> fds;
+    std::vector<std::string> args;
+    char buffer[64*1024];
+
+    while (true)
+    {
+        // The stop pipe and the listening socket come first, then the clients in order
+        fds.clear();
+        fds.push_back({_stop_pipe[0], POLLIN, 0});
+        fds.push_back({_listening_socket, POLLIN, 0});
+        for (const UnixSocketClient & client : clients)
+        {
+            short events = 0;
+            if (!client.closing && client.output.size() - client.output_pos < max_client_output_size)
+            {
+                events |= POLLIN;
+            }
+            if (client.output_pos < client.output.size())
+            {
+                events |= POLLOUT;
+            }
+            fds.push_back({client.fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0)
+        {
+            xbt_assert(errno == EINTR, "Cannot poll the storage sockets: %s", strerror(errno));
+            continue;
+        }
+
+        if (fds[0].revents != 0)
+        {
+            break;
+        }
+
+        // Clients are handled before accepting new ones, so that fds and clients indices still match
+        for (size_t i = clients.size(); i-- > 0; )
+        {
+            const short revents = fds[i+2].revents;
+            if (revents == 0)
+            {
+                continue;
+            }
+
+            UnixSocketClient & client = clients[i];
+            bool connection_ok = (revents & (POLLERR | POLLNVAL)) == 0;
+
+            if (connection_ok && (revents & (POLLIN | POLLHUP)) && !client.closing)
+            {
+                ssize_t nb_read = recv(client.fd, buffer, sizeof(buffer), 0);
+                if (nb_read > 0)
+                {
+                    client.input.append(buffer, static_cast<size_t>(nb_read));
+
+                    int parse_ret;
+                    while (!client.closing && (parse_ret = parse_command(client.input, args)) == 1)
+                    {
+                        client.closing = !execute_command(args, client.output);
+                    }
+                    if (!client.closing && parse_ret == -1)
+                    {
+                        client.output += "-ERR Protocol error: only arrays of bulk strings are supported\r\n";
+                        client.closing = true;
+                    }
+                }
+                else if (nb_read == 0 || (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK))
+                {
+                    connection_ok = false;
+                }
+            }
+
+            // Replies are sent as soon as possible, the rest is sent when the socket becomes writable (POLLOUT)
+            connection_ok = connection_ok && flush_client_output(client);
+
+            if (!connection_ok || (client.closing && client.output.empty()))
+            {
+                close(client.fd);
+                clients.erase(clients.begin() + static_cast<long>(i));
+            }
+        }
+
+        if (fds[1].revents != 0)
+        {
+            int fd = accept(_listening_socket, nullptr, nullptr);
+            if (fd != -1)
+            {
+                int flags = fcntl(fd, F_GETFL, 0);
+                if (flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1)
+                {
+                    UnixSocketClient client;
+                    client.fd = fd;
+                    clients.push_back(std::move(client));
+                }
+                else
+                {
+                    XBT_WARN("Cannot make a storage client socket non-blocking, closing it: %s", strerror(errno));
+                    close(fd);
+                }
+            }
+        }
+    }
+
+    for (const UnixSocketClient & client : clients)
+    {
+        close(client.fd);
+    }
 }
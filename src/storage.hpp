@@ -1,24 +1,119 @@
 /**
  * @file storage.hpp
- * @brief Contains data storage (Redis) related classes
+ * @brief Contains data storage (Redis, in-process, Unix socket) related classes
  */
 
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <redox.hpp>
 
 #include "ipp.hpp"
 
+/**
+ * @brief Key-value data storage, through which job and profile descriptions can be shared with the scheduler
+ * @details This class defines an instance key prefix and adds this prefix to every user-given key,
+ * in order to make the concurrent executions of Batsim easier. All the implementations use the same
+ * key layout (see job_key and profile_key).
+ */
+class Storage
+{
+public:
+    /**
+     * @brief Destroys a Storage
+     */
+    virtual ~Storage() = default;
+
+    /**
+     * @brief Gets the value associated with the given key
+     * @param[in] key The key
+     * @return The value associated with the given key (empty if the key does not exist)
+     */
+    virtual std::string get(const std::string & key) = 0;
+
+    /**
+     * @brief Sets a key-value in the storage
+     * @param[in] key The key
+     * @param[in] value The value to associate with the key
+     * @return true if succeeded, false otherwise.
+     */
+    virtual bool set(const std::string & key,
+                     const std::string & value) = 0;
+
+    /**
+     * @brief Sets several key-values in the storage
+     * @details The default implementation calls set for each key-value.
+     * @param[in] key_values The keys and the values to associate with them
+     * @return true if succeeded, false otherwise.
+     */
+    virtual bool set_many(const std::vector<std::pair<std::string, std::string>> & key_values);
+
+    /**
+     * @brief Deletes a key-value association from the storage
+     * @param[in] key The key which should be deleted from the storage
+     * @return true if succeeded, false otherwise.
+     */
+    virtual bool del(const std::string & key) = 0;
+
+    /**
+     * @brief Sets the instance key prefix
+     * @param[in] key_prefix The new key prefix
+     */
+    void set_instance_key_prefix(const std::string & key_prefix);
+
+    /**
+     * @brief Returns the instance key prefix.
+     * @return The instance key prefix.
+     */
+    std::string instance_key_prefix() const;
+
+    /**
+     * @brief Returns the key subparts separator.
+     * @return The key subparts separator.
+     */
+    std::string key_subparts_separator() const;
+
+    /**
+     * @brief Returns the key in the data storage corresponding to a JobIdentifier
+     * @param[in] job_id The JobIdentifier
+     * @return The key in the data storage corresponding to a JobIdentifier
+     */
+    static std::string job_key(const JobIdentifier & job_id);
+
+    /**
+     * @brief Returns the key in the data storage corresponding to a profile
+     * @param[in] workload_name The workload name of the profile
+     * @param[in] profile_name The profile name
+     * @return The key in the data storage corresponding to a profile
+     */
+    static std::string profile_key(const std::string & workload_name,
+                                   const std::string & profile_name);
+
+protected:
+    /**
+     * @brief Build a final key from a user-given key.
+     * @param[in] user_given_key The user-given key
+     * @return The real key corresponding to the user-given key
+     */
+    std::string build_key(const std::string & user_given_key) const;
+
+private:
+    std::string _instance_key_prefix = ""; //!< The instance key prefix, which is added before to every user-given key.
+    std::string _key_subparts_separator = ":"; //!< The key subparts separator, which is put between the instance key prefix and the user-given key.
+};
+
 /**
  * @brief Wrapper class around Redox, a Redis client library.
  * @details This class provides blocking methods that communicate
- * with a Redis server. Furthermore, this class defines an instance
- * key prefix and adds this prefix to every user-given key, in order
- * to make the concurrent executions of Batsim easier.
+ * with a Redis server.
  */
-class RedisStorage
+class RedisStorage : public Storage
 {
 public:
     /**
@@ -35,13 +130,7 @@ public:
     /**
      * @brief Destroys a RedisStorage
      */
-    ~RedisStorage();
-
-    /**
-     * @brief Sets the instance key prefix
-     * @param[in] key_prefix The new key prefix
-     */
-    void set_instance_key_prefix(const std::string & key_prefix);
+    ~RedisStorage() override;
 
     /**
      * @brief Connects to a Redis server
@@ -62,7 +151,7 @@ public:
      * @param[in] key The key
      * @return The value associated with the given key
      */
-    std::string get(const std::string & key);
+    std::string get(const std::string & key) override;
 
     /**
      * @brief Sets a key-value in the Redis server
@@ -71,54 +160,142 @@ public:
      * @return true if succeeded, false otherwise.
      */
     bool set(const std::string & key,
-             const std::string & value);
+             const std::string & value) override;
+
+    /**
+     * @brief Sets several key-values in the Redis server, in as few round trips as possible (MSET commands)
+     * @param[in] key_values The keys and the values to associate with them
+     * @return true if succeeded, false otherwise.
+     */
+    bool set_many(const std::vector<std::pair<std::string, std::string>> & key_values) override;
 
     /**
      * @brief Deletes a key-value association from the Redis server
      * @param[in] key The key which should be deleted from the Redis server
      * @return true if succeeded, false otherwise.
      */
-    bool del(const std::string & key);
+    bool del(const std::string & key) override;
 
     /**
-     * @brief Returns the instance key prefix.
-     * @return The instance key prefix.
+     * @brief Sets whether the values written into the Redis server are read back to check consistency
+     * @details This doubles the number of round trips with the server, it is therefore disabled by default.
+     * @param[in] check_writes Whether the values written into the Redis server are read back
      */
-    std::string instance_key_prefix() const;
+    void set_write_check(bool check_writes);
 
+private:
+    bool _is_connected = false; //!< True if and only if the instance is connected to a Redis server
+    redox::Redox _redox; //!< The Redox instance
+    bool _check_writes = false; //!< Whether the written values are read back to check consistency
+
+    static constexpr size_t _max_nb_keys_per_command = 4096; //!< The maximum number of keys set by each MSET command
+};
+
+/**
+ * @brief Data storage kept in Batsim's memory
+ * @details Schedulers that run in Batsim's process can read it through the Storage interface.
+ *          The methods can be called from several threads.
+ */
+class InProcessStorage : public Storage
+{
+public:
     /**
-     * @brief Returns the key subparts separator.
-     * @return The key subparts separator.
+     * @brief Builds an empty InProcessStorage
      */
-    std::string key_subparts_separator() const;
+    InProcessStorage() = default;
 
     /**
-     * @brief Returns the key in the data storage corresponding to a JobIdentifier
-     * @param[in] job_id The JobIdentifier
-     * @return The key in the data storage corresponding to a JobIdentifier
+     * @brief InProcessStorage cannot be copied.
+     * @param[in] other Another instance
      */
-    static std::string job_key(const JobIdentifier & job_id);
+    InProcessStorage(const InProcessStorage & other) = delete;
 
     /**
-     * @brief Returns the key in the data storage corresponding to a profile
-     * @param[in] workload_name The workload name of the profile
-     * @param[in] profile_name The profile name
-     * @return The key in the data storage corresponding to a profile
+     * @brief Gets the value associated with the given key
+     * @param[in] key The key
+     * @return The value associated with the given key (empty if the key does not exist)
      */
-    static std::string profile_key(const std::string & workload_name,
-                                   const std::string & profile_name);
+    std::string get(const std::string & key) override;
+
+    /**
+     * @brief Sets a key-value in the storage
+     * @param[in] key The key
+     * @param[in] value The value to associate with the key
+     * @return true
+     */
+    bool set(const std::string & key,
+             const std::string & value) override;
+
+    /**
+     * @brief Sets several key-values in the storage, atomically
+     * @param[in] key_values The keys and the values to associate with them
+     * @return true
+     */
+    bool set_many(const std::vector<std::pair<std::string, std::string>> & key_values) override;
+
+    /**
+     * @brief Deletes a key-value association from the storage
+     * @param[in] key The key which should be deleted from the storage
+     * @return true if the key existed, false otherwise.
+     */
+    bool del(const std::string & key) override;
+
+protected:
+    std::unordered_map<std::string, std::string> _values; //!< The values, indexed by their real key (prefix included)
+    std::mutex _mutex; //!< Protects _values
+};
+
+/**
+ * @brief Data storage kept in Batsim's memory, and served on a Unix socket with (a subset of) the Redis protocol
+ * @details Schedulers can therefore use their Redis client on the Unix socket instead of running a Redis server.
+ *          The supported commands are GET, SET, MSET, MGET, DEL, EXISTS, PING, SELECT and QUIT.
+ *          The socket is served by a background thread.
+ */
+class UnixSocketStorage : public InProcessStorage
+{
+public:
+    /**
+     * @brief Builds an empty UnixSocketStorage and starts serving it
+     * @param[in] socket_path The path of the Unix socket. An existing socket at this path is replaced.
+     */
+    explicit UnixSocketStorage(const std::string & socket_path);
+
+    /**
+     * @brief UnixSocketStorage cannot be copied.
+     * @param[in] other Another instance
+     */
+    UnixSocketStorage(const UnixSocketStorage & other) = delete;
+
+    /**
+     * @brief Stops serving the storage, then removes the Unix socket
+     */
+    ~UnixSocketStorage() override;
+
+    /**
+     * @brief Extracts a command (an array of bulk strings in the Redis protocol) from the beginning of received data
+     * @param[in,out] input The received data. The command is removed from it if it is complete
+     * @param[out] args The command arguments (the command name first)
+     * @return 1 if a command has been extracted, 0 if the command is not complete yet, -1 if the data is not a valid command
+     */
+    static int parse_command(std::string & input, std::vector<std::string> & args);
+
+    /**
+     * @brief Executes a command on the storage
+     * @param[in] args The command arguments (the command name first)
+     * @param[out] reply The reply of the command, in the Redis protocol, is appended to it
+     * @return false if the connection should be closed after the reply, true otherwise
+     */
+    bool execute_command(const std::vector<std::string> & args, std::string & reply);
 
 private:
     /**
-     * @brief Build a final key from a user-given key.
-     * @param[in] user_given_key The user-given key
-     * @return The real key corresponding to the user-given key
+     * @brief The server thread main loop: accepts clients and executes their commands until the storage is destroyed
      */
-    std::string build_key(const std::string & user_given_key) const;
+    void server_thread_loop();
 
 private:
-    bool _is_connected = false; //!< True if and only if the instance is connected to a Redis server
-    redox::Redox _redox; //!< The Redox instance
-    std::string _instance_key_prefix = ""; //!< The instance key prefix, which is added before to every user-given key.
-    std::string _key_subparts_separator = ":"; //!< The key subparts separator, which is put between the instance key prefix and the user-given key.
+    std::string _socket_path; //!< The path of the Unix socket
+    int _listening_socket = -1; //!< The listening socket
+    int _stop_pipe[2] = {-1, -1}; //!< Written to stop the server thread
+    std::thread _server_thread; //!< The server thread
 };
@@ -3,6 +3,8 @@
  * @brief Contains functions related to the execution of the parallel profile tasks
  */
 
+#include <algorithm>
+
 #include <simgrid/s4u.hpp>
 
 #include "jobs.hpp"
@@ -16,6 +18,39 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(task_execution, "task_execution"); //!< Logging
 using namespace std;
 using namespace roles;
 
+void fill_homogeneous_communication_matrix(std::vector<double> & communication_amount,
+                                           unsigned int nb_res,
+                                           double com)
+{
+    // Whole rows are written at once, then the diagonal (no intra node comm) is patched
+    const size_t size = static_cast<size_t>(nb_res);
+    communication_amount.assign(size * size, com);
+
+    double * matrix = communication_amount.data();
+    for (size_t i = 0; i < size; ++i)
+    {
+        matrix[i * (size + 1)] = 0;
+    }
+}
+
+void fill_pfs_communication_matrix(std::vector<double> & communication_amount,
+                                   unsigned int nb_res,
+                                   double bytes_to_read,
+                                   double bytes_to_write)
+{
+    // Only the last column (writes to the pfs) and the last row (reads from the pfs) are not null
+    const size_t size = static_cast<size_t>(nb_res);
+    const size_t pfs_id = size - 1;
+    communication_amount.assign(size * size, 0);
+
+    double * matrix = communication_amount.data();
+    for (size_t row = 0; row < pfs_id; ++row)
+    {
+        matrix[row * size + pfs_id] = bytes_to_write;
+    }
+    std::fill_n(matrix + pfs_id * size, pfs_id, bytes_to_read);
+}
+
 /**
  * @brief Generate the communication and computaion matrix for the
  *        parallel task profile. Also set the prefix name of the task.
@@ -62,36 +97,16 @@ void generate_parallel_homogeneous(std::vector<double>& computation_amount,
     double cpu = data->cpu;
     double com = data->com;
 
-    // Prepare buffers
-    computation_amount.reserve(nb_res);
+    // Let us fill the local computation and communication matrices
+    computation_amount.assign(nb_res, cpu);
     if (com > 0)
     {
-        communication_amount.reserve(nb_res*nb_res);
+        fill_homogeneous_communication_matrix(communication_amount, nb_res, com);
     }
     else
     {
         communication_amount.clear();
     }
-
-    // Let us fill the local computation and communication matrices
-    for (unsigned int y = 0; y < nb_res; ++y)
-    {
-        computation_amount.push_back(cpu);
-        if (com > 0)
-        {
-            for (unsigned int x = 0; x < nb_res; ++x)
-            {
-                if (x == y)
-                {
-                    communication_amount.push_back(0);
-                }
-                else
-                {
-                    communication_amount.push_back(com);
-                }
-            }
-        }
-    }
 }
 
 /**
@@ -117,36 +132,16 @@ void generate_parallel_homogeneous_total_amount(std::vector<double>& computation
     const double spread_cpu = data->cpu / nb_res;
     const double spread_com = data->com / nb_res;
 
-    // Prepare buffers
-    computation_amount.reserve(nb_res);
+    // Fill the local computation and communication matrices
+    computation_amount.assign(nb_res, spread_cpu);
     if (spread_com > 0)
     {
-        communication_amount.reserve(nb_res*nb_res);
+        fill_homogeneous_communication_matrix(communication_amount, nb_res, spread_com);
     }
     else
     {
         communication_amount.clear();
     }
-
-    // Fill the local computation and communication matrices
-    for (unsigned int y = 0; y < nb_res; ++y)
-    {
-        computation_amount.push_back(spread_cpu);
-        if (spread_com > 0)
-        {
-            for (unsigned int x = 0; x < nb_res; ++x)
-            {
-                if (x == y)
-                {
-                    communication_amount.push_back(0);
-                }
-                else
-                {
-                    communication_amount.push_back(spread_com);
-                }
-            }
-        }
-    }
 }
 
 /**
@@ -175,7 +170,6 @@ void generate_parallel_homogeneous_with_pfs(std::vector<double>& computation_amo
 
     // The PFS machine will also be used
     unsigned int nb_res = static_cast<unsigned int>(hosts_to_use.size()) + 1;
-    unsigned int pfs_id = nb_res - 1;
 
     // Add the pfs_machine
     int pfs_machine_id;
@@ -205,44 +199,17 @@ void generate_parallel_homogeneous_with_pfs(std::vector<double>& computation_amo
     }
     hosts_to_use.push_back(context->machines[pfs_machine_id]->host);
 
-    // Prepare buffers
-    computation_amount.reserve(nb_res);
+    // Let us fill the local computation and communication matrices
+    computation_amount.assign(nb_res, 0);
     bool do_comm = data->bytes_to_read > 0 || data->bytes_to_write > 0;
     if (do_comm)
     {
-        communication_amount.reserve(nb_res*nb_res);
+        fill_pfs_communication_matrix(communication_amount, nb_res, data->bytes_to_read, data->bytes_to_write);
     }
     else
     {
         communication_amount.clear();
     }
-
-    // Let us fill the local computation and communication matrices
-    for (unsigned int row = 0; row < nb_res; ++row)
-    {
-        computation_amount.push_back(0);
-        if (do_comm)
-        {
-            for (unsigned int col = 0; col < nb_res; ++col)
-            {
-                // No intra node comm and no inter node comm if it's not the pfs
-                if (col == row or (col != pfs_id and row != pfs_id))
-                {
-                    communication_amount.push_back(0);
-                }
-                // Writes
-                else if (col == pfs_id)
-                {
-                    communication_amount.push_back(data->bytes_to_write);
-                }
-                // Reads
-                else if (row == pfs_id)
-                {
-                    communication_amount.push_back(data->bytes_to_read);
-                }
-            }
-        }
-    }
 }
 
 /**
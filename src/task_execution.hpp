@@ -1,9 +1,36 @@
 #pragma once
 
+#include <vector>
+
 #include "context.hpp"
 #include "ipp.hpp"
 #include "jobs.hpp"
 
+/**
+ * @brief Fills the communication matrix of a homogeneous parallel task
+ * @details Every executor sends com bytes to every other executor. There is no intra node communication.
+ * @param[out] communication_amount The communication matrix, resized to nb_res*nb_res
+ * @param[in] nb_res The number of resources the task runs on
+ * @param[in] com The amount of bytes sent from one executor to another one
+ */
+void fill_homogeneous_communication_matrix(std::vector<double> & communication_amount,
+                                           unsigned int nb_res,
+                                           double com);
+
+/**
+ * @brief Fills the communication matrix of a homogeneous parallel task with a Parallel File System
+ * @details The pfs is the last resource. Every other executor writes bytes_to_write bytes to the pfs
+ *          and reads bytes_to_read bytes from it. There is no other communication.
+ * @param[out] communication_amount The communication matrix, resized to nb_res*nb_res
+ * @param[in] nb_res The number of resources the task runs on, including the pfs
+ * @param[in] bytes_to_read The amount of bytes read from the pfs by each executor
+ * @param[in] bytes_to_write The amount of bytes written to the pfs by each executor
+ */
+void fill_pfs_communication_matrix(std::vector<double> & communication_amount,
+                                   unsigned int nb_res,
+                                   double bytes_to_read,
+                                   double bytes_to_write);
+
 /**
  * @brief Execute tasks that correspond to parallel task profiles
  * @param[in,out] btask The task to execute. Progress information is stored within it.
@@ -0,0 +1,232 @@
+/*
+ * @file timeline_submitter.cpp
+ * @brief Contains functions related to the submission of static jobs and events
+ */
+
+#include "timeline_submitter.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+#include "context.hpp"
+#include "ipp.hpp"
+#include "jobs.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(timeline_submitter, "timeline_submitter"); //!< Logging
+
+using namespace std;
+
+/**
+ * @brief A static workload whose jobs are being submitted
+ */
+struct WorkloadSource
+{
+    Workload * workload;            //!< The workload
+    string submitter_name;          //!< The name of the submitter, as seen by the server
+    vector<JobPtr> jobs;            //!< The jobs of the workload, sorted by submission time. Submitted jobs are reset to drop them from memory
+    size_t next_job_index = 0;      //!< The index of the next job to submit
+};
+
+/**
+ * @brief Builds an IPMessage to be grouped into a TimelineSubmittedMessage
+ * @param[in] type The type of the message
+ * @param[in] data The message data
+ * @return The newly allocated IPMessage
+ */
+static IPMessage * new_grouped_message(IPMessageType type, void * data)
+{
+    IPMessage * message = new IPMessage;
+    message->type = type;
+    message->data = data;
+    return message;
+}
+
+/**
+ * @brief Sends the messages of a date to the server, in a single TIMELINE_SUBMITTED message
+ * @param[in,out] context The BatsimContext
+ * @param[in,out] messages The messages to send. Cleared
+ * @param[in,out] storage_key_values The metadata of the submitted jobs, put into the data storage first. Cleared
+ */
+static void send_timeline_to_server(BatsimContext * context,
+                                    vector<IPMessage *> & messages,
+                                    vector<pair<string, string>> & storage_key_values)
+{
+    if (context->redis_enabled && !storage_key_values.empty())
+    {
+        context->storage->set_many(storage_key_values);
+        storage_key_values.clear();
+    }
+
+    if (!messages.empty())
+    {
+        TimelineSubmittedMessage * msg = new TimelineSubmittedMessage;
+        msg->messages.swap(messages);
+        send_message("server", IPMessageType::TIMELINE_SUBMITTED, static_cast<void*>(msg));
+    }
+}
+
+void timeline_submitter_process(BatsimContext * context,
+                                std::vector<std::string> workload_names)
+{
+    const string events_submitter_name = "events_submitter";
+    EventStream * event_stream = context->event_stream;
+
+    vector<WorkloadSource> workload_sources(workload_names.size());
+    vector<IPMessage *> messages;
+    vector<pair<string, string>> storage_key_values; // The metadata of the jobs to send, stored in a single round trip
+
+    // Every source says hello, so that the server can tell the scheduler when all the jobs (or events) have been submitted
+    for (size_t i = 0; i < workload_names.size(); ++i)
+    {
+        xbt_assert(context->workloads.exists(workload_names[i]),
+                   "Error: the timeline_submitter_process is in charge of workload '%s', "
+                   "which does not exist", workload_names[i].c_str());
+
+        WorkloadSource & source = workload_sources[i];
+        source.workload = context->workloads.at(workload_names[i]);
+        source.submitter_name = workload_names[i] + "_submitter";
+
+        const auto & jobs = source.workload->jobs->jobs();
+        source.jobs.reserve(jobs.size());
+        for (const auto & mit : jobs)
+        {
+            source.jobs.push_back(mit.second);
+        }
+        sort(source.jobs.begin(), source.jobs.end(), job_comparator_subtime_number);
+
+        SubmitterHelloMessage * hello_msg = new SubmitterHelloMessage;
+        hello_msg->submitter_name = source.submitter_name;
+        hello_msg->enable_callback_on_job_completion = false;
+        hello_msg->submitter_type = SubmitterType::JOB_SUBMITTER;
+        messages.push_back(new_grouped_message(IPMessageType::SUBMITTER_HELLO, static_cast<void*>(hello_msg)));
+    }
+
+    if (event_stream != nullptr)
+    {
+        SubmitterHelloMessage * hello_msg = new SubmitterHelloMessage;
+        hello_msg->submitter_name = events_submitter_name;
+        hello_msg->enable_callback_on_job_completion = false;
+        hello_msg->submitter_type = SubmitterType::EVENT_SUBMITTER;
+        messages.push_back(new_grouped_message(IPMessageType::SUBMITTER_HELLO, static_cast<void*>(hello_msg)));
+    }
+
+    long double current_date = static_cast<long double>(simgrid::s4u::Engine::get_clock());
+    size_t nb_finished_sources = 0;
+    const size_t nb_sources = workload_sources.size() + (event_stream != nullptr ? 1 : 0);
+
+    while (true)
+    {
+        // Sources that have nothing to submit say goodbye along with the last things they submitted
+        for (WorkloadSource & source : workload_sources)
+        {
+            if (source.workload != nullptr && source.next_job_index == source.jobs.size())
+            {
+                SubmitterByeMessage * bye_msg = new SubmitterByeMessage;
+                bye_msg->is_workflow_submitter = false;
+                bye_msg->submitter_name = source.submitter_name;
+                bye_msg->submitter_type = SubmitterType::JOB_SUBMITTER;
+                messages.push_back(new_grouped_message(IPMessageType::SUBMITTER_BYE, static_cast<void*>(bye_msg)));
+
+                source.workload = nullptr;
+                ++nb_finished_sources;
+            }
+        }
+        if (event_stream != nullptr && event_stream->peek() == nullptr)
+        {
+            SubmitterByeMessage * bye_msg = new SubmitterByeMessage;
+            bye_msg->is_workflow_submitter = false;
+            bye_msg->submitter_name = events_submitter_name;
+            bye_msg->submitter_type = SubmitterType::EVENT_SUBMITTER;
+            messages.push_back(new_grouped_message(IPMessageType::SUBMITTER_BYE, static_cast<void*>(bye_msg)));
+
+            event_stream = nullptr;
+            ++nb_finished_sources;
+        }
+
+        if (nb_finished_sources == nb_sources)
+        {
+            break;
+        }
+
+        // Let's find the date of the next submission, among all the sources
+        long double next_date = std::numeric_limits<long double>::infinity();
+        for (const WorkloadSource & source : workload_sources)
+        {
+            if (source.workload != nullptr)
+            {
+                next_date = std::min(next_date, source.jobs[source.next_job_index]->submission_time);
+            }
+        }
+        if (event_stream != nullptr)
+        {
+            next_date = std::min(next_date, event_stream->peek()->timestamp);
+        }
+
+        if (next_date > current_date)
+        {
+            // Everything that happened at the current date is sent at once
+            send_timeline_to_server(context, messages, storage_key_values);
+
+            // Now let's sleep until the next submission date
+            simgrid::s4u::this_actor::sleep_for(static_cast<double>(next_date - current_date));
+            current_date = static_cast<long double>(simgrid::s4u::Engine::get_clock());
+        }
+
+        // Let's collect the jobs submitted at this date, one JOB_SUBMITTED message per workload
+        for (WorkloadSource & source : workload_sources)
+        {
+            if (source.workload == nullptr ||
+                source.jobs[source.next_job_index]->submission_time > next_date)
+            {
+                continue;
+            }
+
+            if (context->energy_first_job_submission < 0)
+            {
+                context->energy_first_job_submission = context->machines.total_consumed_energy(context);
+            }
+
+            JobSubmittedMessage * msg = new JobSubmittedMessage;
+            msg->submitter_name = source.submitter_name;
+            for ( ; source.next_job_index < source.jobs.size() &&
+                    source.jobs[source.next_job_index]->submission_time <= next_date;
+                  ++source.next_job_index)
+            {
+                // The job is moved out of the sorted vector (for smooth refcounting-based memory clean-up)
+                JobPtr job = std::move(source.jobs[source.next_job_index]);
+
+                // Let's put the metadata about the job into the data storage (with the other jobs submitted at the same time)
+                if (context->redis_enabled)
+                {
+                    storage_key_values.emplace_back(Storage::job_key(job->id), job->get_json_description());
+                    if (context->submission_forward_profiles)
+                    {
+                        storage_key_values.emplace_back(Storage::profile_key(source.workload->name, job->profile->name),
+                                                        job->profile->get_json_description());
+                    }
+                }
+
+                msg->jobs.push_back(std::move(job));
+            }
+            messages.push_back(new_grouped_message(IPMessageType::JOB_SUBMITTED, static_cast<void*>(msg)));
+        }
+
+        // Let's collect the events that occur at this date. The message will own them
+        if (event_stream != nullptr && event_stream->peek()->timestamp <= next_date)
+        {
+            EventOccurredMessage * msg = new EventOccurredMessage;
+            msg->submitter_name = events_submitter_name;
+            while (event_stream->peek() != nullptr && event_stream->peek()->timestamp <= next_date)
+            {
+                msg->occurred_events.push_back(event_stream->next());
+            }
+            messages.push_back(new_grouped_message(IPMessageType::EVENT_OCCURRED, static_cast<void*>(msg)));
+        }
+    }
+
+    // Send the last submissions and the goodbyes
+    send_timeline_to_server(context, messages, storage_key_values);
+}
@@ -0,0 +1,23 @@
+/**
+ * @file timeline_submitter.hpp
+ * @brief Contains functions related to the submission of static jobs and events
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct BatsimContext;
+
+/**
+ * @brief The process in charge of submitting static jobs (those described before running the simulations)
+ *        and static events (those of the events files)
+ * @details All the static sources are merged by date. Everything that happens at a date is sent
+ *          to the server in a single TIMELINE_SUBMITTED message, so that the server and the scheduler
+ *          are woken up once per distinct date, whatever the number of sources.
+ * @param[in] context The BatsimContext
+ * @param[in] workload_names The names of the static workloads to submit
+ */
+void timeline_submitter_process(BatsimContext * context,
+                                std::vector<std::string> workload_names);
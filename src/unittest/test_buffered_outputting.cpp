@@ -2,9 +2,22 @@
 
 #include <stdio.h>
 
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
 #include <intervalset.hpp>
 
+#ifdef BATSIM_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include "../context.hpp"
 #include "../export.hpp"
+#include "../jobs.hpp"
 
 TEST(buffered_outputting, write_buffer)
 {
@@ -37,6 +50,277 @@ TEST(buffered_outputting, write_buffer)
     EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
 }
 
+TEST(buffered_outputting, async_write_buffer)
+{
+    const char * filename = "/tmp/test_async_wbuf";
+    WriteBuffer * buf = new WriteBuffer(filename, 4, true);
+    std::string expected_content;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        // Smaller than, exactly and bigger than the buffer size
+        for (const char * text : {"ok\n", "meh\n", "Too big?\n"})
+        {
+            buf->append_text(text);
+            expected_content += text;
+        }
+    }
+
+    // Flush content, wait for the writer thread, close file and release memory
+    delete buf;
+
+    std::ifstream f(filename);
+    std::stringstream content;
+    content << f.rdbuf();
+    EXPECT_EQ(content.str(), expected_content);
+
+    // Remove temporary file
+    int remove_ret = remove(filename);
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+
+TEST(buffered_outputting, write_buffer_numbers)
+{
+    const char * filename = "/tmp/test_wbuf_numbers";
+    WriteBuffer * buf = new WriteBuffer(filename, 16);
+    std::string expected_content;
+
+    // The numbers must be written as std::to_string does
+    for (long long value : {0LL, 7LL, -42LL, 123456789012LL})
+    {
+        buf->append_int(value);
+        buf->append_char(',');
+        expected_content += std::to_string(value) + ',';
+    }
+    for (double value : {0.0, -0.0, 1.5, -3.25, 0.1234565, 1e-7, 86400.000001, 1e20})
+    {
+        buf->append_fixed(value);
+        buf->append_char(',');
+        expected_content += std::to_string(value) + ',';
+    }
+    for (long double value : {1e-3l, 3600.1234567l})
+    {
+        buf->append_fixed(value);
+        buf->append_text("\n", 1);
+        expected_content += std::to_string(value) + '\n';
+    }
+
+    // The numbers must be written as printf's %Lg does
+    for (long double value : {0.0l, -0.0l, 1.5l, 123456.0l, 1234567.0l, 0.0001l, 0.00001l, -3.14159265l, 1e300l, 1e-300l})
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "%Lg,", value);
+        buf->append_general(value);
+        buf->append_char(',');
+        expected_content += text;
+    }
+    buf->append_general(86400.5, 12);
+    expected_content += "86400.5";
+
+    delete buf;
+
+    std::ifstream f(filename);
+    std::stringstream content;
+    content << f.rdbuf();
+    EXPECT_EQ(content.str(), expected_content);
+
+    // Remove temporary file
+    int remove_ret = remove(filename);
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+
+TEST(buffered_outputting, compression_from_filename)
+{
+    EXPECT_EQ(output_compression_from_filename("/tmp/out_jobs.csv"), OutputCompression::NONE);
+    EXPECT_EQ(output_compression_from_filename("/tmp/out_jobs.csv.gz"), OutputCompression::GZIP);
+    EXPECT_EQ(output_compression_from_filename("/tmp/out_jobs.csv.zst"), OutputCompression::ZSTD);
+    EXPECT_EQ(output_compression_from_filename("gz"), OutputCompression::NONE);
+
+    for (OutputCompression compression : {OutputCompression::NONE, OutputCompression::GZIP, OutputCompression::ZSTD})
+    {
+        EXPECT_EQ(output_compression_from_filename("out" + output_compression_suffix(compression)), compression);
+    }
+}
+
+#ifdef BATSIM_WITH_ZLIB
+TEST(buffered_outputting, gzip_write_buffer)
+{
+    const char * filename = "/tmp/test_wbuf.gz";
+    WriteBuffer * buf = new WriteBuffer(filename, 4);
+    EXPECT_EQ(buf->compression(), OutputCompression::GZIP);
+    std::string expected_content;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        for (const char * text : {"ok\n", "meh\n", "Too big?\n"})
+        {
+            buf->append_text(text);
+            expected_content += text;
+        }
+    }
+
+    // Flush content, wait for the writer thread, end the gzip stream and close file
+    delete buf;
+
+    gzFile f = gzopen(filename, "rb");
+    ASSERT_NE(f, nullptr);
+    std::string content;
+    char chunk[256];
+    int nb_read;
+    while ((nb_read = gzread(f, chunk, sizeof(chunk))) > 0)
+    {
+        content.append(chunk, nb_read);
+    }
+    EXPECT_EQ(nb_read, 0) << "Could not decompress file " << filename;
+    gzclose(f);
+    EXPECT_EQ(content, expected_content);
+
+    // Remove temporary file
+    int remove_ret = remove(filename);
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+#endif
+
+template <typename T>
+static T read_value(std::istream & f)
+{
+    T value;
+    f.read(reinterpret_cast<char *>(&value), sizeof(value));
+    return value;
+}
+
+TEST(buffered_outputting, columnar_writer)
+{
+    const char * filename = "/tmp/test_columnar.bcol";
+    using ColumnType = ColumnarWriter::ColumnType;
+    ColumnarWriter * writer = new ColumnarWriter(filename, 2);
+    const int time_column = writer->add_column("time", ColumnType::FLOAT64);
+    const int name_column = writer->add_column("name", ColumnType::STRING);
+    const int resources_column = writer->add_column("resources", ColumnType::INTERVALS);
+
+    // 3 rows: 2 row groups
+    const std::vector<double> times = {0.5, 1, 42};
+    const std::vector<std::string> names = {"a", "", "job"};
+    IntervalSet resources;
+    resources.insert(1);
+    resources.insert(2);
+    resources.insert(4);
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        writer->append_float64(time_column, times[i]);
+        writer->append_string(name_column, names[i]);
+        writer->append_intervals(resources_column, resources);
+        writer->end_row();
+    }
+    EXPECT_EQ(writer->nb_rows(), 3u);
+    delete writer;
+
+    std::ifstream f(filename, std::ios_base::binary);
+    char magic[8];
+    f.read(magic, 8);
+    EXPECT_EQ(std::string(magic, 8), "BATCOLv1");
+    ASSERT_EQ(read_value<uint32_t>(f), 3u);
+    for (const char * name : {"time", "name", "resources"})
+    {
+        read_value<uint8_t>(f);
+        const uint16_t name_length = read_value<uint16_t>(f);
+        std::string read_name(name_length, ' ');
+        f.read(&read_name[0], name_length);
+        EXPECT_EQ(read_name, name);
+    }
+
+    std::vector<double> read_times;
+    std::vector<std::string> read_names;
+    uint32_t nb_rows;
+    while ((nb_rows = read_value<uint32_t>(f)) != 0)
+    {
+        // time
+        EXPECT_EQ(read_value<uint64_t>(f), nb_rows * sizeof(double));
+        for (uint32_t i = 0; i < nb_rows; ++i)
+        {
+            read_times.push_back(read_value<double>(f));
+        }
+
+        // name
+        read_value<uint64_t>(f);
+        std::vector<uint32_t> offsets;
+        for (uint32_t i = 0; i <= nb_rows; ++i)
+        {
+            offsets.push_back(read_value<uint32_t>(f));
+        }
+        for (uint32_t i = 0; i < nb_rows; ++i)
+        {
+            std::string name(offsets[i+1] - offsets[i], ' ');
+            f.read(&name[0], static_cast<std::streamsize>(name.size()));
+            read_names.push_back(name);
+        }
+
+        // resources: {1-2, 4} for each row
+        EXPECT_EQ(read_value<uint64_t>(f), (nb_rows + 1) * sizeof(uint32_t) + nb_rows * 4 * sizeof(int32_t));
+        for (uint32_t i = 0; i <= nb_rows; ++i)
+        {
+            EXPECT_EQ(read_value<uint32_t>(f), 2 * i);
+        }
+        for (uint32_t i = 0; i < nb_rows; ++i)
+        {
+            EXPECT_EQ(read_value<int32_t>(f), 1);
+            EXPECT_EQ(read_value<int32_t>(f), 2);
+            EXPECT_EQ(read_value<int32_t>(f), 4);
+            EXPECT_EQ(read_value<int32_t>(f), 4);
+        }
+    }
+    EXPECT_EQ(read_value<uint64_t>(f), 3u);
+    EXPECT_TRUE(f.good());
+    EXPECT_EQ(read_times, times);
+    EXPECT_EQ(read_names, names);
+
+    // Remove temporary file
+    int remove_ret = remove(filename);
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+
+static std::string read_file(const std::string & filename)
+{
+    std::ifstream f(filename);
+    std::stringstream content;
+    content << f.rdbuf();
+    return content.str();
+}
+
+TEST(buffered_outputting, chunked_output)
+{
+    EXPECT_EQ(ChunkedOutput::chunk_filename("/tmp/a.b/out_jobs.csv.gz", 1), "/tmp/a.b/out_jobs.00001.csv.gz");
+    EXPECT_EQ(ChunkedOutput::chunk_filename("/tmp/a.b/out", 12), "/tmp/a.b/out.00012");
+    EXPECT_EQ(ChunkedOutput::index_filename("/tmp/a.b/out_jobs.csv.gz"), "/tmp/a.b/out_jobs.index.csv");
+
+    // Chunks cover 10 seconds, and are ended once they reach 16 bytes
+    const std::string filename = "/tmp/test_chunked.csv";
+    ChunkedOutput::set_chunk_limits_by_default(16, 10);
+    ChunkedOutput * output = new ChunkedOutput(filename, "time\n");
+    for (int date : {0, 5, 12, 25, 26, 27, 28})
+    {
+        WriteBuffer * wbuf = output->begin_row(date);
+        wbuf->append_int(date);
+        wbuf->append_char('\n');
+    }
+    delete output;
+    ChunkedOutput::set_chunk_limits_by_default(0, 0);
+
+    const std::vector<std::string> expected_chunks = {"time\n0\n5\n", "time\n12\n", "time\n25\n26\n27\n28\n"};
+    for (size_t i = 0; i < expected_chunks.size(); ++i)
+    {
+        const std::string chunk = ChunkedOutput::chunk_filename(filename, static_cast<int>(i));
+        EXPECT_EQ(read_file(chunk), expected_chunks[i]);
+        EXPECT_EQ(remove(chunk.c_str()), 0) << "Could not remove file " << chunk;
+    }
+
+    const std::string index = ChunkedOutput::index_filename(filename);
+    EXPECT_EQ(read_file(index), "chunk,filename,nb_rows,first_time,last_time\n"
+                                "0,test_chunked.00000.csv,2,0.000000,5.000000\n"
+                                "1,test_chunked.00001.csv,1,12.000000,12.000000\n"
+                                "2,test_chunked.00002.csv,4,25.000000,28.000000\n");
+    EXPECT_EQ(remove(index.c_str()), 0) << "Could not remove file " << index;
+}
 
 TEST(buffered_outputting, pstate_writer)
 {
@@ -71,3 +355,332 @@ TEST(buffered_outputting, pstate_writer)
     int remove_ret = remove(filename);
     EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
 }
+
+TEST(buffered_outputting, pstate_writer_coalesce)
+{
+    const std::string filename = "/tmp/test_pstate_coalesce";
+    PStateChangeTracer * tracer = new PStateChangeTracer;
+    tracer->set_coalesce(true);
+    tracer->setFilename(filename);
+
+    IntervalSet first_machines;
+    IntervalSet last_machines;
+    for (int i = 0; i < 4; ++i)
+    {
+        first_machines.insert(i);
+    }
+    last_machines.insert(2);
+    last_machines.insert(3);
+
+    // Only the last power state of each machine is kept at each date
+    tracer->add_pstate_change(0, first_machines, 1);
+    tracer->add_pstate_change(0, last_machines, 0);
+    tracer->add_pstate_change(0, last_machines, 0);
+    tracer->add_pstate_change(1.5, last_machines, 1);
+    tracer->add_pstate_change(1.5, last_machines, 1);
+
+    // The rows of the last date are written on close
+    tracer->close_buffer();
+    delete tracer;
+
+    EXPECT_EQ(read_file(filename), "time,machine_id,new_pstate\n"
+                                   "0,2-3,0\n"
+                                   "0,0-1,1\n"
+                                   "1.5,2-3,1\n");
+
+    // Remove temporary file
+    int remove_ret = remove(filename.c_str());
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+
+TEST(buffered_outputting, energy_writer_coalesce)
+{
+    const std::string filename = "/tmp/test_energy_coalesce";
+    BatsimContext context;
+    context.energy_used = false;
+    EnergyConsumptionTracer * tracer = new EnergyConsumptionTracer;
+    tracer->set_context(&context);
+    tracer->set_coalesce(true);
+    tracer->set_filename(filename);
+
+    // Only the last entry of each date is written
+    IntervalSet machines;
+    machines.insert(0);
+    tracer->add_job_start(0, JobIdentifier("w0", "1"));
+    tracer->add_pstate_change(0, machines, 1);
+    tracer->add_job_end(0, JobIdentifier("w0", "1"));
+    tracer->add_job_start(2, JobIdentifier("w0", "2"));
+    tracer->add_job_start(2, JobIdentifier("w0", "2"));
+    tracer->add_pstate_change(5, machines, 0);
+
+    // The pending entry is written on close
+    tracer->close_buffer();
+    delete tracer;
+
+    // Without energy, the energy and wattmin are -1
+    EXPECT_EQ(read_file(filename), "time,energy,event_type,wattmin,epower\n"
+                                   "0,-1,e,-1,NA\n"
+                                   "2,-1,s,-1,0\n"
+                                   "5,-1,p,-1,0\n");
+
+    // Remove temporary file
+    int remove_ret = remove(filename.c_str());
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+
+static void switch_machines(BatsimContext & context, MachineState old_state, MachineState new_state, int nb_machines)
+{
+    for (int i = 0; i < nb_machines; ++i)
+    {
+        context.machines.update_nb_machines_in_each_state(old_state, new_state);
+    }
+}
+
+TEST(buffered_outputting, machine_states_coalesce)
+{
+    const std::string filename = "/tmp/test_machine_states_coalesce.csv";
+    BatsimContext context;
+    MachineStateTracer * tracer = new MachineStateTracer;
+    tracer->set_context(&context);
+    tracer->set_filename(filename);
+    tracer->set_aggregation(true, 0);
+
+    // Only the state after the last update at each date is written
+    switch_machines(context, MachineState::UNAVAILABLE, MachineState::IDLE, 4);
+    tracer->write_machine_states(0);
+    switch_machines(context, MachineState::IDLE, MachineState::COMPUTING, 1);
+    tracer->write_machine_states(0);
+    switch_machines(context, MachineState::IDLE, MachineState::COMPUTING, 1);
+    tracer->write_machine_states(1);
+    tracer->write_machine_states(1);
+    tracer->write_machine_states(1);
+    switch_machines(context, MachineState::COMPUTING, MachineState::IDLE, 1);
+    switch_machines(context, MachineState::IDLE, MachineState::TRANSITING_FROM_COMPUTING_TO_SLEEPING, 1);
+    tracer->write_machine_states(2.5);
+
+    // The pending line is written on close
+    tracer->close_buffer();
+    delete tracer;
+
+    EXPECT_EQ(read_file(filename), "time,nb_sleeping,nb_switching_on,nb_switching_off,nb_idle,nb_computing\n"
+                                   "0,0,0,0,3,1\n"
+                                   "1,0,0,0,2,2\n"
+                                   "2.5,0,0,1,2,1\n");
+
+    // Remove temporary file
+    int remove_ret = remove(filename.c_str());
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+
+TEST(buffered_outputting, machine_states_period)
+{
+    const std::string filename = "/tmp/test_machine_states_period.csv";
+    BatsimContext context;
+    MachineStateTracer * tracer = new MachineStateTracer;
+    tracer->set_context(&context);
+    tracer->set_filename(filename);
+    tracer->set_aggregation(false, 10);
+
+    // One line is written per period boundary, with the state at this date
+    switch_machines(context, MachineState::UNAVAILABLE, MachineState::IDLE, 4);
+    tracer->write_machine_states(0);
+    switch_machines(context, MachineState::IDLE, MachineState::COMPUTING, 1);
+    tracer->write_machine_states(5);
+    switch_machines(context, MachineState::IDLE, MachineState::COMPUTING, 1);
+    tracer->write_machine_states(25);
+    switch_machines(context, MachineState::IDLE, MachineState::SLEEPING, 1);
+    tracer->write_machine_states(30);
+
+    // The sample at the date of the pending line is written on close
+    tracer->close_buffer();
+    delete tracer;
+
+    EXPECT_EQ(read_file(filename), "time,nb_sleeping,nb_switching_on,nb_switching_off,nb_idle,nb_computing\n"
+                                   "0,0,0,0,4,0\n"
+                                   "10,0,0,0,3,1\n"
+                                   "20,0,0,0,3,1\n"
+                                   "30,1,0,0,1,2\n");
+
+    // Remove temporary file
+    int remove_ret = remove(filename.c_str());
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+
+// Reads a whole columnar file. Each value is returned as a string: numbers as %g, codes as their dictionary entry
+// and IntervalSets as comma-separated closed intervals
+static std::vector<std::vector<std::string>> read_columnar_rows(const std::string & filename)
+{
+    using ColumnType = ColumnarWriter::ColumnType;
+    std::ifstream f(filename, std::ios_base::binary);
+    char magic[8];
+    f.read(magic, 8);
+    EXPECT_EQ(std::string(magic, 8), "BATCOLv1");
+
+    std::vector<ColumnType> types;
+    std::vector<std::vector<std::string>> dictionaries;
+    const uint32_t nb_columns = read_value<uint32_t>(f);
+    for (uint32_t column = 0; column < nb_columns; ++column)
+    {
+        types.push_back(static_cast<ColumnType>(read_value<uint8_t>(f)));
+        std::string name(read_value<uint16_t>(f), ' ');
+        f.read(&name[0], static_cast<std::streamsize>(name.size()));
+
+        dictionaries.emplace_back();
+        if (types.back() == ColumnType::DICT8)
+        {
+            const uint16_t nb_entries = read_value<uint16_t>(f);
+            for (uint16_t i = 0; i < nb_entries; ++i)
+            {
+                std::string entry(read_value<uint16_t>(f), ' ');
+                f.read(&entry[0], static_cast<std::streamsize>(entry.size()));
+                dictionaries.back().push_back(entry);
+            }
+        }
+    }
+
+    std::vector<std::vector<std::string>> rows;
+    uint32_t nb_rows;
+    while (f.good() && (nb_rows = read_value<uint32_t>(f)) != 0)
+    {
+        const size_t first_row = rows.size();
+        rows.resize(first_row + nb_rows);
+        for (uint32_t column = 0; column < nb_columns; ++column)
+        {
+            read_value<uint64_t>(f);
+            std::vector<uint32_t> offsets;
+            if (types[column] == ColumnType::STRING || types[column] == ColumnType::INTERVALS)
+            {
+                for (uint32_t i = 0; i <= nb_rows; ++i)
+                {
+                    offsets.push_back(read_value<uint32_t>(f));
+                }
+            }
+
+            for (uint32_t i = 0; i < nb_rows; ++i)
+            {
+                char text[64];
+                std::string value;
+                switch (types[column])
+                {
+                case ColumnType::FLOAT64:
+                    snprintf(text, sizeof(text), "%g", read_value<double>(f));
+                    value = text;
+                    break;
+                case ColumnType::INT32:
+                    value = std::to_string(read_value<int32_t>(f));
+                    break;
+                case ColumnType::STRING:
+                    value.resize(offsets[i+1] - offsets[i]);
+                    f.read(&value[0], static_cast<std::streamsize>(value.size()));
+                    break;
+                case ColumnType::DICT8:
+                    value = dictionaries[column].at(read_value<uint8_t>(f));
+                    break;
+                case ColumnType::INTERVALS:
+                    for (uint32_t interval = offsets[i]; interval < offsets[i+1]; ++interval)
+                    {
+                        const int32_t lower = read_value<int32_t>(f);
+                        const int32_t upper = read_value<int32_t>(f);
+                        value += (value.empty() ? "" : ",") + std::to_string(lower);
+                        if (upper != lower)
+                        {
+                            value += "-" + std::to_string(upper);
+                        }
+                    }
+                    break;
+                }
+                rows[first_row + i].push_back(value);
+            }
+        }
+    }
+    EXPECT_EQ(read_value<uint64_t>(f), rows.size());
+    EXPECT_TRUE(f.good());
+    return rows;
+}
+
+TEST(buffered_outputting, binary_schedule_tracer)
+{
+    const std::string filename = "/tmp/test_schedule.bst";
+    BatsimContext context;
+    BinaryScheduleTracer * tracer = new BinaryScheduleTracer;
+    tracer->initialize(&context, filename, 0);
+    tracer->add_machine(0, "host0", 0);
+    tracer->add_machine(1, "host1", 0);
+    tracer->add_machine(2, "host2", 0);
+
+    IntervalSet first_allocation;
+    first_allocation.insert(0);
+    first_allocation.insert(1);
+    IntervalSet second_allocation;
+    second_allocation.insert(0);
+    second_allocation.insert(2);
+
+    tracer->add_job_start(JobIdentifier("w0", "1"), first_allocation, 1);
+    tracer->add_job_kill(JobIdentifier("w0", "1"), first_allocation, 5.5);
+    tracer->add_job_end(JobIdentifier("w0", "1"), first_allocation, 5.5);
+    tracer->add_job_start(JobIdentifier("w0", "2"), second_allocation, 6);
+    tracer->add_job_end(JobIdentifier("w0", "2"), second_allocation, 16);
+    tracer->finalize(20);
+    delete tracer;
+
+    const std::vector<std::vector<std::string>> expected_rows = {
+        {"0", "MACHINE", "host0", "0"},
+        {"0", "MACHINE", "host1", "1"},
+        {"0", "MACHINE", "host2", "2"},
+        {"1", "JOB_START", "w0!1", "0-1"},
+        {"5.5", "JOB_KILL", "w0!1", "0-1"},
+        {"5.5", "JOB_END", "w0!1", "0-1"},
+        {"6", "JOB_START", "w0!2", "0,2"},
+        {"16", "JOB_END", "w0!2", "0,2"},
+        {"20", "END", "", ""},
+    };
+    EXPECT_EQ(read_columnar_rows(filename), expected_rows);
+
+    // Remove temporary file
+    int remove_ret = remove(filename.c_str());
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
+
+TEST(buffered_outputting, jobs_tracer_no_job)
+{
+    const std::string jobs_filename = "/tmp/test_jobs_tracer_no_job_jobs.csv";
+    const std::string schedule_filename = "/tmp/test_jobs_tracer_no_job_schedule.csv";
+    BatsimContext context;
+    JobsTracer * tracer = new JobsTracer;
+    tracer->initialize(&context, jobs_filename, schedule_filename, "");
+    tracer->finalize();
+    delete tracer;
+
+    std::ifstream f(schedule_filename);
+    std::string header, values;
+    std::getline(f, header);
+    std::getline(f, values);
+
+    std::vector<std::string> keys, fields;
+    boost::algorithm::split(keys, header, boost::algorithm::is_any_of(","));
+    boost::algorithm::split(fields, values, boost::algorithm::is_any_of(","));
+    ASSERT_EQ(keys.size(), fields.size());
+
+    // Without jobs, the percentiles are empty instead of NaN
+    int nb_percentiles = 0;
+    for (unsigned int i = 0; i < keys.size(); ++i)
+    {
+        if (keys[i] == "nb_jobs")
+        {
+            EXPECT_EQ(fields[i], "0");
+        }
+        else if (keys[i].compare(0, 3, "p50") == 0 || keys[i].compare(0, 3, "p90") == 0 ||
+                 keys[i].compare(0, 3, "p99") == 0)
+        {
+            EXPECT_EQ(fields[i], "") << "Column " << keys[i];
+            nb_percentiles++;
+        }
+    }
+    EXPECT_EQ(nb_percentiles, 9);
+
+    // Remove temporary files
+    int remove_ret = remove(jobs_filename.c_str());
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << jobs_filename;
+    remove_ret = remove(schedule_filename.c_str());
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << schedule_filename;
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "../builtin_scheduler.hpp"
+
+static const std::string simulation_begins_message = R"({"now": 0, "events": [{"timestamp": 0, "type": "SIMULATION_BEGINS", "data": {
+    "nb_resources": 5, "nb_compute_resources": 4, "nb_storage_resources": 1,
+    "compute_resources": [{"id": 0}, {"id": 1}, {"id": 2}, {"id": 3}],
+    "storage_resources": [{"id": 4}]}}]})";
+
+static std::string job_submitted_event(const std::string & job_id, int nb_res, double walltime, double date)
+{
+    return R"({"timestamp": )" + std::to_string(date) + R"(, "type": "JOB_SUBMITTED", "data": {"job_id": ")" + job_id +
+           R"(", "job": {"id": ")" + job_id + R"(", "subtime": 0, "res": )" + std::to_string(nb_res) +
+           R"(, "walltime": )" + std::to_string(walltime) + R"(, "profile": "delay"}}})";
+}
+
+static std::string job_completed_event(const std::string & job_id, double date)
+{
+    return R"({"timestamp": )" + std::to_string(date) + R"(, "type": "JOB_COMPLETED", "data": {"job_id": ")" + job_id +
+           R"(", "job_state": "COMPLETED_SUCCESSFULLY", "return_code": 0, "alloc": ""}})";
+}
+
+static std::string message(double now, const std::vector<std::string> & events)
+{
+    std::string msg = R"({"now": )" + std::to_string(now) + R"(, "events": [)";
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        msg += (i > 0 ? ", " : "") + events[i];
+    }
+    return msg + "]}";
+}
+
+// Returns the decisions of a reply as "TYPE job_id alloc" strings
+static std::vector<std::string> decisions(const std::string & reply, double now)
+{
+    rapidjson::Document doc;
+    doc.Parse(reply.c_str());
+    EXPECT_FALSE(doc.HasParseError());
+    EXPECT_EQ(doc["now"].GetDouble(), now);
+
+    std::vector<std::string> ret;
+    for (const auto & event : doc["events"].GetArray())
+    {
+        EXPECT_EQ(event["timestamp"].GetDouble(), now);
+        std::string decision = std::string(event["type"].GetString()) + " " + event["data"]["job_id"].GetString();
+        if (event["data"].HasMember("alloc"))
+        {
+            decision += std::string(" ") + event["data"]["alloc"].GetString();
+        }
+        ret.push_back(decision);
+    }
+    return ret;
+}
+
+TEST(builtin_scheduler, policy_from_string)
+{
+    EXPECT_EQ(builtin_scheduling_policy_from_string("fcfs"), BuiltinSchedulingPolicy::FCFS);
+    EXPECT_EQ(builtin_scheduling_policy_from_string("easy"), BuiltinSchedulingPolicy::EASY_BACKFILLING);
+    EXPECT_THROW(builtin_scheduling_policy_from_string("sjf"), std::runtime_error);
+}
+
+TEST(builtin_scheduler, fcfs)
+{
+    BuiltinScheduler scheduler(BuiltinSchedulingPolicy::FCFS);
+    EXPECT_TRUE(decisions(scheduler.take_decisions(simulation_begins_message), 0).empty());
+    EXPECT_EQ(scheduler.nb_free_resources(), 4u);
+
+    // j2 does not fit, so j3 waits even if it fits
+    auto reply = scheduler.take_decisions(message(0, {job_submitted_event("w0!1", 2, 100, 0),
+                                                      job_submitted_event("w0!2", 3, 10, 0),
+                                                      job_submitted_event("w0!3", 1, 10, 0)}));
+    EXPECT_EQ(decisions(reply, 0), std::vector<std::string>({"EXECUTE_JOB w0!1 0-1"}));
+    EXPECT_EQ(scheduler.nb_pending_jobs(), 2u);
+
+    reply = scheduler.take_decisions(message(100, {job_completed_event("w0!1", 100)}));
+    EXPECT_EQ(decisions(reply, 100), std::vector<std::string>({"EXECUTE_JOB w0!2 0-2", "EXECUTE_JOB w0!3 3"}));
+    EXPECT_EQ(scheduler.nb_running_jobs(), 2u);
+    EXPECT_EQ(scheduler.nb_free_resources(), 0u);
+}
+
+TEST(builtin_scheduler, easy_backfilling)
+{
+    BuiltinScheduler scheduler(BuiltinSchedulingPolicy::EASY_BACKFILLING);
+    scheduler.take_decisions(simulation_begins_message);
+
+    // j2 is reserved at t=100 on 3 resources: j3 ends before, j4 does not but it fits in the remaining resource,
+    // j5 would delay j2
+    auto reply = scheduler.take_decisions(message(0, {job_submitted_event("w0!1", 2, 100, 0),
+                                                      job_submitted_event("w0!2", 3, 10, 0),
+                                                      job_submitted_event("w0!3", 1, 50, 0)}));
+    EXPECT_EQ(decisions(reply, 0), std::vector<std::string>({"EXECUTE_JOB w0!1 0-1", "EXECUTE_JOB w0!3 2"}));
+
+    reply = scheduler.take_decisions(message(50, {job_completed_event("w0!3", 50),
+                                                  job_submitted_event("w0!4", 1, 1000, 50),
+                                                  job_submitted_event("w0!5", 1, 1000, 50)}));
+    EXPECT_EQ(decisions(reply, 50), std::vector<std::string>({"EXECUTE_JOB w0!4 2"}));
+    EXPECT_EQ(scheduler.nb_pending_jobs(), 2u);
+
+    reply = scheduler.take_decisions(message(100, {job_completed_event("w0!1", 100)}));
+    EXPECT_EQ(decisions(reply, 100), std::vector<std::string>({"EXECUTE_JOB w0!2 0-1 3"}));
+    EXPECT_EQ(scheduler.nb_pending_jobs(), 1u);
+}
+
+TEST(builtin_scheduler, no_walltime)
+{
+    BuiltinScheduler scheduler(BuiltinSchedulingPolicy::EASY_BACKFILLING);
+    scheduler.take_decisions(simulation_begins_message);
+
+    // The reservation of j2 depends on j1 that has no walltime: nothing is backfilled
+    auto reply = scheduler.take_decisions(message(0, {job_submitted_event("w0!1", 2, -1, 0),
+                                                      job_submitted_event("w0!2", 3, 10, 0),
+                                                      job_submitted_event("w0!3", 1, 10, 0)}));
+    EXPECT_EQ(decisions(reply, 0), std::vector<std::string>({"EXECUTE_JOB w0!1 0-1"}));
+}
+
+TEST(builtin_scheduler, reject_and_end)
+{
+    BuiltinScheduler scheduler(BuiltinSchedulingPolicy::EASY_BACKFILLING);
+    scheduler.take_decisions(simulation_begins_message);
+
+    auto reply = scheduler.take_decisions(message(0, {job_submitted_event("w0!1", 5, 10, 0)}));
+    EXPECT_EQ(decisions(reply, 0), std::vector<std::string>({"REJECT_JOB w0!1"}));
+    EXPECT_EQ(scheduler.nb_pending_jobs(), 0u);
+
+    reply = scheduler.take_decisions(R"({"now": 10, "events": [{"timestamp": 10, "type": "SIMULATION_ENDS", "data": {}}]})");
+    EXPECT_TRUE(decisions(reply, 10).empty());
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../energy_aggregate.hpp"
+
+// A machine whose energy is integrated step by step, as SimGrid would do
+struct ReferenceMachine
+{
+    long double energy = 0;
+    long double power = 0;
+    bool stable = false;
+};
+
+TEST(energy_aggregate, single_machine)
+{
+    StableEnergyAggregate aggregate;
+    aggregate.reset(2, 0);
+    EXPECT_EQ(aggregate.total_energy(10), 0);
+
+    aggregate.set_stable(0, 10, 1000, 100);
+    EXPECT_TRUE(aggregate.is_stable(0));
+    EXPECT_FALSE(aggregate.is_stable(1));
+    EXPECT_EQ(aggregate.machine_energy(0, 20), 2000);
+    EXPECT_EQ(aggregate.total_energy(20), 2000);
+
+    aggregate.set_unstable(0, 30);
+    EXPECT_FALSE(aggregate.is_stable(0));
+    EXPECT_EQ(aggregate.total_energy(40), 0);
+}
+
+// Compares the incremental total with a full recomputation over a mixed schedule of stable and unstable periods
+TEST(energy_aggregate, mixed_schedule)
+{
+    const size_t nb_machines = 64;
+    const std::vector<long double> powers = {9.75l, 95.3l, 100.1l, 190.7l, 203.3l};
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> machine_distribution(0, nb_machines - 1);
+    std::uniform_int_distribution<size_t> power_distribution(0, powers.size() - 1);
+    std::uniform_real_distribution<double> step_distribution(0, 3.7);
+    std::bernoulli_distribution stable_distribution(0.6);
+
+    StableEnergyAggregate aggregate;
+    aggregate.reset(nb_machines, 0);
+    std::vector<ReferenceMachine> machines(nb_machines);
+    long double date = 0;
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        // Let time advance: every machine consumes energy at its current power
+        long double step = static_cast<long double>(step_distribution(rng));
+        date += step;
+        for (auto & machine : machines)
+        {
+            machine.energy += machine.power * step;
+        }
+
+        // Let a machine change its power, and become stable or unstable
+        const size_t machine_id = machine_distribution(rng);
+        ReferenceMachine & machine = machines[machine_id];
+        machine.power = powers[power_distribution(rng)];
+        machine.stable = stable_distribution(rng);
+        if (machine.stable)
+        {
+            aggregate.set_stable(machine_id, date, machine.energy, machine.power);
+        }
+        else
+        {
+            aggregate.set_unstable(machine_id, date);
+        }
+
+        if (i % 1000 == 0)
+        {
+            long double expected_total = 0;
+            for (size_t id = 0; id < nb_machines; ++id)
+            {
+                if (machines[id].stable)
+                {
+                    expected_total += machines[id].energy;
+                    EXPECT_NEAR(static_cast<double>(aggregate.machine_energy(id, date)),
+                                static_cast<double>(machines[id].energy), 1e-9 * static_cast<double>(machines[id].energy));
+                }
+            }
+
+            const long double total = aggregate.total_energy(date);
+            EXPECT_LE(std::fabs(static_cast<double>(total - expected_total)), 1e-9 * static_cast<double>(expected_total))
+                << "at update " << i;
+        }
+    }
+
+    // A resynchronization gives the same total
+    const long double total = aggregate.total_energy(date);
+    aggregate.resynchronize(date);
+    EXPECT_NEAR(static_cast<double>(aggregate.total_energy(date)), static_cast<double>(total), 1e-9 * static_cast<double>(total));
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../events.hpp"
+
+// Writes one JSON machine_unavailable event per (timestamp, resources) pair
+static std::string write_events_file(const std::string & filename,
+                                     const std::vector<std::pair<int, std::string>> & events)
+{
+    std::ofstream f(filename);
+    for (const auto & event : events)
+    {
+        f << "{\"timestamp\": " << event.first << ", \"type\": \"machine_unavailable\", "
+          << "\"resources\": \"" << event.second << "\"}\n";
+    }
+    return filename;
+}
+
+TEST(events, reader_look_ahead)
+{
+    const std::string filename = write_events_file("/tmp/test_events_reader.txt",
+        {{3, "0"}, {1, "1"}, {5, "2"}, {4, "3"}, {5, "4"}});
+
+    EventReader reader(filename, false, 2);
+    std::vector<std::string> machines;
+    long double last_timestamp = 0;
+    for (Event * event = reader.next(); event != nullptr; event = reader.next())
+    {
+        EXPECT_GE(event->timestamp, last_timestamp);
+        last_timestamp = event->timestamp;
+        machines.push_back(static_cast<MachineAvailabilityEventData *>(event->data)->machine_ids.to_string_hyphen());
+        delete event;
+    }
+
+    // Simultaneous events keep the order of the file
+    EXPECT_EQ(machines, (std::vector<std::string>{"1", "0", "3", "2", "4"}));
+    EXPECT_EQ(reader.nb_read_events(), 5u);
+    std::remove(filename.c_str());
+}
+
+TEST(events, stream_merge)
+{
+    const std::string filename_a = write_events_file("/tmp/test_events_a.txt", {{0, "0"}, {2, "1"}, {7, "2"}});
+    const std::string filename_b = write_events_file("/tmp/test_events_b.txt", {{1, "3"}, {2, "4"}, {3, "5"}});
+    const std::string filename_c = write_events_file("/tmp/test_events_c.txt", {});
+
+    EventStream stream;
+    stream.add_file(filename_a, false, 1);
+    stream.add_file(filename_b, false, 1);
+    stream.add_file(filename_c, false, 1);
+    EXPECT_EQ(stream.nb_files(), 3u);
+
+    std::vector<std::string> machines;
+    while (stream.peek() != nullptr)
+    {
+        const Event * next_event = stream.peek();
+        Event * event = stream.next();
+        EXPECT_EQ(event, next_event);
+        machines.push_back(static_cast<MachineAvailabilityEventData *>(event->data)->machine_ids.to_string_hyphen());
+        delete event;
+    }
+
+    // Simultaneous events of different files keep the order of the files
+    EXPECT_EQ(machines, (std::vector<std::string>{"0", "3", "1", "4", "5", "2"}));
+    EXPECT_EQ(stream.next(), nullptr);
+
+    for (const auto & filename : {filename_a, filename_b, filename_c})
+    {
+        std::remove(filename.c_str());
+    }
+}
+
+TEST(events, simultaneous_event_types)
+{
+    const std::string filename = "/tmp/test_events_types.txt";
+    {
+        std::ofstream f(filename);
+        f << "{\"timestamp\": 1, \"type\": \"machine_unavailable\", \"resources\": \"0\"}\n"
+          << "{\"timestamp\": 1, \"type\": \"machine_available\", \"resources\": \"1\"}\n"
+          << "{\"timestamp\": 1, \"type\": \"machine_unavailable\", \"resources\": \"2\"}\n"
+          << "{\"timestamp\": 1, \"type\": \"machine_available\", \"resources\": \"3\"}\n";
+    }
+
+    // Simultaneous events are ordered by type, then keep the order of the file
+    EventReader reader(filename, false, 4);
+    std::vector<std::string> events;
+    for (Event * event = reader.next(); event != nullptr; event = reader.next())
+    {
+        events.push_back(event_type_to_string(event->type) + " " +
+                         static_cast<MachineAvailabilityEventData *>(event->data)->machine_ids.to_string_hyphen());
+        delete event;
+    }
+
+    EXPECT_EQ(events, (std::vector<std::string>{"machine_available 1", "machine_available 3",
+                                                "machine_unavailable 0", "machine_unavailable 2"}));
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "../jobs.hpp"
+#include "../profiles.hpp"
+#include "../workload.hpp"
+
+// The JSON description synthesized for a profile built without JSON describes the same profile
+TEST(jobs, delay_profile_json_round_trip)
+{
+    ProfilePtr profile = Profile::new_delay_profile("task_p", 12.5);
+    ProfilePtr parsed = Profile::from_json("task_p", profile->get_json_description());
+
+    EXPECT_EQ(parsed->name, "task_p");
+    ASSERT_EQ(parsed->type, ProfileType::DELAY);
+    EXPECT_EQ(static_cast<DelayProfileData *>(parsed->data)->delay, 12.5);
+    EXPECT_EQ(parsed->get_json_description(), profile->get_json_description());
+}
+
+// The JSON description synthesized for a job built without JSON describes the same job
+TEST(jobs, job_json_round_trip)
+{
+    std::unique_ptr<Workload> workload(Workload::new_dynamic_workload("wf"));
+    ProfilePtr profile = Profile::new_delay_profile("task_p", 12.5);
+    workload->profiles->add_profile("task_p", profile);
+
+    for (long double walltime : {100.0l, -1.0l})
+    {
+        JobPtr job = Job::create(JobIdentifier("wf", "t0"), workload.get(), profile, 4.25l, 3, walltime);
+        JobPtr parsed = Job::from_json(job->get_json_description(), workload.get());
+
+        EXPECT_EQ(parsed->id, job->id);
+        EXPECT_EQ(parsed->submission_time, job->submission_time);
+        EXPECT_EQ(parsed->walltime, job->walltime);
+        EXPECT_EQ(parsed->requested_nb_res, job->requested_nb_res);
+        EXPECT_EQ(parsed->profile, profile);
+        EXPECT_EQ(parsed->get_json_description(), job->get_json_description());
+    }
+}
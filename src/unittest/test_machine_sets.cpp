@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <intervalset.hpp>
+
+#include "../machine_sets.hpp"
+#include "../machines.hpp"
+
+// A machine as Machines sees it, from which the sets are recomputed by a full rescan
+struct ReferenceMachine
+{
+    MachineState state = MachineState::IDLE;
+    bool is_compute_node = true;
+    bool is_storage = false;
+    int nb_jobs = 0;
+    bool in_computation_pstate = true;
+};
+
+static const std::vector<MachineState> all_states = {
+    MachineState::SLEEPING, MachineState::IDLE, MachineState::COMPUTING,
+    MachineState::TRANSITING_FROM_SLEEPING_TO_COMPUTING, MachineState::TRANSITING_FROM_COMPUTING_TO_SLEEPING,
+    MachineState::UNAVAILABLE};
+
+// Returns the machines of an allocation that satisfy a predicate, as a string to get readable failures
+template <typename Predicate>
+static std::string rescan(const std::vector<ReferenceMachine> & machines, const IntervalSet & allocation, Predicate predicate)
+{
+    IntervalSet result;
+    for (auto it = allocation.elements_begin(); it != allocation.elements_end(); ++it)
+    {
+        if (predicate(machines[static_cast<size_t>(*it)]))
+        {
+            result.insert(*it);
+        }
+    }
+    return result.to_string_hyphen();
+}
+
+static void check_against_rescan(const MachineSets & sets, const std::vector<ReferenceMachine> & machines,
+                                 const IntervalSet & allocation, int step)
+{
+    IntervalSet all_machines;
+    for (int id = 0; id < static_cast<int>(machines.size()); ++id)
+    {
+        all_machines.insert(id);
+    }
+
+    for (MachineState state : all_states)
+    {
+        EXPECT_EQ(sets.machines_in_state(state).to_string_hyphen(),
+                  rescan(machines, all_machines, [state](const ReferenceMachine & m) { return m.state == state; }))
+            << "at step " << step;
+    }
+
+    EXPECT_EQ(sets.busy_compute_machines(allocation).to_string_hyphen(),
+              rescan(machines, allocation, [](const ReferenceMachine & m) { return m.is_compute_node && m.nb_jobs > 0; }))
+        << "at step " << step;
+    EXPECT_EQ(sets.busy_storage_machines(allocation).to_string_hyphen(),
+              rescan(machines, allocation, [](const ReferenceMachine & m) { return m.is_storage && m.nb_jobs > 0; }))
+        << "at step " << step;
+    EXPECT_EQ(sets.unusable_machines(allocation).to_string_hyphen(),
+              rescan(machines, allocation, [](const ReferenceMachine & m) {
+                  return m.state != MachineState::COMPUTING && m.state != MachineState::IDLE; }))
+        << "at step " << step;
+    EXPECT_EQ(sets.machines_not_in_computation_pstate(allocation).to_string_hyphen(),
+              rescan(machines, allocation, [](const ReferenceMachine & m) { return !m.in_computation_pstate; }))
+        << "at step " << step;
+}
+
+// Compares the incrementally maintained sets with a full rescan over a random sequence of allocations,
+// releases, state changes, role changes and power state changes, as Machines would do them
+TEST(machine_sets, random_sequence)
+{
+    const int nb_machines = 48;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> machine_distribution(0, nb_machines - 1);
+    std::uniform_int_distribution<int> allocation_size_distribution(1, 6);
+    std::uniform_int_distribution<size_t> state_distribution(0, all_states.size() - 1);
+    std::uniform_int_distribution<int> operation_distribution(0, 9);
+    std::bernoulli_distribution coin(0.5);
+
+    MachineSets sets;
+    std::vector<ReferenceMachine> machines(nb_machines);
+    for (int id = 0; id < nb_machines; ++id)
+    {
+        machines[id].is_compute_node = id % 8 != 0;
+        machines[id].is_storage = id % 8 == 0;
+        sets.add_machine(id, machines[id].state, machines[id].is_compute_node, machines[id].is_storage);
+        sets.set_in_computation_pstate(id, true);
+    }
+
+    std::vector<IntervalSet> running_jobs;
+    auto set_state = [&](int id, MachineState new_state)
+    {
+        sets.set_state(id, machines[id].state, new_state);
+        machines[id].state = new_state;
+    };
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        IntervalSet allocation;
+        const int allocation_size = allocation_size_distribution(rng);
+        for (int i = 0; i < allocation_size; ++i)
+        {
+            allocation.insert(machine_distribution(rng));
+        }
+
+        const int operation = operation_distribution(rng);
+        if (operation < 4)
+        {
+            // Run a job, if all its machines can compute
+            if (sets.unusable_machines(allocation).size() == 0)
+            {
+                for (auto it = allocation.elements_begin(); it != allocation.elements_end(); ++it)
+                {
+                    machines[*it].nb_jobs++;
+                    if (machines[*it].state != MachineState::COMPUTING)
+                    {
+                        set_state(*it, MachineState::COMPUTING);
+                    }
+                }
+                sets.set_occupied(allocation);
+                running_jobs.push_back(allocation);
+            }
+        }
+        else if (operation < 7)
+        {
+            // End a job
+            if (!running_jobs.empty())
+            {
+                const size_t job_index = std::uniform_int_distribution<size_t>(0, running_jobs.size() - 1)(rng);
+                const IntervalSet job_machines = running_jobs[job_index];
+                running_jobs.erase(running_jobs.begin() + static_cast<long>(job_index));
+                for (auto it = job_machines.elements_begin(); it != job_machines.elements_end(); ++it)
+                {
+                    if (--machines[*it].nb_jobs == 0)
+                    {
+                        sets.set_unoccupied(*it);
+                        set_state(*it, MachineState::IDLE);
+                    }
+                }
+            }
+        }
+        else if (operation == 7)
+        {
+            // Change the state of a machine that computes no job (switch on/off, unavailability...)
+            const int id = machine_distribution(rng);
+            if (machines[id].nb_jobs == 0)
+            {
+                MachineState new_state = all_states[state_distribution(rng)];
+                if (new_state != MachineState::COMPUTING)
+                {
+                    set_state(id, new_state);
+                }
+            }
+        }
+        else if (operation == 8)
+        {
+            // Change the roles of a machine
+            const int id = machine_distribution(rng);
+            machines[id].is_compute_node = coin(rng);
+            machines[id].is_storage = coin(rng);
+            sets.set_roles(id, machines[id].is_compute_node, machines[id].is_storage);
+        }
+        else
+        {
+            // Change the power state of a machine
+            const int id = machine_distribution(rng);
+            machines[id].in_computation_pstate = coin(rng);
+            sets.set_in_computation_pstate(id, machines[id].in_computation_pstate);
+        }
+
+        check_against_rescan(sets, machines, allocation, step);
+    }
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../task_execution.hpp"
+
+// Reference implementations: element by element, as the matrices were generated before
+static std::vector<double> reference_homogeneous_matrix(unsigned int nb_res, double com)
+{
+    std::vector<double> matrix;
+    matrix.reserve(nb_res * nb_res);
+    for (unsigned int y = 0; y < nb_res; ++y)
+    {
+        for (unsigned int x = 0; x < nb_res; ++x)
+        {
+            matrix.push_back(x == y ? 0 : com);
+        }
+    }
+    return matrix;
+}
+
+static std::vector<double> reference_pfs_matrix(unsigned int nb_res, double bytes_to_read, double bytes_to_write)
+{
+    const unsigned int pfs_id = nb_res - 1;
+    std::vector<double> matrix;
+    matrix.reserve(nb_res * nb_res);
+    for (unsigned int row = 0; row < nb_res; ++row)
+    {
+        for (unsigned int col = 0; col < nb_res; ++col)
+        {
+            if (col == row || (col != pfs_id && row != pfs_id))
+                matrix.push_back(0);
+            else if (col == pfs_id)
+                matrix.push_back(bytes_to_write);
+            else
+                matrix.push_back(bytes_to_read);
+        }
+    }
+    return matrix;
+}
+
+TEST(matrix_generation, homogeneous)
+{
+    for (unsigned int nb_res : {1u, 2u, 3u, 17u, 64u})
+    {
+        std::vector<double> matrix = {42, 42};
+        fill_homogeneous_communication_matrix(matrix, nb_res, 1e6);
+        EXPECT_EQ(matrix, reference_homogeneous_matrix(nb_res, 1e6));
+    }
+}
+
+TEST(matrix_generation, pfs)
+{
+    for (unsigned int nb_res : {1u, 2u, 3u, 17u, 64u})
+    {
+        std::vector<double> matrix = {42, 42};
+        fill_pfs_communication_matrix(matrix, nb_res, 1e3, 2e3);
+        EXPECT_EQ(matrix, reference_pfs_matrix(nb_res, 1e3, 2e3));
+    }
+}
+
+// Large matrices, and matrices generated into a vector that held a larger matrix
+TEST(matrix_generation, large_and_reused)
+{
+    std::vector<double> matrix;
+    fill_homogeneous_communication_matrix(matrix, 1024, 1e6);
+    EXPECT_EQ(matrix, reference_homogeneous_matrix(1024, 1e6));
+
+    fill_pfs_communication_matrix(matrix, 1024, 1e3, 2e3);
+    EXPECT_EQ(matrix, reference_pfs_matrix(1024, 1e3, 2e3));
+
+    fill_homogeneous_communication_matrix(matrix, 5, 3);
+    EXPECT_EQ(matrix, reference_homogeneous_matrix(5, 3));
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../context.hpp"
+#include "../export.hpp"
+#include "../jobs.hpp"
+
+static std::string file_content(const char * filename)
+{
+    std::ifstream f(filename);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+static size_t nb_occurrences(const std::string & text, const std::string & pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+    {
+        ++count;
+    }
+    return count;
+}
+
+// The tracer only remembers the jobs that have not ended, whatever the number of jobs traced so far
+TEST(paje_tracer, unregister_job)
+{
+    const char * filename = "/tmp/test_paje_tracer.trace";
+    BatsimContext context;
+    PajeTracer tracer;
+    tracer.set_filename(filename);
+    tracer.initialize(&context, 0);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        JobIdentifier job_id("w0", std::to_string(i));
+        tracer.set_machine_as_computing_job(i % 4, job_id, i);
+        tracer.set_machine_as_computing_job((i + 1) % 4, job_id, i);
+        EXPECT_EQ(tracer.nb_registered_jobs(), 1u);
+
+        tracer.set_machine_idle(i % 4, i + 1);
+        tracer.set_machine_idle((i + 1) % 4, i + 1);
+        tracer.unregister_job(job_id);
+        EXPECT_EQ(tracer.nb_registered_jobs(), 0u);
+    }
+
+    // Unregistering an unknown job does nothing
+    tracer.unregister_job(JobIdentifier("w0", "unknown"));
+    EXPECT_EQ(tracer.nb_registered_jobs(), 0u);
+
+    // Jobs that are still running are kept
+    tracer.set_machine_as_computing_job(0, JobIdentifier("w0", "a"), 1000);
+    tracer.set_machine_as_computing_job(1, JobIdentifier("w0", "b"), 1000);
+    EXPECT_EQ(tracer.nb_registered_jobs(), 2u);
+
+    tracer.finalize(&context, 1001);
+
+    // The entity value of each job is defined once, even if the job is set on several machines
+    const std::string trace = file_content(filename);
+    EXPECT_EQ(nb_occurrences(trace, "\n5 jw0!"), 1002u);
+    EXPECT_EQ(nb_occurrences(trace, "\n5 jw0!0 "), 1u);
+}
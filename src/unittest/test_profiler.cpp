@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "../profiler.hpp"
+
+TEST(profiler, histogram_buckets)
+{
+    EXPECT_EQ(ProfiledStatistics::histogram_bucket(0), 0);
+    EXPECT_EQ(ProfiledStatistics::histogram_bucket(0.5e-6), 0);
+    EXPECT_EQ(ProfiledStatistics::histogram_bucket(1e-6), 1);
+    EXPECT_EQ(ProfiledStatistics::histogram_bucket(1.9e-6), 1);
+    EXPECT_EQ(ProfiledStatistics::histogram_bucket(2e-6), 2);
+    EXPECT_EQ(ProfiledStatistics::histogram_bucket(1e-3), 10); // 1000 µs is in [512,1024[
+    EXPECT_EQ(ProfiledStatistics::histogram_bucket(1e9), ProfiledStatistics::NB_HISTOGRAM_BUCKETS - 1);
+}
+
+TEST(profiler, statistics)
+{
+    ProfiledStatistics statistics;
+    statistics.add(1e-6, 2);
+    statistics.add(3e-6, 0);
+    statistics.add(2e-3, 5);
+
+    EXPECT_EQ(statistics.nb_calls, 3u);
+    EXPECT_EQ(statistics.nb_allocations, 7u);
+    EXPECT_DOUBLE_EQ(static_cast<double>(statistics.total_seconds), 1e-6 + 3e-6 + 2e-3);
+    EXPECT_DOUBLE_EQ(statistics.max_seconds, 2e-3);
+    EXPECT_EQ(statistics.histogram[1], 1u);
+    EXPECT_EQ(statistics.histogram[2], 1u);
+    EXPECT_EQ(statistics.histogram[11], 1u);
+    EXPECT_EQ(statistics.quantiles.count(), 3u);
+}
+
+TEST(profiler, section)
+{
+    ProfiledStatistics statistics;
+    {
+        ProfiledSection profiled(&statistics);
+        auto values = std::make_unique<std::vector<int>>(16);
+        (*values)[0] = 1;
+    }
+    EXPECT_EQ(statistics.nb_calls, 1u);
+    if (allocations_are_counted())
+    {
+        EXPECT_EQ(statistics.nb_allocations, 2u); // The vector and its elements
+    }
+    else
+    {
+        EXPECT_EQ(statistics.nb_allocations, 0u);
+    }
+    EXPECT_GE(statistics.total_seconds, 0);
+
+    // Nothing is measured without statistics
+    ProfiledSection unprofiled(nullptr);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../quantile_sketch.hpp"
+
+// Exact quantile, with the same rank definition as the sketch
+static double exact_quantile(std::vector<double> values, double q)
+{
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(q * static_cast<double>(values.size() - 1))];
+}
+
+TEST(quantile_sketch, empty)
+{
+    QuantileSketch sketch;
+    EXPECT_EQ(sketch.count(), 0u);
+    EXPECT_TRUE(std::isnan(sketch.quantile(0.5)));
+}
+
+TEST(quantile_sketch, zeros)
+{
+    QuantileSketch sketch;
+    for (double value : {0.0, 0.0, -1.0, 0.0, 10.0})
+    {
+        sketch.add(value);
+    }
+    EXPECT_EQ(sketch.count(), 5u);
+    EXPECT_EQ(sketch.quantile(0), 0);
+    EXPECT_EQ(sketch.quantile(0.5), 0);
+    EXPECT_NEAR(sketch.quantile(1), 10, 10 * 0.01);
+}
+
+TEST(quantile_sketch, relative_accuracy)
+{
+    const double accuracy = 0.01;
+    QuantileSketch sketch(accuracy);
+    std::vector<double> values;
+
+    std::mt19937 generator(42);
+    std::lognormal_distribution<double> distribution(5, 2);
+    for (int i = 0; i < 100000; ++i)
+    {
+        double value = distribution(generator);
+        sketch.add(value);
+        values.push_back(value);
+    }
+
+    for (double q : {0.0, 0.1, 0.5, 0.9, 0.99, 1.0})
+    {
+        double expected = exact_quantile(values, q);
+        EXPECT_NEAR(sketch.quantile(q), expected, expected * accuracy) << "q=" << q;
+    }
+}
+
+TEST(quantile_sketch, bounded_buckets)
+{
+    // With few buckets, the lowest values are merged but the high quantiles remain accurate
+    const double accuracy = 0.01;
+    QuantileSketch sketch(accuracy, 64);
+    std::vector<double> values;
+    for (int i = 1; i <= 100000; ++i)
+    {
+        double value = std::pow(1.001, i % 10000);
+        sketch.add(value);
+        values.push_back(value);
+    }
+
+    for (double q : {0.9, 0.99, 1.0})
+    {
+        double expected = exact_quantile(values, q);
+        EXPECT_NEAR(sketch.quantile(q), expected, expected * accuracy) << "q=" << q;
+    }
+    EXPECT_LE(sketch.quantile(0), exact_quantile(values, 0.9));
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../storage.hpp"
+
+// Connects a client to a Unix socket
+static int connect_to(const std::string & socket_path)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    // Receptions time out, so that a stalled server makes the test fail instead of hanging
+    timeval timeout = {5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    EXPECT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    return fd;
+}
+
+// Reads from a socket until a given number of bytes has been received or the connection is closed
+static std::string receive(int fd, size_t size)
+{
+    std::string received;
+    char buffer[4096];
+    while (received.size() < size)
+    {
+        ssize_t nb_read = recv(fd, buffer, std::min(sizeof(buffer), size - received.size()), 0);
+        if (nb_read <= 0)
+        {
+            break;
+        }
+        received.append(buffer, static_cast<size_t>(nb_read));
+    }
+    return received;
+}
+
+TEST(storage, in_process)
+{
+    InProcessStorage storage;
+    storage.set_instance_key_prefix("instance");
+
+    EXPECT_TRUE(storage.set("nb_res", "4"));
+    EXPECT_EQ(storage.get("nb_res"), "4");
+    EXPECT_EQ(storage.get("missing"), "");
+
+    EXPECT_TRUE(storage.set_many({{Storage::job_key(JobIdentifier("w!1")), "{\"id\":\"w!1\"}"},
+                                  {Storage::profile_key("w", "p"), "{\"type\":\"delay\"}"}}));
+    EXPECT_EQ(storage.get("job_w!1"), "{\"id\":\"w!1\"}");
+    EXPECT_EQ(storage.get("profile_w!p"), "{\"type\":\"delay\"}");
+
+    EXPECT_TRUE(storage.del("nb_res"));
+    EXPECT_FALSE(storage.del("nb_res"));
+    EXPECT_EQ(storage.get("nb_res"), "");
+}
+
+TEST(storage, parse_command)
+{
+    std::vector<std::string> args;
+
+    std::string input = "*2\r\n$3\r\nGET\r\n$4\r\na:bc\r\n*1\r\n$4\r\nPI";
+    EXPECT_EQ(UnixSocketStorage::parse_command(input, args), 1);
+    EXPECT_EQ(args, (std::vector<std::string>{"GET", "a:bc"}));
+    EXPECT_EQ(UnixSocketStorage::parse_command(input, args), 0);
+    input += "NG\r\n";
+    EXPECT_EQ(UnixSocketStorage::parse_command(input, args), 1);
+    EXPECT_EQ(args, (std::vector<std::string>{"PING"}));
+    EXPECT_TRUE(input.empty());
+
+    // Bulk strings may contain CRLF
+    input = "*2\r\n$4\r\nECHO\r\n$4\r\na\r\nb\r\n";
+    EXPECT_EQ(UnixSocketStorage::parse_command(input, args), 1);
+    EXPECT_EQ(args[1], "a\r\nb");
+
+    input = "PING\r\n";
+    EXPECT_EQ(UnixSocketStorage::parse_command(input, args), -1);
+    input = "*1\r\n$2\r\nabcd\r\n";
+    EXPECT_EQ(UnixSocketStorage::parse_command(input, args), -1);
+}
+
+TEST(storage, unix_socket_commands)
+{
+    const std::string socket_path = "test_storage.sock";
+    UnixSocketStorage storage(socket_path);
+    storage.set_instance_key_prefix("instance");
+    storage.set("nb_res", "4");
+
+    std::string reply;
+    EXPECT_TRUE(storage.execute_command({"get", "instance:nb_res"}, reply));
+    EXPECT_EQ(reply, "$1\r\n4\r\n");
+
+    reply.clear();
+    EXPECT_TRUE(storage.execute_command({"MSET", "instance:a", "1", "instance:b", ""}, reply));
+    EXPECT_TRUE(storage.execute_command({"MGET", "instance:a", "instance:b", "instance:c"}, reply));
+    EXPECT_TRUE(storage.execute_command({"DEL", "instance:a", "instance:c"}, reply));
+    EXPECT_TRUE(storage.execute_command({"EXISTS", "instance:a", "instance:b"}, reply));
+    EXPECT_EQ(reply, "+OK\r\n*3\r\n$1\r\n1\r\n$0\r\n\r\n$-1\r\n:1\r\n:1\r\n");
+    EXPECT_EQ(storage.get("b"), "");
+
+    reply.clear();
+    EXPECT_TRUE(storage.execute_command({"SET", "instance:a"}, reply));
+    EXPECT_TRUE(storage.execute_command({"FLUSHALL"}, reply));
+    EXPECT_EQ(reply.compare(0, 5, "-ERR "), 0);
+    EXPECT_NE(reply.find("\r\n-ERR unknown command 'FLUSHALL'\r\n"), std::string::npos);
+
+    reply.clear();
+    EXPECT_FALSE(storage.execute_command({"QUIT"}, reply));
+    EXPECT_EQ(reply, "+OK\r\n");
+}
+
+TEST(storage, unix_socket_client)
+{
+    const std::string socket_path = "test_storage_client.sock";
+    UnixSocketStorage storage(socket_path);
+    storage.set_instance_key_prefix("instance");
+    storage.set("nb_res", "4");
+
+    int fd = connect_to(socket_path);
+
+    // Two commands, the second one being sent in two parts
+    const std::string commands = "*2\r\n$3\r\nGET\r\n$15\r\ninstance:nb_res\r\n*3\r\n$3\r\nSET\r\n$10\r\ninstance:a\r\n$1\r\n7\r\n";
+    ASSERT_EQ(send(fd, commands.data(), 40, 0), 40);
+    ASSERT_EQ(send(fd, commands.data() + 40, commands.size() - 40, 0), static_cast<ssize_t>(commands.size() - 40));
+    EXPECT_EQ(receive(fd, 12), "$1\r\n4\r\n+OK\r\n");
+    EXPECT_EQ(storage.get("a"), "7");
+
+    // The connection is closed after the reply of QUIT
+    const std::string quit = "*1\r\n$4\r\nQUIT\r\n";
+    ASSERT_EQ(send(fd, quit.data(), quit.size(), 0), static_cast<ssize_t>(quit.size()));
+    EXPECT_EQ(receive(fd, 100), "+OK\r\n");
+    close(fd);
+
+    // Invalid commands are answered with an error, then the connection is closed
+    fd = connect_to(socket_path);
+    ASSERT_EQ(send(fd, "PING\r\n", 6, 0), 6);
+    EXPECT_EQ(receive(fd, 1000).compare(0, 20, "-ERR Protocol error:"), 0);
+    close(fd);
+}
+
+// A client that does not read its replies must neither stall the other clients nor the destruction of the storage
+TEST(storage, unix_socket_client_not_reading)
+{
+    const std::string socket_path = "test_storage_slow.sock";
+    auto storage = std::make_unique<UnixSocketStorage>(socket_path);
+    storage->set_instance_key_prefix("instance");
+    storage->set("big", std::string(1024*1024, 'x'));
+
+    const std::string ping = "*1\r\n$4\r\nPING\r\n";
+    int slow_fd = connect_to(socket_path);
+    ASSERT_EQ(send(slow_fd, ping.data(), ping.size(), 0), static_cast<ssize_t>(ping.size()));
+    EXPECT_EQ(receive(slow_fd, 7), "+PONG\r\n");
+
+    // The replies are much bigger than the socket buffers
+    const std::string get_big = "*2\r\n$3\r\nGET\r\n$12\r\ninstance:big\r\n";
+    for (int i = 0; i < 64; ++i)
+    {
+        ASSERT_EQ(send(slow_fd, get_big.data(), get_big.size(), 0), static_cast<ssize_t>(get_big.size()));
+    }
+    usleep(100*1000);
+
+    int fd = connect_to(socket_path);
+    ASSERT_EQ(send(fd, ping.data(), ping.size(), 0), static_cast<ssize_t>(ping.size()));
+    EXPECT_EQ(receive(fd, 7), "+PONG\r\n");
+    close(fd);
+
+    storage.reset();
+    close(slow_fd);
+}
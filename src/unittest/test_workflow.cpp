@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../workflow.hpp"
+
+// Returns the ids of the children of a task
+static std::vector<std::string> children_ids(const Workflow & workflow, int task_index)
+{
+    std::vector<std::string> ids;
+    for (const int * child = workflow.children_begin(task_index); child != workflow.children_end(task_index); ++child)
+    {
+        ids.push_back(workflow.tasks[static_cast<size_t>(*child)]->id);
+    }
+    return ids;
+}
+
+TEST(workflow, build_graph)
+{
+    // a -> b, a -> c, b -> d, c -> d, and e is isolated
+    Workflow workflow("w");
+    for (const auto & id_time : std::vector<std::pair<std::string, double>>{{"a", 1}, {"b", 5}, {"c", 2}, {"d", 3}, {"e", 4}})
+    {
+        workflow.add_task(*new Task(1, id_time.second, id_time.first));
+    }
+    workflow.add_edge(*workflow.get_task("a"), *workflow.get_task("c"));
+    workflow.add_edge(*workflow.get_task("a"), *workflow.get_task("b"));
+    workflow.add_edge(*workflow.get_task("b"), *workflow.get_task("d"));
+    workflow.add_edge(*workflow.get_task("c"), *workflow.get_task("d"));
+    workflow.add_edge(*workflow.get_task("b"), *workflow.get_task("d")); // Duplicate edges are ignored
+    workflow.build_graph();
+    workflow.check_validity();
+
+    EXPECT_EQ(workflow.nb_tasks(), 5);
+    EXPECT_EQ(workflow.get_task("d")->index, 3);
+    EXPECT_EQ(children_ids(workflow, 0), (std::vector<std::string>{"b", "c"}));
+    EXPECT_EQ(children_ids(workflow, 1), (std::vector<std::string>{"d"}));
+    EXPECT_TRUE(children_ids(workflow, 3).empty());
+    EXPECT_EQ(workflow.nb_parents(3), 2);
+    EXPECT_EQ(workflow.nb_parents(0), 0);
+
+    ASSERT_EQ(workflow.get_source_tasks().size(), 2u);
+    EXPECT_EQ(workflow.get_source_tasks()[0]->id, "a");
+    EXPECT_EQ(workflow.get_source_tasks()[1]->id, "e");
+    ASSERT_EQ(workflow.get_sink_tasks().size(), 2u);
+    EXPECT_EQ(workflow.get_sink_tasks()[0]->id, "d");
+    EXPECT_EQ(workflow.get_sink_tasks()[1]->id, "e");
+
+    EXPECT_EQ(workflow.get_task("d")->depth, 2);
+    EXPECT_EQ(workflow.get_maximum_depth(), 2);
+    EXPECT_DOUBLE_EQ(workflow.get_task("a")->bottom_level, 1 + 5 + 3);
+    EXPECT_DOUBLE_EQ(workflow.get_task("c")->bottom_level, 2 + 3);
+    EXPECT_DOUBLE_EQ(workflow.get_task("e")->bottom_level, 4);
+
+    // Edges can still be added after a build
+    workflow.add_edge(*workflow.get_task("e"), *workflow.get_task("d"));
+    workflow.build_graph();
+    EXPECT_EQ(workflow.nb_parents(3), 3);
+    EXPECT_EQ(children_ids(workflow, 0), (std::vector<std::string>{"b", "c"}));
+    EXPECT_EQ(children_ids(workflow, 4), (std::vector<std::string>{"d"}));
+    EXPECT_DOUBLE_EQ(workflow.get_task("e")->bottom_level, 4 + 3);
+}
+
+TEST(workflow, load_from_xml)
+{
+    // a -> b, a -> c, b -> d, c -> d
+    const std::string filename = "/tmp/test_workflow.dax";
+    std::ofstream f(filename);
+    f << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<!-- A comment that is not stored -->\n"
+         "<adag name=\"test\">\n"
+         "  <job id=\"a\" runtime=\"1\"><uses file=\"f&amp;g\" link=\"output\"/></job>\n"
+         "  <job id=\"b\" runtime=\"5\" num_procs=\"4\"/>\n"
+         "  <job id=\"c\" runtime=\"2\" num_procs=\"0\"/>\n"
+         "  <job id=\"d\" runtime=\"3.5\"/>\n"
+         "  <child ref=\"b\"><parent ref=\"a\"/></child>\n"
+         "  <child ref=\"c\"><parent ref=\"a\"/></child>\n"
+         "  <child ref=\"d\"><parent ref=\"b\"/><parent ref=\"c\"/></child>\n"
+         "</adag>\n";
+    f.close();
+
+    // The XML document is released before the graph is built
+    Workflow workflow("w");
+    workflow.load_from_xml(filename);
+
+    EXPECT_EQ(workflow.filename, filename);
+    ASSERT_EQ(workflow.nb_tasks(), 4);
+    EXPECT_EQ(workflow.get_task("b")->num_procs, 4);
+    EXPECT_EQ(workflow.get_task("c")->num_procs, 1);
+    EXPECT_DOUBLE_EQ(workflow.get_task("d")->execution_time, 3.5);
+    EXPECT_EQ(children_ids(workflow, 0), (std::vector<std::string>{"b", "c"}));
+    EXPECT_EQ(children_ids(workflow, 1), (std::vector<std::string>{"d"}));
+    EXPECT_EQ(workflow.nb_parents(3), 2);
+
+    ASSERT_EQ(workflow.get_source_tasks().size(), 1u);
+    EXPECT_EQ(workflow.get_source_tasks()[0]->id, "a");
+    ASSERT_EQ(workflow.get_sink_tasks().size(), 1u);
+    EXPECT_EQ(workflow.get_sink_tasks()[0]->id, "d");
+    EXPECT_EQ(workflow.get_maximum_depth(), 2);
+    EXPECT_DOUBLE_EQ(workflow.get_task("a")->bottom_level, 1 + 5 + 3.5);
+
+    // Remove temporary file
+    int remove_ret = remove(filename.c_str());
+    EXPECT_EQ(remove_ret, 0) << "Could not remove file " << filename;
+}
@@ -5,6 +5,7 @@
 
 #include "workflow.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <streambuf>
 
@@ -12,6 +13,7 @@
 #include "jobs.hpp"
 #include "profiles.hpp"
 #include "jobs_execution.hpp"
+#include "pugixml.hpp"
 
 using namespace std;
 using namespace pugi;
@@ -25,55 +27,70 @@ Workflow::Workflow(const std::string & name) :
 
 Workflow::~Workflow()
 {
-    // delete name;   TOFIX
-    // name = nullptr;
+    for (Task * task : tasks)
+    {
+        delete task;
+    }
     tasks.clear();
-
 }
 
 void Workflow::load_from_xml(const std::string &xml_filename)
 {
     XBT_INFO("Loading XML workflow '%s'...", xml_filename.c_str());
 
-    // XML document creation
-    xml_parse_result result = dax_tree.load_file(xml_filename.c_str());
-    (void) result; // Avoids a warning if assertions are ignored
-    xbt_assert(result, "Invalid XML file");
-
-    xml_node dag = dax_tree.child("adag");
-    for (xml_node job = dag.child("job"); job; job = job.next_sibling("job"))
     {
-        // Parse the number of processors, if any
-        int num_procs = 1;
-        if (job.attribute("num_procs"))
+        // XML document creation. The document is only kept in this scope, so that it is freed before the graph
+        // is built, and the parts of the DAX that are not used (comments, declarations...) are not even stored
+        xml_document dax_tree;
+        xml_parse_result result = dax_tree.load_file(xml_filename.c_str(), parse_minimal | parse_escapes);
+        (void) result; // Avoids a warning if assertions are ignored
+        xbt_assert(result, "Invalid XML file '%s': %s", xml_filename.c_str(), result.description());
+
+        xml_node dag = dax_tree.child("adag");
+        size_t nb_dax_jobs = 0;
+        for (xml_node job = dag.child("job"); job; job = job.next_sibling("job"))
         {
-            num_procs = static_cast<int>(strtol(job.attribute("num_procs").value(),NULL,10));
+            ++nb_dax_jobs;
         }
-        if (num_procs <= 0)
+        tasks.reserve(nb_dax_jobs);
+        _task_indices.reserve(nb_dax_jobs);
+
+        for (xml_node job = dag.child("job"); job; job = job.next_sibling("job"))
         {
-            num_procs = 1;
+            // Parse the number of processors, if any
+            int num_procs = 1;
+            if (job.attribute("num_procs"))
+            {
+                num_procs = static_cast<int>(strtol(job.attribute("num_procs").value(),NULL,10));
+            }
+            if (num_procs <= 0)
+            {
+                num_procs = 1;
+            }
+
+            Task *task = new Task (num_procs, strtod(job.attribute("runtime").value(),NULL),
+                                   job.attribute("id").value());
+            add_task(*task);
         }
 
-        Task *task = new Task (num_procs, strtod(job.attribute("runtime").value(),NULL),
-                               job.attribute("id").value());
-        add_task(*task);
-    }
-
-    for (xml_node edge_bottom = dag.child("child"); edge_bottom;
-         edge_bottom = edge_bottom.next_sibling("child"))
-    {
-        Task *dest = get_task(edge_bottom.attribute("ref").value());
-
-        for (xml_node edge_top = edge_bottom.child("parent"); edge_top;
-             edge_top = edge_top.next_sibling("parent"))
+        for (xml_node edge_bottom = dag.child("child"); edge_bottom;
+             edge_bottom = edge_bottom.next_sibling("child"))
         {
-            Task *source = get_task(edge_top.attribute("ref").value());
+            Task *dest = get_task(edge_bottom.attribute("ref").value());
 
-            //std::cout << "Test : " << source->id << " --> " << dest->id << std::endl;
-            add_edge(*source,*dest);
+            for (xml_node edge_top = edge_bottom.child("parent"); edge_top;
+                 edge_top = edge_top.next_sibling("parent"))
+            {
+                Task *source = get_task(edge_top.attribute("ref").value());
+
+                //std::cout << "Test : " << source->id << " --> " << dest->id << std::endl;
+                add_edge(*source,*dest);
+            }
         }
     }
 
+    build_graph();
+
     /* Testing things
     std::cout << get_source_tasks().size() << std::endl;
 
@@ -110,85 +127,151 @@ void Workflow::load_from_xml(const std::string &xml_filename)
 
 void Workflow::check_validity()
 {
-    // Likely not needed, so it doesn't do anything for now
-    return;
+    xbt_assert(_nb_parents.size() == tasks.size() && _edges.empty(),
+               "Invalid workflow '%s': its graph has not been built", name.c_str());
+    xbt_assert(tasks.empty() || !_source_tasks.empty(),
+               "Invalid workflow '%s': it has no source task", name.c_str());
 }
 
 void Workflow::add_task(Task &task)
 {
-    this->tasks[task.id] = &task;
+    xbt_assert(_task_indices.count(task.id) == 0,
+               "Invalid workflow '%s': task id '%s' is used several times", name.c_str(), task.id.c_str());
+    task.index = static_cast<int>(tasks.size());
+    _task_indices[task.id] = task.index;
+    this->tasks.push_back(&task);
 }
 
-Task * Workflow::get_task(std::string id)
+Task * Workflow::get_task(std::string_view id)
 {
-    xbt_assert(this->tasks.count(id) == 1,
-               "Invalid Workflow::get_task call: id '%s' does not exist", id.c_str());
-    return this->tasks[id];
+    auto it = _task_indices.find(id);
+    xbt_assert(it != _task_indices.end(),
+               "Invalid Workflow::get_task call: id '%.*s' does not exist", static_cast<int>(id.size()), id.data());
+    return this->tasks[it->second];
 }
 
 void Workflow::add_edge(Task &parent, Task &child)
 {
-    if(std::find(child.parents.begin(), child.parents.end(), &parent) != child.parents.end())
+    _edges.emplace_back(parent.index, child.index);
+}
+
+void Workflow::build_graph()
+{
+    const size_t nb_tasks = tasks.size();
+
+    // Keep the edges of the previous build, then drop the duplicate edges (no hyperedge)
+    for (size_t parent = 0; parent + 1 < _children_offsets.size(); ++parent)
     {
-        // Edge already there, no hyperedge
+        for (int i = _children_offsets[parent]; i < _children_offsets[parent + 1]; ++i)
+        {
+            _edges.emplace_back(static_cast<int>(parent), _children[static_cast<size_t>(i)]);
+        }
     }
-    else
+    std::sort(_edges.begin(), _edges.end());
+    _edges.erase(std::unique(_edges.begin(), _edges.end()), _edges.end());
+
+    // Edges are sorted by parent, so the children of each parent are already contiguous
+    _children_offsets.assign(nb_tasks + 1, 0);
+    _children.resize(_edges.size());
+    _nb_parents.assign(nb_tasks, 0);
+    for (size_t i = 0; i < _edges.size(); ++i)
     {
-        child.parents.push_back(&parent);
+        _children_offsets[static_cast<size_t>(_edges[i].first) + 1]++;
+        _children[i] = _edges[i].second;
+        _nb_parents[static_cast<size_t>(_edges[i].second)]++;
     }
-
-    if(std::find(parent.children.begin(), parent.children.end(), &parent) != parent.children.end())
+    for (size_t i = 0; i < nb_tasks; ++i)
     {
-        // Edge already there, no hyperedge
+        _children_offsets[i + 1] += _children_offsets[i];
     }
-    else
+    _edges.clear();
+    _edges.shrink_to_fit();
+
+    // Sort the tasks topologically (Kahn's algorithm), which also computes their depth
+    _source_tasks.clear();
+    _sink_tasks.clear();
+    std::vector<int> order;
+    order.reserve(nb_tasks);
+    std::vector<int> nb_remaining_parents(_nb_parents);
+    for (Task * task : tasks)
     {
-        parent.children.push_back(&child);
+        task->depth = 0;
+        if (nb_parents(task->index) == 0)
+        {
+            _source_tasks.push_back(task);
+            order.push_back(task->index);
+        }
+        if (children_begin(task->index) == children_end(task->index))
+        {
+            _sink_tasks.push_back(task);
+        }
     }
-}
-
 
-std::vector<Task *> Workflow::get_source_tasks()
-{
-    std::vector<Task *> task_list;
-    for(std::map<std::string, Task *>::iterator it = this->tasks.begin(); it != this->tasks.end(); ++it)
+    for (size_t i = 0; i < order.size(); ++i)
     {
-        if ((it->second)->parents.empty())
+        const Task * parent = tasks[static_cast<size_t>(order[i])];
+        for (const int * child = children_begin(parent->index); child != children_end(parent->index); ++child)
         {
-            task_list.push_back(it->second);
+            Task * child_task = tasks[static_cast<size_t>(*child)];
+            child_task->depth = std::max(child_task->depth, parent->depth + 1);
+            if (--nb_remaining_parents[static_cast<size_t>(*child)] == 0)
+            {
+                order.push_back(*child);
+            }
         }
     }
-    return task_list;
-}
+    xbt_assert(order.size() == nb_tasks,
+               "Invalid workflow '%s': its tasks and edges do not form a DAG (there is a cycle)", name.c_str());
 
-std::vector<Task *> Workflow::get_sink_tasks()
-{
-    std::vector<Task *> task_list;
-    for(std::map<std::string, Task *>::iterator it = this->tasks.begin(); it != this->tasks.end(); ++it)
+    // The bottom levels are computed in reverse topological order
+    _maximum_depth = -1;
+    for (auto it = order.rbegin(); it != order.rend(); ++it)
     {
-        if ((it->second)->children.empty())
+        Task * task = tasks[static_cast<size_t>(*it)];
+        double max_child_bottom_level = 0;
+        for (const int * child = children_begin(task->index); child != children_end(task->index); ++child)
         {
-            task_list.push_back(it->second);
+            max_child_bottom_level = std::max(max_child_bottom_level, tasks[static_cast<size_t>(*child)]->bottom_level);
         }
+        task->bottom_level = task->execution_time + max_child_bottom_level;
+        _maximum_depth = std::max(_maximum_depth, task->depth);
     }
-    return task_list;
 }
 
+const std::vector<Task *> & Workflow::get_source_tasks() const
+{
+    return _source_tasks;
+}
 
-int Workflow::get_maximum_depth()
+const std::vector<Task *> & Workflow::get_sink_tasks() const
 {
-    int max_depth = -1;
-    std::vector<Task *> sinks = this->get_sink_tasks();
-    for (std::vector<Task*>::iterator it = sinks.begin(); it != sinks.end(); ++it)
-    {
-        if ((max_depth == -1) || ((*it)->depth > max_depth))
-        {
-            max_depth = (*it)->depth;
-        }
-    }
-    return max_depth;
+    return _sink_tasks;
+}
+
+int Workflow::get_maximum_depth() const
+{
+    return _maximum_depth;
 }
 
+int Workflow::nb_tasks() const
+{
+    return static_cast<int>(tasks.size());
+}
+
+int Workflow::nb_parents(int task_index) const
+{
+    return _nb_parents[static_cast<size_t>(task_index)];
+}
+
+const int * Workflow::children_begin(int task_index) const
+{
+    return _children.data() + _children_offsets[static_cast<size_t>(task_index)];
+}
+
+const int * Workflow::children_end(int task_index) const
+{
+    return _children.data() + _children_offsets[static_cast<size_t>(task_index) + 1];
+}
 
 
 Task::Task(const int num_procs, const double execution_time, const std::string &id) :
@@ -200,8 +283,6 @@ Task::Task(const int num_procs, const double execution_time, const std::string &
 
 Task::~Task()
 {
-    this->parents.clear();
-    this->children.clear();
 }
 
 
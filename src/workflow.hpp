@@ -10,9 +10,11 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 #include "pointers.hpp"
-#include "pugixml.hpp"
 
 struct Job;
 class Task;
@@ -20,6 +22,9 @@ class Task;
 /**
  * @brief A workflow is a DAG of tasks, with points to
  *        source tasks and sink tasks
+ * @details Tasks are identified by their index in the workflow.
+ *          Once all the tasks and edges have been added, build_graph stores the edges
+ *          in a compact (CSR) adjacency, so that the children of a task are contiguous.
  */
 class Workflow
 {
@@ -37,23 +42,25 @@ public:
     Workflow(const Workflow & other) = delete;
 
     /**
-     * @brief Destroys a Workflow
+     * @brief Destroys a Workflow and its tasks
      */
     ~Workflow();
 
     /**
      * @brief Loads a complete workflow from an XML filename
+     * @details The XML tree is only kept while the graph is being built: only the tasks and the compact graph remain in memory.
      * @param[in] xml_filename The name of the XML file
      */
     void load_from_xml(const std::string & xml_filename);
 
     /**
-     * @brief Checks whether a Workflow is valid (not needed since loading from XML?)
+     * @brief Checks whether a Workflow is valid
+     * @details The graph must have been built (see build_graph).
      */
     void check_validity();
 
     /**
-     * @brief Adds a task to the workflow
+     * @brief Adds a task to the workflow, which takes its ownership and sets its index
      * @param[in] task The task to add into the Workflow
      */
     void add_task(Task &task);
@@ -63,46 +70,87 @@ public:
      * @param[in] id The task id
      * @return The task corresponding to the given id
      */
-    Task *get_task(std::string id);
+    Task *get_task(std::string_view id);
 
     /**
      * @brief Add an edge between a parent task and a child task
+     * @details The edge is only taken into account by the next build_graph call.
      * @param[in,out] parent The parent task
      * @param[in,out] child The child task
      */
     void add_edge(Task &parent, Task &child);
 
+    /**
+     * @brief Builds the compact adjacency of the workflow from the added edges,
+     *        then computes the depth and the bottom level of every task
+     * @details Duplicate edges are ignored. Aborts if the graph has a cycle.
+     */
+    void build_graph();
+
     /**
      * @brief Gets source tasks
-     * @return The source tasks
+     * @return The source tasks, in index order
      */
-    std::vector<Task *> get_source_tasks();
+    const std::vector<Task *> & get_source_tasks() const;
 
     /**
      * @brief Gets the sink tasks
-     * @return The sink tasks
+     * @return The sink tasks, in index order
      */
-    std::vector<Task *> get_sink_tasks();
+    const std::vector<Task *> & get_sink_tasks() const;
 
     /**
      * @brief Gets the maximum depth
-     * @return The maximum depth
+     * @return The maximum depth (-1 if the workflow is empty)
+     */
+    int get_maximum_depth() const;
+
+    /**
+     * @brief Gets the number of tasks
+     * @return The number of tasks
+     */
+    int nb_tasks() const;
+
+    /**
+     * @brief Gets the number of parents of a task
+     * @param[in] task_index The task index
+     * @return The number of parents of the task
+     */
+    int nb_parents(int task_index) const;
+
+    /**
+     * @brief Gets the beginning of the children indices of a task
+     * @param[in] task_index The task index
+     * @return A pointer to the first child index of the task
+     */
+    const int * children_begin(int task_index) const;
+
+    /**
+     * @brief Gets the end of the children indices of a task
+     * @param[in] task_index The task index
+     * @return A pointer past the last child index of the task
      */
-    int get_maximum_depth();
+    const int * children_end(int task_index) const;
 
 public:
     std::string filename;  //!< The DAX filename
     std::string name; //!< The Workflow name
-    std::map<std::string, Task *> tasks; //!< Hashmap of all tasks
+    std::vector<Task *> tasks; //!< All the tasks, indexed by their index
     double start_time = -1; //!< Workflow start time
 
 private:
-    pugi::xml_document dax_tree; //!< The DAX tree
+    std::unordered_map<std::string_view, int> _task_indices; //!< The index of each task, by task id. The keys point to the id of the (never moved) tasks
+    std::vector<std::pair<int, int>> _edges; //!< The (parent, child) edges added since the last build_graph call
+    std::vector<int> _children_offsets = {0}; //!< The children of task i are _children[_children_offsets[i]] to _children[_children_offsets[i+1]-1]
+    std::vector<int> _children; //!< The children indices of all the tasks, grouped by parent
+    std::vector<int> _nb_parents; //!< The number of parents of each task
+    std::vector<Task *> _source_tasks; //!< The tasks without parent
+    std::vector<Task *> _sink_tasks; //!< The tasks without child
+    int _maximum_depth = -1; //!< The maximum depth of the tasks
 };
 
 /**
- * @brief A workflow Task is some attributes, pointers to parent tasks,
- *        and pointers to children tasks.
+ * @brief A workflow Task is some attributes. Its parents and children are stored by its Workflow.
  */
 class Task
 {
@@ -137,11 +185,10 @@ public:
     int num_procs; //!< The number of processors needed for the tas
     double execution_time; //!< The execution time of the task
     std::string id; //!< The task id
+    int index = -1; //!< The task index in its Workflow
     JobPtr batsim_job = nullptr; //!< The batsim job created for this task
-    std::vector<Task *> parents; //!< The parent
-    std::vector<Task *> children; //!< The children
-    int nb_parent_completed = 0; //!< The number of preceding tasks completed
-    int depth = 0; //!< The task's top level
+    int depth = 0; //!< The task's top level (the number of tasks on the longest path from a source task)
+    double bottom_level = 0; //!< The task's bottom level (the execution time of the longest path to a sink task, the task included)
 };
 
 
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+'''Binary schedule trace tests.
+
+These tests check that the binary schedule trace, once converted by
+tools/batsim_binary_schedule_to_paje.py, describes the same schedule as the
+Pajé trace written by Batsim.
+'''
+import json
+import subprocess
+import sys
+from helper import *
+
+SET_STATE = 6
+NEW_EVENT = 8
+
+def run_simulation(test_name, platform, workload, algorithm, schedconf_content, batparams):
+    output_dir, robin_filename, schedconf_filename = init_instance(test_name)
+    write_file(schedconf_filename, json.dumps(schedconf_content))
+
+    batcmd = gen_batsim_cmd(platform.filename, workload.filename, output_dir, batparams)
+    instance = RobinInstance(output_dir=output_dir,
+        batcmd=batcmd,
+        schedcmd=f"batsched -v '{algorithm.sched_algo_name}' --variant_options_filepath '{schedconf_filename}'",
+        simulation_timeout=30, ready_timeout=5,
+        success_timeout=10, failure_timeout=0
+    )
+
+    instance.to_file(robin_filename)
+    ret = run_robin(robin_filename)
+    if ret.returncode != 0: raise Exception(f'Bad robin return code ({ret.returncode})')
+    return output_dir
+
+def parse_paje_schedule(filename):
+    '''Returns the state of each machine after each date, and the kill events of a Pajé trace.'''
+    states = {}
+    kills = set()
+    with open(filename) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) < 5 or not fields[0].isdigit():
+                continue
+            if int(fields[0]) == SET_STATE:
+                # Only the last state set at a given date is visible
+                states[(round(float(fields[1]), 6), fields[3])] = fields[4]
+            elif int(fields[0]) == NEW_EVENT:
+                kills.add((round(float(fields[1]), 6), fields[2], fields[3], fields[4]))
+    return states, kills
+
+def binary_schedule(platform, workload, algorithm):
+    test_name = f'binaryschedule-{algorithm.name}-{platform.name}-{workload.name}'
+    if algorithm.sched_implem != 'batsched': raise Exception('This test only supports batsched for now')
+
+    # Some jobs are killed, so that every kind of record is traced
+    schedconf_content = {
+        "delay_before_kill": 5,
+        "nb_kills_per_job": 1,
+    }
+    paje_dir = run_simulation(f'{test_name}-paje', platform, workload, algorithm, schedconf_content, "")
+    binary_dir = run_simulation(f'{test_name}-binary', platform, workload, algorithm, schedconf_content,
+                                "--schedule-trace-format binary")
+
+    converter = os.path.abspath(f'{os.path.dirname(__file__)}/../tools/batsim_binary_schedule_to_paje.py')
+    converted_filename = f'{binary_dir}/batres_schedule.trace'
+    subprocess.run([sys.executable, converter, f'{binary_dir}/batres_schedule.bst', converted_filename], check=True)
+
+    expected_states, expected_kills = parse_paje_schedule(f'{paje_dir}/batres_schedule.trace')
+    states, kills = parse_paje_schedule(converted_filename)
+    assert len(expected_states) > 0 and len(expected_kills) > 0
+    assert states == expected_states
+    assert kills == expected_kills
+
+def test_binary_schedule(small_platform, small_workload, killer_algorithm):
+    binary_schedule(small_platform, small_workload, killer_algorithm)
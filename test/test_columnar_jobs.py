@@ -0,0 +1,41 @@
+#!/usr/bin/env python3
+'''Columnar jobs export tests.
+
+These tests check that the binary columnar jobs output (--export-jobs-columnar),
+once converted by tools/batsim_columnar_jobs_to_csv.py, contains the same jobs as _jobs.csv.
+'''
+import subprocess
+import sys
+import pandas as pd
+from helper import *
+
+def columnar_jobs(platform, workload, algorithm):
+    test_name = f'columnarjobs-{algorithm.name}-{platform.name}-{workload.name}'
+    output_dir, robin_filename, _ = init_instance(test_name)
+
+    if algorithm.sched_implem != 'batsched': raise Exception('This test only supports batsched for now')
+
+    batcmd = gen_batsim_cmd(platform.filename, workload.filename, output_dir, "--export-jobs-columnar")
+    instance = RobinInstance(output_dir=output_dir,
+        batcmd=batcmd,
+        schedcmd=f"batsched -v '{algorithm.sched_algo_name}'",
+        simulation_timeout=30, ready_timeout=5,
+        success_timeout=10, failure_timeout=0
+    )
+
+    instance.to_file(robin_filename)
+    ret = run_robin(robin_filename)
+    if ret.returncode != 0: raise Exception(f'Bad robin return code ({ret.returncode})')
+
+    converter = os.path.abspath(f'{os.path.dirname(__file__)}/../tools/batsim_columnar_jobs_to_csv.py')
+    converted_filename = f'{output_dir}/batres_jobs_from_bcol.csv'
+    subprocess.run([sys.executable, converter, f'{output_dir}/batres_jobs.bcol', converted_filename], check=True)
+
+    # Both files have the same columns and rows, in the same order. Times are written with 6 decimals in _jobs.csv
+    expected_jobs = pd.read_csv(f'{output_dir}/batres_jobs.csv', dtype={'job_id': str, 'metadata': str})
+    jobs = pd.read_csv(converted_filename, dtype={'job_id': str, 'metadata': str})
+    assert len(expected_jobs) > 0
+    pd.testing.assert_frame_equal(jobs, expected_jobs, check_dtype=False, check_exact=False, atol=1e-6)
+
+def test_columnar_jobs(small_platform, small_workload, fcfs_algorithm):
+    columnar_jobs(small_platform, small_workload, fcfs_algorithm)
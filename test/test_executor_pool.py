@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+'''Job executor pool tests.
+
+These tests check that the actors that execute jobs can be reused across jobs,
+and that the simulation does not end before the jobs they run complete.
+'''
+import json
+import pandas as pd
+from helper import *
+
+def executor_pool(platform, workload, algorithm):
+    test_name = f'executor-pool-{algorithm.name}-{platform.name}-{workload.name}'
+    output_dir, robin_filename, _ = init_instance(test_name)
+
+    if algorithm.sched_implem != 'batsched': raise Exception('This test only supports batsched for now')
+
+    batcmd = gen_batsim_cmd(platform.filename, workload.filename, output_dir, "")
+    instance = RobinInstance(output_dir=output_dir,
+        batcmd=batcmd,
+        schedcmd=f"batsched -v '{algorithm.sched_algo_name}'",
+        simulation_timeout=30, ready_timeout=5,
+        success_timeout=10, failure_timeout=0
+    )
+
+    instance.to_file(robin_filename)
+    ret = run_robin(robin_filename)
+    if ret.returncode != 0: raise Exception(f'Bad robin return code ({ret.returncode})')
+
+    # Every job of the workload must have been executed until its completion
+    with open(workload.filename) as f:
+        expected_job_ids = sorted(str(job['id']) for job in json.load(f)['jobs'])
+
+    jobs = pd.read_csv(f'{output_dir}/batres_jobs.csv')
+    executed_job_ids = sorted(str(job_id).split('!')[-1] for job_id in jobs['job_id'])
+    assert executed_job_ids == expected_job_ids
+
+    not_completed = jobs.loc[jobs['final_state'] != 'COMPLETED_SUCCESSFULLY']
+    if not not_completed.empty:
+        print(not_completed[['job_id', 'final_state', 'execution_time']])
+        raise Exception('Some jobs have not been executed until their completion.')
+
+    # The jobs of the workload last 10 seconds each
+    assert (jobs['execution_time'] - 10).abs().max() < 1e-3
+
+def test_executor_pool(small_platform, delays_workload, basic_algorithm):
+    executor_pool(small_platform, delays_workload, basic_algorithm)
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+'''Timeline submission tests.
+
+These tests check that the static jobs of all the workloads and the external events
+that occur at the same date are sent to the decision process in a single message.
+'''
+import json
+from helper import *
+
+def write_workload(filename, workload_jobs):
+    write_file(filename, json.dumps({
+        'nb_res': 4,
+        'jobs': [{'id': job_id, 'subtime': subtime, 'walltime': 100, 'res': 1, 'profile': 'delay5'}
+                 for job_id, subtime in workload_jobs],
+        'profiles': {'delay5': {'type': 'delay', 'delay': 5}},
+    }))
+
+def same_date_single_call(platform, algorithm):
+    test_name = f'timeline-same-date-{algorithm.name}-{platform.name}'
+    output_dir, robin_filename, _ = init_instance(test_name)
+
+    if algorithm.sched_implem != 'pybatsim': raise Exception('This test only supports pybatsim for now')
+
+    write_workload(f'{output_dir}/w1.json', [(1, 10), (2, 10)])
+    write_workload(f'{output_dir}/w2.json', [(1, 10), (2, 20)])
+    write_file(f'{output_dir}/events.txt',
+               '{"type": "generic_a", "timestamp": 10}\n'
+               '{"type": "generic_b", "timestamp": 10}\n'
+               '{"type": "generic_c", "timestamp": 20}\n')
+
+    batcmd = gen_batsim_cmd(platform.filename, f'{output_dir}/w1.json', output_dir,
+                            f"-w '{output_dir}/w2.json' --events '{output_dir}/events.txt' --forward-unknown-events")
+    instance = RobinInstance(output_dir=output_dir,
+        batcmd=batcmd,
+        schedcmd=f"pybatsim {algorithm.sched_algo_name}",
+        simulation_timeout=30, ready_timeout=5,
+        success_timeout=10, failure_timeout=0
+    )
+
+    instance.to_file(robin_filename)
+    ret = run_robin(robin_filename)
+    if ret.returncode != 0: raise Exception(f'Bad robin return code ({ret.returncode})')
+
+    batlog_content = open(f'{output_dir}/log/batsim.log', 'r').read()
+    messages = parse_proto_messages_from_batsim(batlog_content)
+
+    def submissions_and_notifications(message):
+        submitted = sorted(e['data']['job_id'] for e in message['events'] if e['type'] == 'JOB_SUBMITTED')
+        notified = sorted(e['data']['type'] for e in message['events']
+                          if e['type'] == 'NOTIFY' and e['data']['type'].startswith('generic_'))
+        return submitted, notified
+
+    # Exactly one call of the scheduler at each date, containing all the inputs of that date
+    for date, expected in [(10, (['w0!1', 'w0!2', 'w1!1'], ['generic_a', 'generic_b'])),
+                           (20, (['w1!2'], ['generic_c']))]:
+        calls = [submissions_and_notifications(msg) for msg in messages if msg['now'] == date]
+        calls = [call for call in calls if call != ([], [])]
+        assert calls == [expected], f'Unexpected scheduler calls at date {date}: {calls}'
+
+def test_same_date_single_call(small_platform, pybatsim_filler_events_algorithm):
+    same_date_single_call(small_platform, pybatsim_filler_events_algorithm)
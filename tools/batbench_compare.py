@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+
+"""Compares two batbench JSON outputs (--benchmark_out_format=json).
+
+Exits with a non-zero status if a benchmark of the current run is slower than
+the baseline by more than the given threshold (CPU time per iteration).
+"""
+
+# Everything should be in the standard library
+
+import argparse
+import json
+import sys
+
+
+def read_benchmarks(filename):
+    with open(filename) as f:
+        doc = json.load(f)
+    benchmarks = dict()
+    for bench in doc['benchmarks']:
+        # Only keep the mean when repetitions are used
+        if bench.get('run_type') == 'aggregate' and bench.get('aggregate_name') != 'mean':
+            continue
+        name = bench.get('run_name', bench['name'])
+        benchmarks[name] = bench['cpu_time']
+    return benchmarks
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('baseline', help='The baseline batbench JSON output')
+    parser.add_argument('current', help='The current batbench JSON output')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='The tolerated relative slowdown (default: 0.1, that is 10%%)')
+    args = parser.parse_args()
+
+    baseline = read_benchmarks(args.baseline)
+    current = read_benchmarks(args.current)
+
+    regressions = []
+    print('{:<50} {:>14} {:>14} {:>9}'.format('benchmark', 'baseline', 'current', 'change'))
+    for name in sorted(current):
+        if name not in baseline:
+            print('{:<50} {:>14} {:>14.1f} {:>9}'.format(name, '-', current[name], 'new'))
+            continue
+        change = (current[name] - baseline[name]) / baseline[name] if baseline[name] > 0 else 0
+        print('{:<50} {:>14.1f} {:>14.1f} {:>+8.1f}%'.format(name, baseline[name], current[name], 100 * change))
+        if change > args.threshold:
+            regressions.append(name)
+
+    for name in sorted(set(baseline) - set(current)):
+        print('{:<50} {:>14.1f} {:>14} {:>9}'.format(name, baseline[name], '-', 'removed'))
+
+    if regressions:
+        print('\n{} benchmark(s) regressed by more than {:.0f}%: {}'.format(
+            len(regressions), 100 * args.threshold, ', '.join(regressions)))
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+
+"""Transforms a Batsim _schedule.bst binary schedule trace into a Pajé trace.
+
+The binary trace contains one record per job event (see
+BinaryScheduleTracer in Batsim's source code). On each machine, the Pajé
+state is the most recently started job that is still running there
+(Batsim's own Pajé tracer may choose another job when compute sharing is
+enabled)."""
+
+# Everything should be in the standard library
+
+import argparse
+import colorsys
+import random
+
+from batsim_columnar_jobs_to_csv import read_columnar_jobs
+
+(DEFINE_CONTAINER_TYPE, CREATE_CONTAINER, DESTROY_CONTAINER,
+ DEFINE_STATE_TYPE, DEFINE_ENTITY_VALUE, SET_STATE, DEFINE_EVENT_TYPE,
+ NEW_EVENT, DEFINE_VARIABLE_TYPE, SET_VARIABLE) = range(1, 11)
+
+HEADER = '''%EventDef PajeDefineContainerType {}
+% Type string
+% Alias string
+% Name string
+%EndEventDef
+
+%EventDef PajeCreateContainer {}
+% Time date
+% Type string
+% Alias string
+% Name string
+% Container string
+%EndEventDef
+
+%EventDef PajeDestroyContainer {}
+% Time date
+% Name string
+% Type string
+%EndEventDef
+
+%EventDef PajeDefineStateType {}
+% Alias string
+% Type string
+% Name string
+%EndEventDef
+
+%EventDef PajeDefineEntityValue {}
+% Alias string
+% Type string
+% Name string
+% Color color
+%EndEventDef
+
+%EventDef PajeSetState {}
+% Time date
+% Type string
+% Container string
+% Value string
+%EndEventDef
+
+%EventDef PajeDefineEventType {}
+% Type string
+% Alias string
+% Name string
+%EndEventDef
+
+%EventDef PajeNewEvent {}
+% Time date
+% Type string
+% Container string
+% Value string
+%EndEventDef
+
+%EventDef PajeDefineVariableType {}
+% Type string
+% Alias string
+% Name string
+% Color string
+%EndEventDef
+
+%EventDef PajeSetVariable {}
+% Time date
+% Type string
+% Container string
+% Value double
+%EndEventDef
+
+'''.format(*range(1, 11))
+
+
+def machine_ids(intervals):
+    for (lower, upper) in intervals:
+        yield from range(lower, upper + 1)
+
+
+def generate_colors(color_count=8):
+    colors = []
+    for i in range(color_count):
+        r, g, b = colorsys.hsv_to_rgb(i / color_count, 1, 1)
+        colors.append('"{:f} {:f} {:f}"'.format(r, g, b))
+    random.shuffle(colors)
+    return colors
+
+
+def convert(trace, out):
+    out.write(HEADER)
+    out.write('# Container types creation\n'
+              '{} 0 root_ct "Machines"\n'
+              '{} root_ct machine_ct "Machine"\n'
+              '{} 0 scheduler_ct "Scheduler"\n'
+              '{} scheduler_ct killer_ct "Killer"\n'
+              '\n'.format(*[DEFINE_CONTAINER_TYPE] * 4))
+    out.write('# Event types creation\n'
+              '{} killer_ct kk "Job kill"\n'
+              '{} machine_ct km "Job kill"\n'
+              '\n'.format(DEFINE_EVENT_TYPE, DEFINE_EVENT_TYPE))
+    out.write('# Variable types creation\n'
+              '{} scheduler_ct vu_vt "Utilization" "0.0 0.5 0.0"\n'
+              '\n'.format(DEFINE_VARIABLE_TYPE))
+
+    colors = generate_colors()
+    machines = []
+    running = {}  # machine id -> list of the jobs running on it
+    defined_jobs = set()
+
+    def set_state(time, machine_id, value):
+        out.write('{} {:f} machine_state m{} {}\n'.format(
+            SET_STATE, time, machine_id, value))
+
+    def set_top_job_state(time, machine_id):
+        jobs = running[machine_id]
+        if not jobs:
+            set_state(time, machine_id, 'w')
+            return
+        job = jobs[-1]
+        if job not in defined_jobs:
+            out.write('{} j{} machine_state "{}" {}\n'.format(
+                DEFINE_ENTITY_VALUE, job, job,
+                colors[len(defined_jobs) % len(colors)]))
+            defined_jobs.add(job)
+        set_state(time, machine_id, 'j' + job)
+
+    events_started = False
+    for (time, event, name, intervals) in zip(trace['time'], trace['event'],
+                                              trace['name'],
+                                              trace['machines']):
+        if event == 'MACHINE':
+            if not machines:
+                out.write('# Containers creation\n'
+                          '{} {:f} root_ct root "Machines" 0\n'.format(
+                              CREATE_CONTAINER, time))
+            for machine_id in machine_ids(intervals):
+                machines.append(machine_id)
+                running[machine_id] = []
+                out.write('{} {:f} machine_ct m{} "{}" root\n'.format(
+                    CREATE_CONTAINER, time, machine_id, name))
+            continue
+
+        if not events_started:
+            events_started = True
+            start_time = trace['time'][0]
+            out.write('{} {:f} scheduler_ct sc "Scheduler" 0\n'
+                      '{} {:f} killer_ct k "Killer" sc\n'
+                      '\n'.format(CREATE_CONTAINER, start_time,
+                                  CREATE_CONTAINER, start_time))
+            out.write('# States creation\n'
+                      '{} machine_state machine_ct "Machine state"\n'
+                      '\n'.format(DEFINE_STATE_TYPE))
+            out.write('# Creation of the different values the machine state '
+                      'can be\n'
+                      '{} w machine_state "Waiting" "0.0 0.0 0.0"\n'
+                      '{} l machine_state "Launching" "0.3 0.3 0.3"\n'
+                      '\n'
+                      '# Begin of events\n'.format(DEFINE_ENTITY_VALUE,
+                                                   DEFINE_ENTITY_VALUE))
+            for machine_id in machines:
+                set_state(start_time, machine_id, 'w')
+
+        if event == 'JOB_START':
+            for machine_id in machine_ids(intervals):
+                running[machine_id].append(name)
+                set_top_job_state(time, machine_id)
+        elif event == 'JOB_END':
+            for machine_id in machine_ids(intervals):
+                jobs = running[machine_id]
+                was_top = jobs[-1] == name
+                jobs.remove(name)
+                if was_top:
+                    set_top_job_state(time, machine_id)
+        elif event == 'JOB_KILL':
+            out.write('{} {:f} kk k "{}"\n'.format(NEW_EVENT, time, name))
+            for machine_id in machine_ids(intervals):
+                out.write('{} {:f} km m{} "{}"\n'.format(
+                    NEW_EVENT, time, machine_id, name))
+        elif event == 'END':
+            out.write('\n# End of events, containers destruction\n')
+            for machine_id in machines:
+                out.write('{} {:f} m{} machine_ct\n'.format(
+                    DESTROY_CONTAINER, time, machine_id))
+            out.write('{} {:f} root root_ct\n'.format(DESTROY_CONTAINER,
+                                                      time))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Reads a binary Batsim '
+                                     'schedule trace and transforms it into '
+                                     'a Pajé trace')
+    parser.add_argument('inputBST', help='The input binary schedule trace')
+    parser.add_argument('outputPaje', type=argparse.FileType('w'),
+                        help='The output Pajé trace')
+    args = parser.parse_args()
+
+    convert(read_columnar_jobs(args.inputBST), args.outputPaje)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+
+"""Reads a Batsim _jobs.bcol binary columnar output (see docs/output-jobs.rst)."""
+
+# Everything should be in the standard library
+# (compressed .gz files are supported, .zst files must be decompressed first)
+
+import argparse
+import array
+import csv
+import gzip
+import math
+import struct
+import sys
+
+MAGIC = b'BATCOLv1'
+FLOAT64, INT32, STRING, DICT8, INTERVALS = 1, 2, 3, 4, 5
+
+
+def read_exactly(f, size):
+    data = f.read(size)
+    if len(data) != size:
+        raise ValueError('Truncated columnar file')
+    return data
+
+
+def read_struct(f, fmt):
+    fmt = '<' + fmt
+    return struct.unpack(fmt, read_exactly(f, struct.calcsize(fmt)))
+
+
+def read_header(f):
+    if read_exactly(f, len(MAGIC)) != MAGIC:
+        raise ValueError('Not a Batsim columnar file')
+    nb_columns, = read_struct(f, 'I')
+    columns = []
+    for _ in range(nb_columns):
+        col_type, name_length = read_struct(f, 'BH')
+        name = read_exactly(f, name_length).decode()
+        dictionary = []
+        if col_type == DICT8:
+            nb_entries, = read_struct(f, 'H')
+            for _ in range(nb_entries):
+                entry_length, = read_struct(f, 'H')
+                dictionary.append(read_exactly(f, entry_length).decode())
+        columns.append((name, col_type, dictionary))
+    return columns
+
+
+def decode_chunk(chunk, col_type, dictionary, nb_rows):
+    if col_type == FLOAT64:
+        return list(struct.unpack('<{}d'.format(nb_rows), chunk))
+    if col_type == INT32:
+        return list(struct.unpack('<{}i'.format(nb_rows), chunk))
+    if col_type == DICT8:
+        return [dictionary[code] for code in chunk]
+
+    offsets = array.array('I', chunk[:4 * (nb_rows + 1)])
+    if sys.byteorder != 'little':
+        offsets.byteswap()
+    data = chunk[4 * (nb_rows + 1):]
+    if col_type == STRING:
+        return [data[offsets[i]:offsets[i + 1]].decode()
+                for i in range(nb_rows)]
+    if col_type == INTERVALS:
+        bounds = struct.unpack('<{}i'.format(len(data) // 4), data)
+        return [[(bounds[2 * k], bounds[2 * k + 1])
+                 for k in range(offsets[i], offsets[i + 1])]
+                for i in range(nb_rows)]
+    raise ValueError('Unknown column type {}'.format(col_type))
+
+
+def read_columnar_jobs(filename, wanted_columns=None):
+    """Returns a dict that maps column names to lists of values.
+
+    Chunks of the columns that are not in wanted_columns (if set) are
+    skipped without being decoded."""
+    opener = gzip.open if filename.endswith('.gz') else open
+    with opener(filename, 'rb') as f:
+        columns = read_header(f)
+        result = {name: [] for (name, _, _) in columns
+                  if wanted_columns is None or name in wanted_columns}
+
+        while True:
+            nb_rows, = read_struct(f, 'I')
+            if nb_rows == 0:
+                total_nb_rows, = read_struct(f, 'Q')
+                break
+            for (name, col_type, dictionary) in columns:
+                chunk_size, = read_struct(f, 'Q')
+                chunk = read_exactly(f, chunk_size)
+                if name in result:
+                    result[name] += decode_chunk(chunk, col_type,
+                                                 dictionary, nb_rows)
+
+        for values in result.values():
+            if len(values) != total_nb_rows:
+                raise ValueError('Inconsistent number of rows')
+        return result
+
+
+def to_csv_value(value):
+    if isinstance(value, float):
+        return '' if math.isnan(value) else '{:f}'.format(value)
+    if isinstance(value, list):
+        return ' '.join(str(lower) if lower == upper
+                        else '{}-{}'.format(lower, upper)
+                        for (lower, upper) in value)
+    return value
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Reads a binary columnar '
+                                     'Batsim jobs output file and '
+                                     'transforms it into a CSV file')
+    parser.add_argument('inputBCOL', help='The input columnar file')
+    parser.add_argument('outputCSV', type=argparse.FileType('w'),
+                        help='The output CSV file')
+    args = parser.parse_args()
+
+    jobs = read_columnar_jobs(args.inputBCOL)
+    names = list(jobs.keys())
+    writer = csv.writer(args.outputCSV, lineterminator='\n')
+    writer.writerow(names)
+    for row in zip(*[jobs[name] for name in names]):
+        writer.writerow([to_csv_value(value) for value in row])
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+
+"""Measures Batsim's end-to-end throughput with its built-in scheduler.
+
+For each workload size, a workload of delay jobs is generated (Poisson arrivals that
+target a given platform load), then simulated with `batsim --builtin-sched <policy>`.
+The number of simulated jobs per wall-clock second and the peak RSS of Batsim are reported.
+"""
+
+# Everything should be in the standard library
+
+import argparse
+import json
+import os
+import random
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ET
+
+NB_RUNTIMES = 64
+
+
+def count_compute_hosts(platform_filename):
+    """Counts the hosts of the clusters without master or storage role (cluster512.xml family)."""
+    nb_hosts = 0
+    for cluster in ET.parse(platform_filename).getroot().iter('cluster'):
+        roles = [prop.get('value') for prop in cluster.iter('prop') if prop.get('id') == 'role']
+        if 'master' in roles or 'storage' in roles:
+            continue
+        for part in cluster.get('radical').split(','):
+            bounds = part.split('-')
+            nb_hosts += int(bounds[-1]) - int(bounds[0]) + 1
+    return nb_hosts
+
+
+def generate_workload(filename, nb_jobs, nb_res, load, seed):
+    """Writes a delay workload of nb_jobs jobs (streamed, so that large workloads fit in memory)."""
+    rng = random.Random(seed)
+    runtimes = [60 * 2 ** (6 * i / (NB_RUNTIMES - 1)) for i in range(NB_RUNTIMES)]  # 1 minute to ~1 hour
+    max_job_size_log = min(6, nb_res.bit_length() - 1)  # up to 64 resources
+    mean_job_size = sum(2 ** i for i in range(max_job_size_log + 1)) / (max_job_size_log + 1)
+    mean_runtime = sum(runtimes) / len(runtimes)
+    arrival_rate = load * nb_res / (mean_job_size * mean_runtime)
+
+    with open(filename, 'w') as f:
+        f.write('{"nb_res": %d, "profiles": {' % nb_res)
+        f.write(', '.join('"delay%d": {"type": "delay", "delay": %.3f}' % (i, runtime)
+                          for i, runtime in enumerate(runtimes)))
+        f.write('}, "jobs": [\n')
+        subtime = 0.0
+        for job_id in range(nb_jobs):
+            subtime += rng.expovariate(arrival_rate)
+            profile = rng.randrange(NB_RUNTIMES)
+            walltime = runtimes[profile] * rng.uniform(1.0, 3.0)
+            f.write('%s{"id": "%d", "subtime": %.3f, "walltime": %.3f, "res": %d, "profile": "delay%d"}' % (
+                ',\n' if job_id > 0 else '', job_id, subtime, walltime,
+                2 ** rng.randint(0, max_job_size_log), profile))
+        f.write('\n]}\n')
+
+
+def run_batsim(batsim, platform, workload, policy, export_prefix):
+    """Runs Batsim and returns its wall-clock duration (s) and peak RSS (KiB)."""
+    command = [batsim, '-p', platform, '-w', workload, '--builtin-sched', policy,
+               '-e', export_prefix, '-q', '--disable-schedule-tracing', '--disable-machine-state-tracing']
+    start = time.monotonic()
+    process = subprocess.Popen(command, stdout=subprocess.DEVNULL)
+    _, status, rusage = os.wait4(process.pid, 0)
+    duration = time.monotonic() - start
+    if os.waitstatus_to_exitcode(status) != 0:
+        raise RuntimeError('Batsim failed ({}): {}'.format(os.waitstatus_to_exitcode(status), ' '.join(command)))
+    return duration, rusage.ru_maxrss
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--batsim', default='batsim', help='The Batsim executable (default: batsim)')
+    parser.add_argument('-p', '--platform', default='platforms/cluster512.xml',
+                        help='The platform file (default: platforms/cluster512.xml)')
+    parser.add_argument('--policy', default='easy', choices=['fcfs', 'easy'],
+                        help='The built-in scheduling policy (default: easy)')
+    parser.add_argument('--sizes', type=int, nargs='+', default=[10**4, 10**5, 10**6, 10**7],
+                        help='The numbers of jobs of the workloads (default: 10^4 to 10^7)')
+    parser.add_argument('--load', type=float, default=0.9,
+                        help='The targeted platform load of the workloads (default: 0.9)')
+    parser.add_argument('--seed', type=int, default=0, help='The random seed (default: 0)')
+    parser.add_argument('--workdir', default='throughput_benchmark',
+                        help='The directory of the workloads and outputs (default: throughput_benchmark)')
+    parser.add_argument('--keep-workloads', action='store_true',
+                        help='Keeps the generated workloads (they can be large)')
+    parser.add_argument('-o', '--output', type=argparse.FileType('w'), default=sys.stdout,
+                        help='The file where the JSON results are written (default: stdout)')
+    args = parser.parse_args()
+
+    os.makedirs(args.workdir, exist_ok=True)
+    nb_res = count_compute_hosts(args.platform)
+    results = []
+    for nb_jobs in args.sizes:
+        workload = os.path.join(args.workdir, 'workload_{}.json'.format(nb_jobs))
+        print('Generating {} ({} jobs)...'.format(workload, nb_jobs), file=sys.stderr)
+        generate_workload(workload, nb_jobs, nb_res, args.load, args.seed)
+
+        print('Simulating {} jobs...'.format(nb_jobs), file=sys.stderr)
+        duration, max_rss = run_batsim(args.batsim, args.platform, workload, args.policy,
+                                       os.path.join(args.workdir, 'out_{}'.format(nb_jobs)))
+        if not args.keep_workloads:
+            os.remove(workload)
+
+        result = {
+            'nb_jobs': nb_jobs,
+            'policy': args.policy,
+            'wall_seconds': duration,
+            'jobs_per_second': nb_jobs / duration,
+            'max_rss_kib': max_rss,
+        }
+        print('{nb_jobs} jobs: {wall_seconds:.2f} s, {jobs_per_second:.0f} jobs/s, '
+              'peak RSS {max_rss_kib} KiB'.format(**result), file=sys.stderr)
+        results.append(result)
+
+    json.dump({'platform': args.platform, 'nb_res': nb_res, 'load': args.load, 'results': results},
+              args.output, indent=2)
+    args.output.write('\n')
+
+
+if __name__ == '__main__':
+    main()